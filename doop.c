@@ -27,6 +27,15 @@
 #include <signal.h>
 #endif
 
+/* Strings shorter than this aren't worth checking for a tr/// that counts
+ * just one character; see S_do_trans_count() */
+#define TRANS_COUNT_BYTE_MIN 64
+
+/* Marks an entry in the per-call cache of swash lookups for the invariant
+ * characters that hasn't been filled in yet.  Swash lookups never return
+ * it, as they return at most 'none + 1' */
+#define TRANS_UNCACHED UV_MAX
+
 STATIC I32
 S_do_trans_simple(pTHX_ SV * const sv)
 {
@@ -41,14 +50,14 @@ S_do_trans_simple(pTHX_ SV * const sv)
     if (!tbl)
 	Perl_croak(aTHX_ "panic: do_trans_simple line %d",__LINE__);
 
-    /* First, take care of non-UTF-8 input strings, because they're easy */
+    /* First, take care of non-UTF-8 input strings, because they're easy.
+     * The loop is written without a branch on whether each byte is in the
+     * search list, as on typical text that branch is unpredictable */
     if (!SvUTF8(sv)) {
 	while (s < send) {
 	    const I32 ch = tbl[*s];
-	    if (ch >= 0) {
-		matches++;
-		*s = (U8)ch;
-	    }
+	    matches += (ch >= 0);
+	    *s = (ch >= 0) ? (U8)ch : *s;
 	    s++;
 	}
 	SvSETMAGIC(sv);
@@ -67,9 +76,23 @@ S_do_trans_simple(pTHX_ SV * const sv)
 	while (s < send) {
 	    STRLEN ulen;
 	    I32 ch;
+	    UV c;
+
+	    /* Invariants are most of most text, and need no decoding */
+	    if (UTF8_IS_INVARIANT(*s)) {
+		ch = tbl[*s];
+		if (ch >= 0) {
+		    matches++;
+		    append_utf8_from_native_byte((U8)ch, &d);
+		}
+		else
+		    *d++ = *s;
+		s++;
+		continue;
+	    }
 
 	    /* Need to check this, otherwise 128..255 won't match */
-	    const UV c = utf8n_to_uvchr(s, send - s, &ulen, UTF8_ALLOW_DEFAULT);
+	    c = utf8n_to_uvchr(s, send - s, &ulen, UTF8_ALLOW_DEFAULT);
 	    if (c < 0x100 && (ch = tbl[c]) >= 0) {
 		matches++;
 		d = uvchr_to_utf8(d, ch);
@@ -109,6 +132,41 @@ S_do_trans_count(pTHX_ SV * const sv)
     if (!tbl)
 	Perl_croak(aTHX_ "panic: do_trans_count line %d",__LINE__);
 
+    /* The commonest use of this is counting a single character, as in
+     * tr/\n//, or everything but a single character.  For long enough
+     * strings it pays to look for that case, and then let count_byte() work
+     * through the string a word at a time.  An invariant character never
+     * appears as part of the encoding of another, so this also works on
+     * UTF-8 strings, as long as characters above 0xFF aren't to be counted */
+    if (len >= TRANS_COUNT_BYTE_MIN) {
+	const I32 complement = PL_op->op_private & OPpTRANS_COMPLEMENT;
+	unsigned int found = 0;
+	unsigned int i;
+
+	/* Kept free of branches, so that this is quick to do */
+	for (i = 0; i < 256; i++)
+	    found += (tbl[i] >= 0);
+
+	if (found == 1 || found == 255) {
+	    /* Find the one byte that is in (or isn't in) the search list */
+	    const short want = (found == 1);
+	    U8 c = 0;
+
+	    for (i = 0; i < 256; i++) {
+		if ((tbl[i] >= 0) == want) {
+		    c = (U8)i;
+		    break;
+		}
+	    }
+
+	    if (!SvUTF8(sv))
+		return (found == 1) ? count_byte(s, send, c)
+		                    : len - count_byte(s, send, c);
+	    if (found == 1 && !complement && UTF8_IS_INVARIANT(c))
+		return count_byte(s, send, c);
+	}
+    }
+
     if (!SvUTF8(sv)) {
 	while (s < send) {
             if (tbl[*s++] >= 0)
@@ -119,7 +177,14 @@ S_do_trans_count(pTHX_ SV * const sv)
 	const I32 complement = PL_op->op_private & OPpTRANS_COMPLEMENT;
 	while (s < send) {
 	    STRLEN ulen;
-	    const UV c = utf8n_to_uvchr(s, send - s, &ulen, UTF8_ALLOW_DEFAULT);
+	    UV c;
+
+	    if (UTF8_IS_INVARIANT(*s)) {
+		if (tbl[*s++] >= 0)
+		    matches++;
+		continue;
+	    }
+	    c = utf8n_to_uvchr(s, send - s, &ulen, UTF8_ALLOW_DEFAULT);
 	    if (c < 0x100) {
 		if (tbl[c] >= 0)
 		    matches++;
@@ -318,6 +383,8 @@ S_do_trans_simple_utf8(pTHX_ SV * const sv)
     const UV extra = none + 1;
     UV final = 0;
     U8 hibit = 0;
+    UV cache[256];
+    unsigned int i;
 
     PERL_ARGS_ASSERT_DO_TRANS_SIMPLE_UTF8;
 
@@ -352,8 +419,22 @@ S_do_trans_simple_utf8(pTHX_ SV * const sv)
 	dend = d + len;
     }
 
+    for (i = 0; i < C_ARRAY_LENGTH(cache); i++)
+	cache[i] = TRANS_UNCACHED;
+
     while (s < send) {
-	const UV uv = swash_fetch(rv, s, TRUE);
+	UV uv;
+
+	/* Most text is largely made up of invariants, so remember what the
+	 * swash said about each of them rather than asking it each time */
+	if (UTF8_IS_INVARIANT(*s)) {
+	    uv = cache[*s];
+	    if (uv == TRANS_UNCACHED)
+		uv = cache[*s] = swash_fetch(rv, s, TRUE);
+	}
+	else
+	    uv = swash_fetch(rv, s, TRUE);
+
 	if (uv < none) {
 	    s += UTF8SKIP(s);
 	    matches++;
@@ -418,6 +499,8 @@ S_do_trans_count_utf8(pTHX_ SV * const sv)
     const UV none = svp ? SvUV(*svp) : 0x7fffffff;
     const UV extra = none + 1;
     U8 hibit = 0;
+    UV cache[256];
+    unsigned int i;
 
     PERL_ARGS_ASSERT_DO_TRANS_COUNT_UTF8;
 
@@ -436,11 +519,24 @@ S_do_trans_count_utf8(pTHX_ SV * const sv)
     }
     send = s + len;
 
+    for (i = 0; i < C_ARRAY_LENGTH(cache); i++)
+	cache[i] = TRANS_UNCACHED;
+
     while (s < send) {
-	const UV uv = swash_fetch(rv, s, TRUE);
+	UV uv;
+
+	if (UTF8_IS_INVARIANT(*s)) {
+	    uv = cache[*s];
+	    if (uv == TRANS_UNCACHED)
+		uv = cache[*s] = swash_fetch(rv, s, TRUE);
+	    s++;
+	}
+	else {
+	    uv = swash_fetch(rv, s, TRUE);
+	    s += UTF8SKIP(s);
+	}
 	if (uv < none || uv == extra)
 	    matches++;
-	s += UTF8SKIP(s);
     }
     if (hibit)
         Safefree(start);
@@ -736,7 +832,17 @@ Perl_do_sprintf(pTHX_ SV *sv, I32 len, SV **sarg)
     SvUTF8_off(sv);
     if (DO_UTF8(*sarg))
         SvUTF8_on(sv);
-    sv_vsetpvfn(sv, pat, patlen, NULL, sarg + 1, len - 1, &do_taint);
+    if (PL_op && (PL_op->op_type == OP_SPRINTF || PL_op->op_type == OP_PRTF)
+        && (PL_op->op_private & OPpFORMAT_FAST))
+    {
+        /* the format was compiled by sv_fast_format_compile() */
+        sv_setpvs(sv, "");
+        sv_catpvfn_fast(sv, pat, patlen,
+                        PAD_SV(cLISTOPx(PL_op)->op_first->op_targ),
+                        sarg + 1, len - 1);
+    }
+    else
+        sv_vsetpvfn(sv, pat, patlen, NULL, sarg + 1, len - 1, &do_taint);
     SvSETMAGIC(sv);
     if (do_taint)
 	SvTAINTED_on(sv);
@@ -771,8 +877,12 @@ Perl_do_vecget(pTHX_ SV *sv, SSize_t offset, int size)
     }
 
     if (size < 8) {
-	bitoffs = ((offset%8)*size)%8;
-	uoffset = offset/(8/size);
+	/* 'size' is 1, 2 or 4, so there are 1 << shift elements in each
+	 * byte, and these can be found by shifting and masking rather than
+	 * dividing */
+	const int shift = 3 - (size >> 1);
+	bitoffs = (offset & ((1 << shift) - 1)) * size;
+	uoffset = offset >> shift;
     }
     else if (size > 8)
 	uoffset = offset*(size/8);
@@ -933,8 +1043,10 @@ Perl_do_vecset(pTHX_ SV *sv)
 	Perl_croak(aTHX_ "Illegal number of bits in vec");
 
     if (size < 8) {
-	bitoffs = ((offset%8)*size)%8;
-	offset /= 8/size;
+	/* See do_vecget() */
+	const int shift = 3 - (size >> 1);
+	bitoffs = (offset & ((1 << shift) - 1)) * size;
+	offset >>= shift;
     }
     else if (size > 8)
 	offset *= size/8;
@@ -986,11 +1098,6 @@ Perl_do_vecset(pTHX_ SV *sv)
 void
 Perl_do_vop(pTHX_ I32 optype, SV *sv, SV *left, SV *right)
 {
-#ifdef LIBERAL
-    long *dl;
-    long *ll;
-    long *rl;
-#endif
     char *dc;
     STRLEN leftlen;
     STRLEN rightlen;
@@ -1137,48 +1244,44 @@ Perl_do_vop(pTHX_ I32 optype, SV *sv, SV *left, SV *right)
     }
     else
 #ifdef LIBERAL
-    if (len >= sizeof(long)*4 &&
-	!((unsigned long)dc % sizeof(long)) &&
-	!((unsigned long)lc % sizeof(long)) &&
-	!((unsigned long)rc % sizeof(long)))	/* It's almost always aligned... */
-    {
-	const STRLEN remainder = len % (sizeof(long)*4);
-	len /= (sizeof(long)*4);
-
-	dl = (long*)dc;
-	ll = (long*)lc;
-	rl = (long*)rc;
+    if (len >= PERL_WORDSIZE * 4) {
+	/* A word at a time.  They are moved in and out with Copy(),
+	 * which compilers turn into plain loads and stores, so none of the
+	 * strings need be aligned, as they otherwise often aren't: the
+	 * left or right may have had its start chopped off, for instance.
+	 * dc may be lc or rc, but as each word is loaded before it is
+	 * stored, that does no harm. */
+	const STRLEN remainder = len % PERL_WORDSIZE;
+	const char * const dend = dc + (len - remainder);
+	UV l;
+	UV r;
 
 	switch (optype) {
 	case OP_BIT_AND:
-	    while (len--) {
-		*dl++ = *ll++ & *rl++;
-		*dl++ = *ll++ & *rl++;
-		*dl++ = *ll++ & *rl++;
-		*dl++ = *ll++ & *rl++;
+	    for (; dc < dend; dc += sizeof l, lc += sizeof l, rc += sizeof r) {
+		Copy(lc, &l, 1, UV);
+		Copy(rc, &r, 1, UV);
+		l &= r;
+		Copy(&l, dc, 1, UV);
 	    }
 	    break;
 	case OP_BIT_XOR:
-	    while (len--) {
-		*dl++ = *ll++ ^ *rl++;
-		*dl++ = *ll++ ^ *rl++;
-		*dl++ = *ll++ ^ *rl++;
-		*dl++ = *ll++ ^ *rl++;
+	    for (; dc < dend; dc += sizeof l, lc += sizeof l, rc += sizeof r) {
+		Copy(lc, &l, 1, UV);
+		Copy(rc, &r, 1, UV);
+		l ^= r;
+		Copy(&l, dc, 1, UV);
 	    }
 	    break;
 	case OP_BIT_OR:
-	    while (len--) {
-		*dl++ = *ll++ | *rl++;
-		*dl++ = *ll++ | *rl++;
-		*dl++ = *ll++ | *rl++;
-		*dl++ = *ll++ | *rl++;
+	    for (; dc < dend; dc += sizeof l, lc += sizeof l, rc += sizeof r) {
+		Copy(lc, &l, 1, UV);
+		Copy(rc, &r, 1, UV);
+		l |= r;
+		Copy(&l, dc, 1, UV);
 	    }
 	}
 
-	dc = (char*)dl;
-	lc = (char*)ll;
-	rc = (char*)rl;
-
 	len = remainder;
     }
 #endif
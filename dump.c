@@ -1205,7 +1205,8 @@ Perl_do_magic_dump(pTHX_ I32 level, PerlIO *file, const MAGIC *mg, I32 nest, I32
         if (mg->mg_ptr) {
 	    Perl_dump_indent(aTHX_ level, file, "    MG_PTR = 0x%"UVxf, PTR2UV(mg->mg_ptr));
 	    if (mg->mg_len >= 0) {
-		if (mg->mg_type != PERL_MAGIC_utf8) {
+		if (mg->mg_type != PERL_MAGIC_utf8
+                    && mg->mg_type != PERL_MAGIC_study) {
 		    SV * const sv = newSVpvs("");
 		    PerlIO_printf(file, " %s", pv_display(sv, mg->mg_ptr, mg->mg_len, 0, pvlim));
 		    SvREFCNT_dec_NN(sv);
@@ -1418,6 +1419,8 @@ const struct flag_to_name regexp_core_intflags_names[] = {
     {PREGf_ANCH_MBOL,       "ANCH_MBOL,"},
     {PREGf_ANCH_SBOL,       "ANCH_SBOL,"},
     {PREGf_ANCH_GPOS,       "ANCH_GPOS,"},
+    {PREGf_DFA,             "DFA,"},
+    {PREGf_JIT,             "JIT,"},
 };
 
 void
@@ -920,6 +920,7 @@
 #define reg_qr_package(a)	Perl_reg_qr_package(aTHX_ a)
 #define reg_temp_copy(a,b)	Perl_reg_temp_copy(aTHX_ a,b)
 #define report_uninit(a)	Perl_report_uninit(aTHX_ a)
+#define study_instr(a,b,c,d,e)	Perl_study_instr(aTHX_ a,b,c,d,e)
 #define sv_magicext_mglob(a)	Perl_sv_magicext_mglob(aTHX_ a)
 #define validate_proto(a,b,c)	Perl_validate_proto(aTHX_ a,b,c)
 #define vivify_defelem(a)	Perl_vivify_defelem(aTHX_ a)
@@ -1243,6 +1244,7 @@
 #define magic_setpos(a,b)	Perl_magic_setpos(aTHX_ a,b)
 #define magic_setregexp(a,b)	Perl_magic_setregexp(aTHX_ a,b)
 #define magic_setsig(a,b)	Perl_magic_setsig(aTHX_ a,b)
+#define magic_setstudy(a,b)	Perl_magic_setstudy(aTHX_ a,b)
 #define magic_setsubstr(a,b)	Perl_magic_setsubstr(aTHX_ a,b)
 #define magic_settaint(a,b)	Perl_magic_settaint(aTHX_ a,b)
 #define magic_setutf8(a,b)	Perl_magic_setutf8(aTHX_ a,b)
@@ -1294,6 +1296,10 @@
 #define refcounted_he_new_pv(a,b,c,d,e)	Perl_refcounted_he_new_pv(aTHX_ a,b,c,d,e)
 #define refcounted_he_new_pvn(a,b,c,d,e,f)	Perl_refcounted_he_new_pvn(aTHX_ a,b,c,d,e,f)
 #define refcounted_he_new_sv(a,b,c,d,e)	Perl_refcounted_he_new_sv(aTHX_ a,b,c,d,e)
+#define reg_cache_free()	Perl_reg_cache_free(aTHX)
+#define reg_cache_resize(a)	Perl_reg_cache_resize(aTHX_ a)
+#define reg_freeze(a)		Perl_reg_freeze(aTHX_ a)
+#define reg_thaw(a,b)		Perl_reg_thaw(aTHX_ a,b)
 #define report_evil_fh(a)	Perl_report_evil_fh(aTHX_ a)
 #define report_wrongway_fh(a,b)	Perl_report_wrongway_fh(aTHX_ a,b)
 #define rpeep(a)		Perl_rpeep(aTHX_ a)
@@ -1308,9 +1314,11 @@
 #define set_caret_X()		Perl_set_caret_X(aTHX)
 #define sub_crush_depth(a)	Perl_sub_crush_depth(aTHX_ a)
 #define sv_2num(a)		Perl_sv_2num(aTHX_ a)
+#define sv_catpvfn_fast(a,b,c,d,e,f)	Perl_sv_catpvfn_fast(aTHX_ a,b,c,d,e,f)
 #define sv_clean_all()		Perl_sv_clean_all(aTHX)
 #define sv_clean_objs()		Perl_sv_clean_objs(aTHX)
 #define sv_del_backref(a,b)	Perl_sv_del_backref(aTHX_ a,b)
+#define sv_fast_format_compile(a,b)	Perl_sv_fast_format_compile(aTHX_ a,b)
 #define sv_free_arenas()	Perl_sv_free_arenas(aTHX)
 #define sv_len_utf8_nomg(a)	Perl_sv_len_utf8_nomg(aTHX_ a)
 #define sv_mortalcopy_flags(a,b)	Perl_sv_mortalcopy_flags(aTHX_ a,b)
@@ -1424,6 +1432,10 @@
 #define malloced_size		Perl_malloced_size
 #  endif
 #  if defined(PERL_CORE)
+#define change_case_ascii_run	S_change_case_ascii_run
+#define count_bits		S_count_bits
+#define count_byte		S_count_byte
+#define find_first_variant	S_find_first_variant
 #define opslab_force_free(a)	Perl_opslab_force_free(aTHX_ a)
 #define opslab_free(a)		Perl_opslab_free(aTHX_ a)
 #define opslab_free_nopad(a)	Perl_opslab_free_nopad(aTHX_ a)
@@ -251,7 +251,9 @@
 #define PL_random_state		(vTHX->Irandom_state)
 #define PL_reentrant_buffer	(vTHX->Ireentrant_buffer)
 #define PL_reentrant_retint	(vTHX->Ireentrant_retint)
+#define PL_reg_cache		(vTHX->Ireg_cache)
 #define PL_reg_curpm		(vTHX->Ireg_curpm)
+#define PL_reg_stats		(vTHX->Ireg_stats)
 #define PL_regex_pad		(vTHX->Iregex_pad)
 #define PL_regex_padav		(vTHX->Iregex_padav)
 #define PL_registered_mros	(vTHX->Iregistered_mros)
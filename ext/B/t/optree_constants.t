@@ -207,8 +207,8 @@ my ($expect, $expect_nt) = (<<'EOT_EOT', <<'EONT_EONT');
 # 9  <1> leavesub[1 ref] K/REFC,1 ->(end)
 # -     <@> lineseq KP ->9
 # 1        <;> nextstate(main 635 optree_constants.t:163) v:>,<,% ->2
-# 8        <@> prtf sK ->9
-# 2           <0> pushmark sM ->3
+# 8        <@> prtf sK/FASTFMT ->9
+# 2           <0> pushmark[t1] sM ->3
 # 3           <$> const[PV "myint %d mystr %s myfl %f pi %f\n"] sM/FOLD ->4
 # 4           <$> const[IV 42] sM* ->5          < 5.017002
 # 5           <$> const[PV "hithere"] sM* ->6   < 5.017002
@@ -222,8 +222,8 @@ EOT_EOT
 # 9  <1> leavesub[1 ref] K/REFC,1 ->(end)
 # -     <@> lineseq KP ->9
 # 1        <;> nextstate(main 635 optree_constants.t:163) v:>,<,% ->2
-# 8        <@> prtf sK ->9
-# 2           <0> pushmark sM ->3
+# 8        <@> prtf sK/FASTFMT ->9
+# 2           <0> pushmark[t1] sM ->3
 # 3           <$> const(PV "myint %d mystr %s myfl %f pi %f\n") sM/FOLD ->4
 # 4           <$> const(IV 42) sM* ->5          < 5.017002
 # 5           <$> const(PV "hithere") sM* ->6   < 5.017002
@@ -6,7 +6,7 @@ use strict;
 
 our($VERSION, @ISA, @EXPORT_OK);
 
-$VERSION = "1.32";
+$VERSION = "1.33";
 
 use Carp;
 use Exporter ();
@@ -325,7 +325,7 @@ invert_opset function.
     lt i_lt gt i_gt le i_le ge i_ge eq i_eq ne i_ne ncmp i_ncmp
     slt sgt sle sge seq sne scmp
 
-    substr vec stringify study pos length index rindex ord chr
+    substr vec popcount stringify study pos length index rindex ord chr
 
     ucfirst lcfirst uc lc fc quotemeta trans transr chop schop
     chomp schomp
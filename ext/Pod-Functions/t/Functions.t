@@ -104,8 +104,8 @@ Input and output functions:
      write
 
 Functions for fixed-length data or records:
-     pack, read, syscall, sysread, sysseek, syswrite, unpack,
-     vec
+     pack, popcount, read, syscall, sysread, sysseek, syswrite,
+     unpack, vec
 
 Functions for filehandles, files, or directories:
      -X, chdir, chmod, chown, chroot, fcntl, glob, ioctl, link,
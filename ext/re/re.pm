@@ -4,11 +4,15 @@ package re;
 use strict;
 use warnings;
 
-our $VERSION     = "0.31";
+our $VERSION     = "0.32";
 our @ISA         = qw(Exporter);
 our @EXPORT_OK   = ('regmust',
                     qw(is_regexp regexp_pattern
-                       regname regnames regnames_count));
+                       regname regnames regnames_count
+                       regcache_stats regcache_size
+                       regset regset_match stream
+                       regstats regstats_report
+                       regfreeze regthaw));
 our %EXPORT_OK = map { $_ => 1 } @EXPORT_OK;
 
 my %bitmask = (
@@ -118,12 +122,17 @@ sub bits {
         # Pretend were called with certain parameters, which are best dealt
         # with that way.
         push @_, keys %bitmask; # taint and eval
-        push @_, 'strict';
+        push @_, 'strict', 'jit', 'steps', 'stats';
     }
+    my $skip;   # the argument of the last subpragma
 
     # Process each subpragma parameter
    ARG:
     foreach my $idx (0..$#_){
+        if ($skip) {
+            $skip = 0;
+            next ARG;
+        }
         my $s=$_[$idx];
         if ($s eq 'Debug' or $s eq 'Debugcolor') {
             setcolor() if $s =~/color/i;
@@ -177,6 +186,34 @@ sub bits {
             else {
                 $^H &= ~$flags_hint;
             }
+        } elsif ($s eq 'jit') {
+            if ($on) {
+                $^H{re_jit} = 1;
+            }
+            else {
+                delete $^H{re_jit};
+            }
+        } elsif ($s eq 'steps') {
+            if ($on) {
+                my $n = $_[$idx + 1];
+                $skip = 1;
+                if (!defined $n || $n !~ /^[1-9][0-9]*\z/) {
+                    require Carp;
+                    Carp::carp('"use re steps => N" needs a positive integer N');
+                    next ARG;
+                }
+                $^H{re_steps} = $n;
+            }
+            else {
+                delete $^H{re_steps};
+            }
+        } elsif ($s eq 'stats') {
+            if ($on) {
+                $^H{re_stats} = 1;
+            }
+            else {
+                delete $^H{re_stats};
+            }
 	} elsif ($s =~ s/^\///) {
 	    my $reflags = $^H{reflags} || 0;
 	    my $seen_charset;
@@ -270,6 +307,90 @@ sub bits {
     $bits;
 }
 
+sub regset {
+    my $alt = join "|", map "(?:$_[$_])(*MARK:$_)", 0 .. $#_;
+    return qr/(?:$alt)/;
+}
+
+sub stream {
+    my ($fh, $re, $window) = @_;
+    $window ||= 65536;
+    $re = qr/$re/ unless ref $re;
+    my $buf = "";
+    my $base = 0;       # offset in the file of the start of $buf
+    my $pos = 0;        # where in $buf the next attempt starts
+    my $empty_at = -1;  # where in $buf the last match was, if it was empty
+    my $eof = 0;
+
+    return sub {
+        while (1) {
+            my $end = length $buf;
+            pos($buf) = $pos;
+            my $found = $buf =~ /$re/gc;
+            my ($start, $stop) = $found ? ($-[0], $+[0]) : ($end, $end);
+
+            # An attempt which starts $window or more before the end of the
+            # buffer has seen all it needs, so it can't change when more of
+            # the file is read.  One which has run on for twice $window is
+            # cut off there, so the buffer, and what is scanned again after
+            # each read, stays bounded.
+            if ($found && ($eof || $stop + $window <= $end
+                                || $stop - $start >= 2 * $window)) {
+                if ($start == $stop && $start == $empty_at) {
+                    # like m//g, no second empty match at one place
+                    $pos = $start + 1;
+                    $empty_at = -1;
+                    next if $pos <= $end;
+                }
+                else {
+                    my @groups = map {
+                        defined $-[$_]
+                            ? substr($buf, $-[$_], $+[$_] - $-[$_]) : undef
+                    } 1 .. $#+;
+                    $pos = $stop;
+                    $empty_at = $start == $stop ? $stop : -1;
+                    return ($base + $start, $base + $stop, @groups);
+                }
+            }
+            return if $eof;
+
+            # Skip the attempts which have failed for good, then drop all
+            # but $window bytes before the next one, for lookbehind.
+            my $done = $start < $end - $window + 1
+                     ? $start : $end - $window + 1;
+            if ($done > $pos) {
+                $pos = $done;
+                $empty_at = -1;
+            }
+            if ($pos > $window) {
+                my $cut = $pos - $window;
+                substr($buf, 0, $cut, "");
+                $base += $cut;
+                $pos -= $cut;
+                $empty_at -= $cut if $empty_at >= 0;
+            }
+
+            my $got = read($fh, $buf, $window, length $buf);
+            die "re::stream: can't read: $!" unless defined $got;
+            $eof = 1 unless $got;
+        }
+    };
+}
+
+sub regstats_report {
+    my $fh = shift || \*STDERR;
+    my @stats = sort { $b->{time} <=> $a->{time} || $b->{steps} <=> $a->{steps} }
+                regstats();
+    printf $fh "%10s %10s %10s %10s %12s %12s  %s\n",
+        qw(time attempts matches rejected steps steps/try pattern);
+    for my $s (@stats) {
+        printf $fh "%10.6f %10d %10d %10d %12d %12.1f  %s\n",
+            @$s{qw(time attempts matches rejected steps)},
+            $s->{attempts} ? $s->{steps} / $s->{attempts} : 0, $s->{pattern};
+    }
+    return scalar @stats;
+}
+
 sub import {
     shift;
     $^H |= bits(1, @_);
@@ -309,6 +430,14 @@ re - Perl pragma to alter regular expression behaviour
 
     use re 'strict';               # Raise warnings for more conditions
 
+    use re 'jit';                  # Compile the programs of patterns
+                                   # which are matched often
+
+    use re steps => 1_000_000;     # Die if a match takes longer
+
+    use re 'stats';                # Count what matching patterns costs
+    END { re::regstats_report() }  # and say which cost the most
+
     use re '/ix';
     "FOO" =~ / foo /; # /ix implied
     no re '/x';
@@ -414,6 +543,50 @@ interpolating into another pattern, outside of C<'strict'>, it is not checked
 again for strictness.  This is because if it works under strict it must work
 under non-strict.
 
+=head2 'jit' mode
+
+When C<use re 'jit'> is in effect, a pattern compiled in its scope which
+has been matched more than a few times against strings not in UTF-8 has its
+program compiled into a simpler form that can be matched without
+interpreting the regular expression engine's nodes one by one.  This is
+only done for patterns made of literal strings, single-character classes,
+alternations, anchors, captures and quantifiers on a single character;
+others, and all matches against UTF-8 strings, go on being matched as
+before.  The results of a match are the same either way.
+
+=head2 'steps' mode
+
+When C<use re steps =E<gt> N> is in effect, a match of any pattern compiled
+in its scope dies with "Regexp step limit (N) exceeded" once the regular
+expression engine has taken N steps over it, where a step is trying one
+node of the pattern's program at one position, or backtracking to one.
+This bounds how long a pattern that backtracks badly can take on a
+hostile string, which a timeout can't do, as signals are only delivered
+between ops.  The limit stays with the pattern, so
+
+    my $re = do { use re steps => 100_000; qr/^(\w+\s?)*$/ };
+    eval { $input =~ $re; 1 } or warn "gave up on that input";
+
+applies it wherever C<$re> is used.  C<no re 'steps'> turns it off again.
+Patterns compiled outside its scope have no limit, and don't pay for
+counting.
+
+=head2 'stats' mode
+
+When C<use re 'stats'> is in effect, each pattern compiled in its scope
+keeps count of how many times it has been matched, how many of those
+matched, how many were ruled out by the optimiser before the engine
+proper was run, how many steps (as for C<use re steps>) the engine took,
+and how long it spent, in total.  C<regstats()> returns these for one
+pattern or for all of them, and C<regstats_report()> prints a table of
+them with the most expensive first, so
+
+    perl -Mre=stats -e 'END { re::regstats_report() } ...'
+
+shows which patterns a program spends its time matching.  Patterns
+compiled outside its scope aren't counted, and matching them costs no
+more than before.  C<no re 'stats'> turns it off again.
+
 =head2 '/flags' mode
 
 When C<use re '/flags'> is specified, the given flags are automatically
@@ -719,6 +892,124 @@ named buffers defined, it may not actually match that which is
 returned by C<regnames()> and related routines when those routines
 have not been called with the $all parameter set.
 
+=item regcache_stats()
+
+Patterns compiled at run time, like the one in C<m/$pat/>, are kept in a
+cache of the most recently used ones, so that a pattern interpolated
+again after some others is not compiled again.  This returns four
+numbers: how many compilations were found in the cache, how many were
+not, how many patterns it holds, and how many it can hold.
+
+    my ($hits, $misses, $count, $size) = re::regcache_stats();
+
+Patterns with code blocks, with C<\N{...}> or C<\p{...}>, or which gave a
+warning when compiled are never kept.
+
+=item regcache_size($size)
+
+Returns how many patterns the cache can hold (64 by default), after
+setting it to $size if that is given.  Making it smaller drops the least
+recently used ones; a size of 0 turns it off.
+
+=item regset(@patterns)
+
+Compiles a list of patterns (strings or C<qr//> objects) into one, with
+alternatives which start with literal text combined into a trie, so that
+they can all be looked for in one pass over a string:
+
+    my $set = regset(qr/^GET /, 'error|fail', qr/\.png\b/i);
+    my @matched = regset_match($set, $line);   # e.g. (0, 2)
+
+The result is an ordinary C<qr//>; matching with it directly finds the
+earliest match of any member, and leaves the index of that member in
+C<$REGMARK>.  Capture groups are numbered across the whole set, so
+backreferences in members should use the relative C<\g{-N}> form; and
+C<(*ACCEPT)> and the backtracking control verbs act on the whole set.
+
+=item regset_match($set, $string)
+
+Returns, in ascending order, the indices of the members of $set (made by
+C<regset()>) which match somewhere in $string.
+
+=item stream($fh, $pattern, $window)
+
+Returns an iterator which finds the matches of $pattern (a string or a
+C<qr//>) in what can be read from the filehandle $fh, one at a time and in
+order, like C<m//g> would in the whole of it, without reading all of it
+into memory:
+
+    my $next = re::stream($fh, qr/^From (\S+)/m);
+    while (my ($start, $end, $sender) = $next->()) {
+        ...
+    }
+
+Each call returns where the match starts and ends, counted from the start
+of the handle (so $end is what C<pos()> would be), followed by the
+captured groups; at the end of the file it returns an empty list.
+
+The handle is read $window bytes (64K by default) at a time, and a match
+is only returned once $window bytes past its end have been read, or the
+end of the file.  Only $window bytes before the place the next match is
+tried are kept, and a match which runs on for 2 * $window bytes is
+returned as it stands then, so at most about four windows are held, and
+each read rescans at most about three.  So matches are found just as in
+the slurped file as long as no match attempt needs to look more than
+$window bytes ahead or behind where it starts; longer matches may be
+missed or cut short (a greedy C</a+/> in a long run of C<a>s is returned
+in pieces 2 * $window long).  C<\A> and C<^> without C</m> only match at
+the start of the handle.  The offsets count characters if the handle has
+a C<:utf8> layer.
+
+=item regstats($ref)
+
+=item regstats()
+
+Returns a reference to a hash of what matching the C<qr//> $ref has cost,
+if it was compiled under C<use re 'stats'>; or, without an argument, a
+list of them for every such pattern there is.  The keys are C<pattern>
+(the pattern as C<qr//> would stringify it), C<attempts>, C<matches>,
+C<rejected>, C<steps>, and C<time> (in seconds, measured with the
+resolution of C<gettimeofday()>).  The counts of a pattern go on being
+added to until it is freed.
+
+    my $re = do { use re 'stats'; qr/\d+/ };
+    "a1" =~ $re for 1 .. 10;
+    print re::regstats($re)->{matches};   # 10
+
+=item regstats_report($fh)
+
+Prints the counts of every pattern compiled under C<use re 'stats'> to
+$fh, or to STDERR, one per line and the one which took the longest
+first; and returns how many there are.
+
+=item regfreeze($ref)
+
+Returns a string from which C<regthaw()> makes the C<qr//> $ref again,
+without compiling it: its program, substrings, tries and character
+classes are kept as they are, so loading many large patterns this way is
+much quicker than compiling them.
+
+    my $frozen = regfreeze(qr/\b(?:foo|bar|baz)\d+/i);
+    ...
+    my $re = regthaw($frozen);
+
+Patterns with code blocks can't be frozen.  The string depends on the
+build of perl as well as on the pattern; it is only good for the same
+version of perl built in the same way, and C<regthaw()> dies if it was
+made by any other.
+
+=item regthaw($frozen)
+
+Returns a new C<qr//> made from a string returned by C<regfreeze()>.  It
+dies if the string is not one, or was made by a different build of perl.
+
+Only thaw strings from a source you trust, as you would only C<eval> one.
+The checksum in a frozen pattern catches accidental damage, but
+C<regthaw()> takes the program in it as it stands, so a string made to
+look like one can crash perl or make it read memory it shouldn't.  For
+the same reason Storable isn't taught to use these for C<qr//> objects;
+freeze them yourself where the data is yours.
+
 =back
 
 =head1 SEE ALSO
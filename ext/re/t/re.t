@@ -13,7 +13,7 @@ use strict;
 my $re_taint_bit = 0x00100000;
 my $re_eval_bit = 0x00200000;
 
-use Test::More tests => 15;
+use Test::More tests => 39;
 require_ok( 're' );
 
 # setcolor
@@ -89,3 +89,77 @@ package main;
   re->import();
   is $w, undef, 'no warning for "use re;" (which is not useless)';
 }
+
+{
+  # use re steps => N
+  my $bad = "a" x 1000 . "!";
+  my $re = do { use re steps => 10_000; qr/^(a|aa)+\b$/ };
+  ok( !eval { $bad =~ $re; 1 }, 'a match running over its steps dies' );
+  like( $@, qr/^Regexp step limit \(10000\) exceeded/, '... saying so' );
+  ok( "aaaa" =~ $re, '... but one within them matches' );
+  ok( eval { "x${bad}" =~ $re; 1 }, '... as does one ruled out quickly' );
+
+  my $pat = '^(?:b|bb)+\b$';
+  ok( eval { ("b" x 1000 . "!") =~ /$pat/; 1 },
+      'no limit outside the scope' );
+  {
+    use re steps => 1000;
+    ok( !eval { ("b" x 1000 . "!") =~ /$pat/; 1 },
+        'a pattern compiled at run time in the scope has it' );
+    no re 'steps';
+    ok( eval { ("b" x 1000 . "!") =~ /$pat/; 1 }, "no re 'steps'" );
+  }
+
+  my $w;
+  local $SIG{__WARN__} = sub { $w = shift };
+  eval 'use re steps => "lots"; 1' or die;
+  like( $w, qr/needs a positive integer/, 'a bad limit warns' );
+}
+
+{
+  # use re 'stats'
+  my $re = do { use re 'stats'; qr/(a|b)+c/ };
+  "ababc" =~ $re for 1 .. 3;
+  "ababx" =~ /$re/ for 1 .. 2;
+  "xyz" =~ $re;
+  my $s = re::regstats($re);
+  is( $s->{pattern}, "(?^:(a|b)+c)", 'regstats gives the pattern' );
+  is( $s->{attempts}, 6, '... counts the attempts, through copies too' );
+  is( $s->{matches}, 3, '... and the matches' );
+  is( $s->{rejected}, 3, '... and those intuit rules out' );
+  cmp_ok( $s->{steps}, '>', 12, '... and the steps' );
+  cmp_ok( $s->{time}, '>=', 0, '... and the time' );
+  is( re::regstats(qr/(a|b)+c/), undef, 'none outside the scope' );
+
+  my $gone = eval q{ use re 'stats'; qr/gone/ } or die $@;
+  my @all = grep $_->{pattern} =~ /^\(\?\^:(?:gone|\(a\|b\)\+c)\)\z/,
+            re::regstats();
+  is( scalar @all, 2, 'regstats() lists them all' );
+  undef $gone;
+  @all = grep $_->{pattern} eq "(?^:gone)", re::regstats();
+  is( scalar @all, 0, '... until they are freed' );
+
+  my $cheap = do { use re 'stats'; qr/cheap/ };
+  my $dear = do { use re 'stats'; qr/^(\w)(\w+\s?)*\1\d/ };
+  "cheap" =~ $cheap;
+  ("word " x 4) =~ $dear;
+  cmp_ok( re::regstats($dear)->{steps}, '>', re::regstats($cheap)->{steps},
+          'a pattern which backtracks takes more steps' );
+  open my $fh, ">", \my $report or die;
+  re::regstats_report($fh);
+  my ($head, @rows) = split /\n/, $report;
+  like( $head, qr/^ +time +attempts/, 'regstats_report has a heading' );
+  my @times = map { /^ *(\S+)/ && $1 } @rows;
+  is( "@times", join(" ", sort { $b <=> $a } @times),
+      '... and puts the longest first' );
+  ok( (grep { /\Q(?^:cheap)\E$/ } @rows)
+      && (grep { /\Q(?^:^(\w)(\w+\s?)*\1\d)\E$/ } @rows),
+      '... listing every pattern' );
+
+  # matches which croak are counted too
+  my $long = do { use re 'stats'; use re steps => 1000; qr/^(a|aa)+\b$/ };
+  ok( !eval { ("a" x 100 . "!") =~ $long; 1 }, 'a match over its steps' );
+  $s = re::regstats($long);
+  is( "$s->{attempts} $s->{matches}", "1 0", '... counts as an attempt' );
+  cmp_ok( $s->{steps}, '>=', 1000, '... and its steps are counted' );
+}
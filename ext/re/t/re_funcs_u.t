@@ -13,7 +13,9 @@ use strict;
 use warnings;
 
 use re qw(is_regexp regexp_pattern
-          regname regnames regnames_count);
+          regname regnames regnames_count
+          regcache_stats regcache_size
+          regset regset_match stream regfreeze regthaw);
 {
     use feature 'unicode_strings';  # Force 'u' pat mod
     my $qr=qr/foo/pi;
@@ -126,6 +128,217 @@ if ('1234'=~/(?:(?<A>\d)|(?<C>!))(?<B>\d)(?<A>\d)(?<B>\d)/){
     }
 }
 
+{
+    # Patterns compiled at run time are kept for the next op that wants one
+    my @pats = map "^a$_(\\d)", 1 .. 3;
+    my ($hits, $misses) = regcache_stats();
+    my @got;
+    for my $i (1, 2) {
+        for my $pat (@pats) {
+            push @got, "a${i}7" =~ /$pat/ ? $1 : "-";
+        }
+    }
+    is("@got", "7 - - - 7 -", 'cached patterns match as before');
+    my ($hits2, $misses2, $count, $size) = regcache_stats();
+    is($hits2 - $hits, 3, 'second use of each pattern hits the cache');
+    is($misses2 - $misses, 3, 'first use of each misses');
+    is($size, 64, 'default cache size');
+    ok($count >= 3, 'patterns are kept');
+
+    # each op still has its own captures
+    my ($x, $y) = ("(b)", "(b)");
+    if ("ab" =~ /$x/) {
+        { "b" =~ /$y/ }
+        is($-[1], 1, 'ops sharing a cached pattern keep their own captures');
+    }
+
+    # and the target's get-magic is still called once for each match
+    {
+        package FetchCount;
+        sub TIESCALAR { my $v = $_[1]; bless \$v }
+        sub FETCH { $main::fetches++; ${$_[0]} }
+    }
+    our $fetches = 0;
+    tie my $target, 'FetchCount', "ab";
+    my $b = "b";
+    my $n = grep $target =~ /$b/, 1 .. 3;
+    is("$n $fetches", "3 3", 'cached patterns call get-magic once per match');
+
+    is(regcache_size(2), 64, 'regcache_size returns the old size');
+    is((regcache_stats())[2], 2, 'shrinking the cache drops patterns');
+    is(regcache_size(0), 2, 'regcache_size(0)');
+    is((regcache_stats())[2], 0, '... empties the cache');
+    my $pat = "c(d)";
+    "cd" =~ /$pat/ for 1, 2;
+    is((regcache_stats())[2], 0, '... and keeps nothing');
+    regcache_size(64);
+    ok(!eval { regcache_size(-1); 1 }, 'negative size croaks');
+
+    # a pattern that warns warns for every op that compiles it
+    my $warned = 0;
+    local $SIG{__WARN__} = sub { $warned++ };
+    my $brace = "x{";
+    my $qr1 = qr/a$brace/;
+    my $qr2 = qr/a$brace/;
+    is($warned, 2, 'warnings are given by each op compiling the pattern');
+
+    # including when it was first compiled with them turned off
+    $warned = 0;
+    my $useless = "a(?g)";
+    {
+        no warnings;
+        "a" =~ /$useless/;
+    }
+    "a" =~ /$useless/;
+    is($warned, 1, '... or where they were off');
+}
+
+{
+    # A set of patterns is matched in one pass
+    my $set = regset(qr/^GET /, 'error|fail', qr/\.png\b/i, 'x(\d)\g{-1}',
+                     'fail');
+    is(join(",", regset_match($set, "GET /a.PNG HTTP")), "0,2",
+       'regset_match finds every member that matches');
+    is(join(",", regset_match($set, "job failed: x11")), "1,3,4",
+       '... including overlapping ones');
+    is(join(",", regset_match($set, "x12 nothing")), "",
+       '... and none if none match');
+    ok("a fail" =~ $set, 'a set is an ordinary pattern');
+    our $REGMARK;
+    is($REGMARK, 1, '... which leaves the first member matched in $REGMARK');
+
+    my @words = map "w$_" . "x" x ($_ % 5), 1 .. 200;
+    my $words = regset(@words);
+    is(join(",", regset_match($words, "w17xx w199xxxx w3")), "16,198",
+       'a large set of literals');
+    is(join(",", regset_match(regset(), "abc")), "", 'an empty set');
+
+    my $utf8 = regset("\x{100}+", "b");
+    is(join(",", regset_match($utf8, "ab\x{100}")), "0,1", 'UTF-8');
+    ok(!eval { regset_match("abc", "abc"); 1 },
+       'regset_match croaks given a string');
+}
+
+{
+    # re::stream() should find what m//g finds in the slurped data, even
+    # with a window much smaller than the data
+    my $data = join "", map { "line $_: " . ("ab" x ($_ % 7)) . "\n" } 1 .. 300;
+    my @tests = (qr/ab(ab)+/, qr/^line (\d+)0:/m, qr/(\d+):\s(b?)/, 'x*',
+                 qr/\n(?=line 2)/, qr/(?<=ab)\n/, qr/\bline\b/, qr/b$/m,
+                 qr/\A.../, qr/line 300.*\z/s);
+    for my $re (@tests) {
+        my @want;
+        while ($data =~ /$re/g) {
+            push @want, join ",", $-[0], $+[0],
+                map { defined $_ ? $_ : "u" } map substr($data, $-[$_], $+[$_] - $-[$_]), 1 .. $#+;
+        }
+        for my $window (16, 100, 0) {
+            open my $fh, "<", \$data or die;
+            my $next = stream($fh, $re, $window);
+            my @got;
+            while (my @m = $next->()) {
+                push @got, join ",", map { defined $_ ? $_ : "u" } @m;
+            }
+            is("@got", "@want", "stream($re) with a window of $window");
+        }
+    }
+
+    open my $fh, "<", \"abc" or die;
+    my $next = stream($fh, "z");
+    is(scalar(() = $next->()), 0, 'stream with no matches');
+    is(scalar(() = $next->()), 0, '... stays at the end');
+
+    # A match running on past twice the window is cut off, rather than
+    # growing the buffer and rescanning it on every read
+    my $run = "a" x 100_000;
+    open $fh, "<", \$run or die;
+    $next = stream($fh, qr/a+/, 1000);
+    my @got;
+    while (my @m = $next->()) {
+        push @got, "@m";
+    }
+    is(scalar(@got), 50, 'a long match is returned in pieces');
+    is($got[1], "2000 4000", '... each twice the window');
+}
+
+{
+    # A thawed pattern should match just as the one frozen does
+    my @tests = (qr/abc/, qr/^foo.*bar$/m, qr/(\d+)-(\d+)/, qr/b\z/,
+                 qr/\b(?:alpha|beta|gamma|delta)\b/, qr/(?:foo|bar|baz)\d/i,
+                 qr/[\p{Greek}x]+/, qr/\x{3b1}\w+/i, qr/\x{100}|\x{200}|abc/,
+                 qr/[^\x{100}-\x{200}a-z\s]+/, qr/stra\x{df}e/i,
+                 qr/(?<year>\d{4})-(?<mon>\d\d)/, qr/[[:alpha:]]+ing\b/,
+                 qr/a(*MARK:one)b|c(*MARK:two)d/, qr/(\((?:[^()]++|(?1))*\))/,
+                 qr/(?:x(\d)|y(\w))+?z/s, qr/^ \s*+ \# (?!!) /mx);
+    my @strings = ("abc", "foo\nbar", "12-34 5-6", "ab", "beta, gammas",
+                   "bar9 BAZ7", "x\x{3b1}\x{3b2}x", "\x{391}\x{3b2}c d",
+                   "\x{200}abc\x{100}", "AB\x{1ff}12", "STRASSE strasse",
+                   "2015-03 1999-12", "sing, ringing", "abcd cd",
+                   "f((a)(b(c)))", "x1y_z", " #!# #a", "");
+    for my $re (@tests) {
+        my $thawed = regthaw(regfreeze($re));
+        is(ref $thawed, "Regexp", "regthaw makes a Regexp");
+        is("$thawed", "$re", "... which stringifies as $re did");
+        is(regfreeze($thawed), regfreeze($re), "... and freezes the same");
+        for my $i (0 .. $#strings) {
+            my $string = $strings[$i];
+            my @matches = map {
+                my $pat = $_;
+                my @m;
+                while ($string =~ /$pat/g) {
+                    push @m, join ",", $-[0], $+[0],
+                        map({ defined $_ ? $_ : "u" }
+                            map substr($string, $-[$_], $+[$_] - $-[$_]), 1 .. $#+),
+                        map("$_=$+{$_}", sort keys %+),
+                        defined $::REGMARK ? $::REGMARK : "";
+                }
+                "@m";
+            } $re, $thawed;
+            is($matches[1], $matches[0], "thawed $re on string $i");
+        }
+    }
+
+    # Compiled twice (not from the cache), a pattern freezes the same
+    my $size = regcache_size();
+    regcache_size(0);
+    my @frozen = map {
+        my $src = '(?<y>\d+)-(?<m>\d+)\b(?:alpha|beta|gamma)[x-z]';
+        regfreeze(qr/$src/);
+    } 1, 2;
+    regcache_size($size);
+    is($frozen[1], $frozen[0], 'a pattern compiled twice freezes the same');
+
+    my $steps = do { use re steps => 10_000; qr/^(a|aa)+\b$/ };
+    my $thawed = regthaw(regfreeze($steps));
+    ok(!eval { ("a" x 1000 . "!") =~ $thawed; 1 }, 'the step limit is kept');
+    my $stats = do { use re 'stats'; qr/x/ };
+    $thawed = regthaw(regfreeze($stats));
+    "xx" =~ $thawed for 1 .. 3;
+    is(re::regstats($thawed)->{matches}, 3, 'as are counts of the cost');
+
+    my $code = qr/a(?{ 1 })b/;
+    ok(!eval { regfreeze($code); 1 }, 'patterns with code blocks ...');
+    like($@, qr/^Can't freeze a regexp with code blocks/, '... can\'t be frozen');
+    ok(!eval { regfreeze("abc"); 1 }, 'regfreeze croaks given a string');
+
+    my $frozen = regfreeze(qr/a(b)c/);
+    for ([ 'a changed byte', sub { substr($_[0], -1, 1) ^= "\1" } ],
+         [ 'a short string', sub { substr($_[0], -1, 1, "") } ],
+         [ 'another string', sub { $_[0] = "abc" } ])
+    {
+        my ($what, $change) = @$_;
+        my $copy = $frozen;
+        $change->($copy);
+        ok(!eval { regthaw($copy); 1 }, "regthaw croaks given $what");
+        like($@, qr/^Corrupt frozen regexp/, '... saying it is corrupt');
+    }
+    my $copy = $frozen;
+    substr($copy, 4, 1) ^= "\1";
+    ok(!eval { regthaw($copy); 1 }, 'regthaw croaks given another build\'s');
+    like($@, qr/^Can't thaw a regexp frozen by a different build of perl/,
+         '... and says so');
+}
+
 # New tests go here ^^^
 
     { # Keep these tests last, as whole script will be interrupted if times out
@@ -66,6 +66,12 @@
 	 FEATURE_IS_ENABLED("bitwise") \
     )
 
+#define FEATURE_POPCOUNT_IS_ENABLED \
+    ( \
+	CURRENT_FEATURE_BUNDLE == FEATURE_BUNDLE_CUSTOM && \
+	 FEATURE_IS_ENABLED("popcount") \
+    )
+
 #define FEATURE_EVALBYTES_IS_ENABLED \
     ( \
 	CURRENT_FEATURE_BUNDLE == FEATURE_BUNDLE_515 \
@@ -348,6 +348,194 @@ S_should_warn_nl(const char *pv) {
     return len > 0 && pv[len-1] == '\n';
 }
 
+/* Returns the number of bytes in the range s..e-1 that equal 'c'.  Long
+ * strings are done a word at a time: XOR-ing a word with 'c' repeated in each
+ * byte leaves a zero byte wherever there was a match, and the zero bytes are
+ * then located without any carry spilling from one byte into the next */
+
+PERL_STATIC_INLINE STRLEN
+S_count_byte(const U8 *s, const U8 * const e, const U8 c)
+{
+    STRLEN count = 0;
+
+    PERL_ARGS_ASSERT_COUNT_BYTE;
+
+    if ((STRLEN) (e - s) >= 4 * PERL_WORDSIZE) {
+        const UV pattern = PERL_COUNT_MULTIPLIER * c;
+        const UV low_bits = PERL_COUNT_MULTIPLIER * 0x7F;
+
+        while (PTR2nat(s) & PERL_WORD_BOUNDARY_MASK) {
+            count += (*s++ == c);
+        }
+
+        while (s + PERL_WORDSIZE <= e) {
+            UV sums = 0;
+            int i;
+
+            /* Each byte of 'sums' counts the matches in that byte position.
+             * Stop before the total of all of them could exceed 255, then
+             * add them together by multiplying, which leaves the total in
+             * the top byte */
+            for (i = 0; i < 255 / PERL_WORDSIZE && s + PERL_WORDSIZE <= e; i++) {
+                const UV x = *(const UV *) s ^ pattern;
+                sums += (~(((x & low_bits) + low_bits) | x)
+                         & PERL_VARIANTS_WORD_MASK) >> 7;
+                s += PERL_WORDSIZE;
+            }
+            count += (sums * PERL_COUNT_MULTIPLIER) >> ((PERL_WORDSIZE - 1) * 8);
+        }
+    }
+
+    while (s < e) {
+        count += (*s++ == c);
+    }
+
+    return count;
+}
+
+/* Returns the number of bits set in the bytes s..e-1.  Long strings are done
+ * a word at a time: each pair of bits is replaced by its count, then each
+ * nybble and then each byte by theirs.  The byte counts of several words are
+ * summed, and the bytes of the sum are added together by multiplying, which
+ * leaves the total in the top byte */
+
+PERL_STATIC_INLINE STRLEN
+S_count_bits(const U8 *s, const U8 * const e)
+{
+    STRLEN count = 0;
+
+    PERL_ARGS_ASSERT_COUNT_BITS;
+
+    if ((STRLEN) (e - s) >= 2 * PERL_WORDSIZE) {
+        while (PTR2nat(s) & PERL_WORD_BOUNDARY_MASK) {
+            count += PL_bitcount[*s++];
+        }
+
+        while (s + PERL_WORDSIZE <= e) {
+            UV sums = 0;
+            int i;
+
+            /* Each byte count is at most 8; stop before the total of the
+             * bytes of 'sums' could exceed 255 */
+            for (i = 0; i < 255 / (8 * PERL_WORDSIZE) && s + PERL_WORDSIZE <= e;
+                 i++)
+            {
+                UV w = *(const UV *) s;
+
+                w -= (w >> 1) & (PERL_COUNT_MULTIPLIER * 0x55);
+                w = (w & (PERL_COUNT_MULTIPLIER * 0x33))
+                  + ((w >> 2) & (PERL_COUNT_MULTIPLIER * 0x33));
+                sums += (w + (w >> 4)) & (PERL_COUNT_MULTIPLIER * 0x0F);
+                s += PERL_WORDSIZE;
+            }
+            count += (sums * PERL_COUNT_MULTIPLIER) >> ((PERL_WORDSIZE - 1) * 8);
+        }
+    }
+
+    while (s < e) {
+        count += PL_bitcount[*s++];
+    }
+
+    return count;
+}
+
+/* Returns a pointer to the first byte in s..e-1 that isn't invariant under
+ * UTF-8 encoding, or 'e' if there is none.  On ASCII platforms this is
+ * done a word at a time, as the variants are just the bytes with their high
+ * bit set */
+
+PERL_STATIC_INLINE const U8 *
+S_find_first_variant(const U8 *s, const U8 * const e)
+{
+    PERL_ARGS_ASSERT_FIND_FIRST_VARIANT;
+
+#ifndef EBCDIC
+    if ((STRLEN) (e - s) >= 2 * PERL_WORDSIZE) {
+        while (PTR2nat(s) & PERL_WORD_BOUNDARY_MASK) {
+            if (! UTF8_IS_INVARIANT(*s)) {
+                return s;
+            }
+            s++;
+        }
+
+        while (s + PERL_WORDSIZE <= e
+               && ! (*(const UV *) s & PERL_VARIANTS_WORD_MASK))
+        {
+            s += PERL_WORDSIZE;
+        }
+    }
+#endif
+
+    while (s < e && UTF8_IS_INVARIANT(*s)) {
+        s++;
+    }
+
+    return s;
+}
+
+/* Copies the string s..e-1 to 'd' (which may be the same as 's'), changing
+ * any ASCII letters to uppercase if 'to_upper' is TRUE, else to lowercase, and
+ * stopping at the first character that isn't ASCII.  Returns how many bytes
+ * were done.  Nothing else in the ASCII range changes case under any rules
+ * but those of a locale, so this can be used by lc(), uc() and fc() for the
+ * ASCII runs of both UTF-8 and non-UTF-8 strings.
+ *
+ * Long runs are done a word at a time.  Adding the right constant to each
+ * byte of a word of ASCII sets the high bit of those bytes that are at least
+ * the first letter of the range to change, and another that of the bytes
+ * above the last one, without any carries between bytes.  The bytes to
+ * change are those set in the first sum and not the second; each has 0x20
+ * flipped */
+
+PERL_STATIC_INLINE STRLEN
+S_change_case_ascii_run(U8 *d, const U8 *s, const U8 * const e,
+                        const bool to_upper)
+{
+    const U8 * const start = s;
+
+    PERL_ARGS_ASSERT_CHANGE_CASE_ASCII_RUN;
+
+#ifndef EBCDIC
+    if ((STRLEN) (e - s) >= 2 * PERL_WORDSIZE) {
+        const UV at_least_first = PERL_COUNT_MULTIPLIER
+                                * (0x80 - (to_upper ? 'a' : 'A'));
+        const UV above_last     = PERL_COUNT_MULTIPLIER
+                                * (0x7F - (to_upper ? 'z' : 'Z'));
+
+        while (PTR2nat(s) & PERL_WORD_BOUNDARY_MASK) {
+            if (! isASCII(*s)) {
+                return s - start;
+            }
+            *d++ = (to_upper) ? toUPPER(*s) : toLOWER(*s);
+            s++;
+        }
+
+        while (s + PERL_WORDSIZE <= e) {
+            UV w = *(const UV *) s;
+
+            if (w & PERL_VARIANTS_WORD_MASK) {
+                break;
+            }
+
+            w ^= (  (w + at_least_first)
+                  & ~(w + above_last)
+                  & PERL_VARIANTS_WORD_MASK) >> 2;
+
+            /* 'd' needn't be aligned as 's' is */
+            Copy(&w, d, PERL_WORDSIZE, U8);
+            d += PERL_WORDSIZE;
+            s += PERL_WORDSIZE;
+        }
+    }
+#endif
+
+    for (; s < e && isASCII(*s); s++, d++) {
+        *d = (to_upper) ? toUPPER(*s) : toLOWER(*s);
+    }
+
+    return s - start;
+}
+
 #endif
 
 /* ------------------ pp.c, regcomp.c, toke.c, universal.c ------------ */
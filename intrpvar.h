@@ -129,6 +129,12 @@ PERLVARI(I, reg_curpm, PMOP*, NULL)
 PERLVARI(I, regmatch_slab, regmatch_slab *,	NULL)
 PERLVAR(I, regmatch_state, regmatch_state *)
 
+/* patterns recently compiled at run time */
+PERLVARI(I, reg_cache, reg_cache *,	NULL)
+
+/* the counts of all patterns compiled under "use re 'stats'" */
+PERLVARI(I, reg_stats, reg_stats *,	NULL)
+
 PERLVAR(I, comppad,	PAD *)		/* storage for lexically scoped temporaries */
 
 /*
@@ -2345,7 +2345,7 @@ Perl_keyword (pTHX_ const char *name, I32 len, bool all_keywords)
           goto unknown;
       }
 
-    case 8: /* 26 tokens of length 8 */
+    case 8: /* 27 tokens of length 8 */
       switch (name[0])
       {
         case 'A':
@@ -2608,6 +2608,20 @@ Perl_keyword (pTHX_ const char *name, I32 len, bool all_keywords)
 
           goto unknown;
 
+        case 'p':
+          if (name[1] == 'o' &&
+              name[2] == 'p' &&
+              name[3] == 'c' &&
+              name[4] == 'o' &&
+              name[5] == 'u' &&
+              name[6] == 'n' &&
+              name[7] == 't')
+          {                                       /* popcount         */
+            return (all_keywords || FEATURE_POPCOUNT_IS_ENABLED ? -KEY_popcount : 0);
+          }
+
+          goto unknown;
+
         case 'r':
           if (name[1] == 'e' &&
               name[2] == 'a' &&
@@ -3437,5 +3451,5 @@ unknown:
 }
 
 /* Generated from:
- * 963511f90d23994583c88b07c3cf2258473567702972e94b59a635727c4aa944 regen/keywords.pl
+ * b029b73237bae63cf3c05b5ec2b02bc19c88b153ad7398e9c8dc6c6810f48444 regen/keywords.pl
  * ex: set ro: */
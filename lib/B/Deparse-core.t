@@ -36,10 +36,11 @@ BEGIN {
 
 use strict;
 use Test::More;
-plan tests => 4006;
+plan tests => 4042;
 
 use feature (sprintf(":%vd", $^V)); # to avoid relying on the feature
                                     # logic to add CORE::
+use feature 'popcount';             # which isn't in any bundle
 no warnings 'experimental::autoderef';
 use B::Deparse;
 my $deparse = new B::Deparse;
@@ -556,6 +557,7 @@ our              123   p+ # skip with 0 args, as our() => ()
 pack             123   p
 pipe             2     p
 pop              01    1
+popcount         123   p
 pos              01    $+
 print            @     p$+
 printf           @     p$+
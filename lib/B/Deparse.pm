@@ -46,7 +46,7 @@ use B qw(class main_root main_start main_cv svref_2object opnumber perlstring
         MDEREF_SHIFT
     );
 
-$VERSION = '1.33';
+$VERSION = '1.35';
 use strict;
 use vars qw/$AUTOLOAD/;
 use warnings ();
@@ -361,7 +361,7 @@ BEGIN {
 
 
 BEGIN { for (qw[ const stringify rv2sv list glob pushmark null aelem
-		 nextstate dbstate rv2av rv2hv helem custom ]) {
+		 nextstate dbstate rv2av rv2hv helem custom keys ]) {
     eval "sub OP_\U$_ () { " . opnumber($_) . "}"
 }}
 
@@ -694,7 +694,7 @@ sub begin_is_use {
     # so we ignore them here
     if ($module eq 'strict' || $module eq 'integer'
 	|| $module eq 'bytes' || $module eq 'warnings'
-	|| $module eq 'feature') {
+	|| $module eq 'feature' || $module eq 'roundtrip') {
 	return "";
     }
 
@@ -1035,7 +1035,8 @@ sub ambient_pragmas {
 
 	elsif ($name eq 'integer'
 	    || $name eq 'bytes'
-	    || $name eq 'utf8') {
+	    || $name eq 'utf8'
+	    || $name eq 'roundtrip') {
 	    require "$name.pm";
 	    if ($val) {
 		$hint_bits |= ${$::{"${name}::"}{"hint_bits"}};
@@ -2124,6 +2125,7 @@ sub hint_pragmas {
 	push @pragmas, "strict " . join ', ', @strict;
     }
     push @pragmas, "bytes" if $bits & 0x8;
+    push @pragmas, "roundtrip" if $bits & 0x20000000;
     return @pragmas;
 }
 
@@ -2143,6 +2145,7 @@ my %feature_keywords = (
     evalbytes=>'evalbytes',
     __SUB__ => '__SUB__',
    fc       => 'fc',
+   popcount => 'popcount',
 );
 
 # keywords that are strong and also have a prototype
@@ -3117,6 +3120,7 @@ sub pp_substr {
 }
 sub pp_vec { maybe_targmy(@_, \&maybe_local, listop(@_, "vec")) }
 sub pp_index { maybe_targmy(@_, \&listop, "index") }
+sub pp_popcount { maybe_targmy(@_, \&listop, "popcount") }
 sub pp_rindex { maybe_targmy(@_, \&listop, "rindex") }
 sub pp_sprintf { maybe_targmy(@_, \&listop, "sprintf") }
 sub pp_formline { listop(@_, "formline") } # see also deparse_format
@@ -3668,6 +3672,8 @@ sub pp_null {
 	return $self->pp_scope($op->first, $cx);
     } elsif ($op->targ == OP_STRINGIFY) {
 	return $self->dquote($op, $cx);
+    } elsif ($op->targ == OP_KEYS) {
+	return $self->pp_keys($op, $cx);
     } elsif ($op->targ == OP_GLOB) {
 	return $self->pp_glob(
 	         $op->first    # entersub
@@ -6105,6 +6111,8 @@ Cannot be non-zero on Perl 5.15.3 or later.
 
 =item integer
 
+=item roundtrip
+
 If the value is true, then the appropriate pragma is assumed to
 be in the ambient scope, otherwise not.
 
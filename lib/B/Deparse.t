@@ -1143,6 +1143,12 @@ print $main::x;
 no strict 'vars';
 $x;
 ####
+# roundtrip
+use roundtrip;
+print $a + $b;
+no roundtrip;
+print $a + $b;
+####
 # TODO Subsets of warnings could be encoded textually, rather than as bitflips.
 # subsets of warnings
 no warnings 'deprecated';
@@ -1553,6 +1559,11 @@ print sort(foo('bar'));
 >>>>
 print sort(foo('bar'));
 ####
+# sort keys
+our %h;
+print sort(keys %h);
+print reverse sort(keys %h);
+####
 # substr assignment
 substr(my $a, 0, 0) = (foo(), bar());
 $a++;
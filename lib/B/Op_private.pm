@@ -120,10 +120,13 @@ our %bits;
 
 our $VERSION = "5.021009";
 
+$bits{$_}{6} = 'OPpCMP_KEYDESC' for qw(i_ncmp ncmp scmp);
+$bits{$_}{7} = 'OPpCMP_SORTKEY' for qw(i_ncmp ncmp scmp);
 $bits{$_}{3} = 'OPpENTERSUB_AMPER' for qw(entersub rv2cv);
 $bits{$_}{6} = 'OPpENTERSUB_DB' for qw(entersub rv2cv);
 $bits{$_}{2} = 'OPpENTERSUB_HASTARG' for qw(entersub rv2cv);
 $bits{$_}{6} = 'OPpFLIP_LINENUM' for qw(flip flop);
+$bits{$_}{4} = 'OPpFORMAT_FAST' for qw(prtf sprintf);
 $bits{$_}{1} = 'OPpFT_ACCESS' for qw(fteexec fteread ftewrite ftrexec ftrread ftrwrite);
 $bits{$_}{4} = 'OPpFT_AFTER_t' for qw(ftatime ftbinary ftblk ftchr ftctime ftdir fteexec fteowned fteread ftewrite ftfile ftis ftlink ftmtime ftpipe ftrexec ftrowned ftrread ftrwrite ftsgid ftsize ftsock ftsuid ftsvtx fttext fttty ftzero);
 $bits{$_}{2} = 'OPpFT_STACKED' for qw(ftatime ftbinary ftblk ftchr ftctime ftdir fteexec fteowned fteread ftewrite ftfile ftis ftlink ftmtime ftpipe ftrexec ftrowned ftrread ftrwrite ftsgid ftsize ftsock ftsuid ftsvtx fttext fttty ftzero);
@@ -150,7 +153,7 @@ $bits{$_}{7} = 'OPpPV_IS_UTF8' for qw(dump goto last next redo);
 $bits{$_}{6} = 'OPpREFCOUNTED' for qw(leave leaveeval leavesub leavesublv leavewrite);
 $bits{$_}{6} = 'OPpRUNTIME' for qw(match pushre qr subst substcont);
 $bits{$_}{2} = 'OPpSLICEWARNING' for qw(aslice hslice padav padhv rv2av rv2hv);
-$bits{$_}{4} = 'OPpTARGET_MY' for qw(abs add atan2 chdir chmod chomp chown chr chroot complement concat cos crypt divide exec exp flock getpgrp getppid getpriority hex i_add i_divide i_modulo i_multiply i_ncmp i_subtract index int kill left_shift length link log match mkdir modulo multiply nbit_and nbit_or nbit_xor ncomplement oct ord pow push rand rename repeat right_shift rindex rmdir schomp scmp scomplement setpgrp setpriority sin sleep split sqrt srand stringify subst subtract symlink system time trans transr unlink unshift utime vec wait waitpid);
+$bits{$_}{4} = 'OPpTARGET_MY' for qw(abs add atan2 chdir chmod chomp chown chr chroot complement concat cos crypt divide exec exp flock getpgrp getppid getpriority hex i_add i_divide i_modulo i_multiply i_ncmp i_subtract index int kill left_shift length link log match mkdir modulo multiply nbit_and nbit_or nbit_xor ncomplement oct ord popcount pow push rand rename repeat right_shift rindex rmdir schomp scmp scomplement setpgrp setpriority sin sleep split sqrt srand stringify subst subtract symlink system time trans transr unlink unshift utime vec wait waitpid);
 $bits{$_}{5} = 'OPpTRANS_COMPLEMENT' for qw(trans transr);
 $bits{$_}{7} = 'OPpTRANS_DELETE' for qw(trans transr);
 $bits{$_}{0} = 'OPpTRANS_FROM_UTF' for qw(trans transr);
@@ -441,6 +444,7 @@ $bits{ord}{0} = $bf[0];
 @{$bits{padsv}}{5,4} = ($bf[6], $bf[6]);
 @{$bits{pipe_op}}{3,2,1,0} = ($bf[3], $bf[3], $bf[3], $bf[3]);
 $bits{pop}{0} = $bf[0];
+@{$bits{popcount}}{3,2,1,0} = ($bf[3], $bf[3], $bf[3], $bf[3]);
 $bits{pos}{0} = $bf[0];
 $bits{postdec}{0} = $bf[0];
 $bits{postinc}{0} = $bf[0];
@@ -518,7 +522,7 @@ $bits{sin}{0} = $bf[0];
 $bits{snetent}{0} = $bf[0];
 @{$bits{socket}}{3,2,1,0} = ($bf[3], $bf[3], $bf[3], $bf[3]);
 @{$bits{sockpair}}{3,2,1,0} = ($bf[3], $bf[3], $bf[3], $bf[3]);
-@{$bits{sort}}{6,5,4,3,2,1,0} = ('OPpSORT_STABLE', 'OPpSORT_QSORT', 'OPpSORT_DESCEND', 'OPpSORT_INPLACE', 'OPpSORT_REVERSE', 'OPpSORT_INTEGER', 'OPpSORT_NUMERIC');
+@{$bits{sort}}{7,6,5,4,3,2,1,0} = ('OPpSORT_LIMIT', 'OPpSORT_STABLE', 'OPpSORT_QSORT', 'OPpSORT_DESCEND', 'OPpSORT_INPLACE', 'OPpSORT_REVERSE', 'OPpSORT_INTEGER', 'OPpSORT_NUMERIC');
 @{$bits{splice}}{3,2,1,0} = ($bf[3], $bf[3], $bf[3], $bf[3]);
 $bits{split}{7} = 'OPpSPLIT_IMPLIM';
 @{$bits{sprintf}}{3,2,1,0} = ($bf[3], $bf[3], $bf[3], $bf[3]);
@@ -572,6 +576,8 @@ our %defines = (
     OPpASSIGN_BACKWARDS      =>  64,
     OPpASSIGN_COMMON         =>  64,
     OPpASSIGN_CV_TO_GV       => 128,
+    OPpCMP_KEYDESC           =>  64,
+    OPpCMP_SORTKEY           => 128,
     OPpCONST_BARE            =>  64,
     OPpCONST_ENTERED         =>  16,
     OPpCONST_NOVER           =>   2,
@@ -599,6 +605,7 @@ our %defines = (
     OPpEVAL_UNICODE          =>   4,
     OPpEXISTS_SUB            =>  64,
     OPpFLIP_LINENUM          =>  64,
+    OPpFORMAT_FAST           =>  16,
     OPpFT_ACCESS             =>   2,
     OPpFT_AFTER_t            =>  16,
     OPpFT_STACKED            =>   4,
@@ -643,6 +650,7 @@ our %defines = (
     OPpSORT_DESCEND          =>  16,
     OPpSORT_INPLACE          =>   8,
     OPpSORT_INTEGER          =>   2,
+    OPpSORT_LIMIT            => 128,
     OPpSORT_NUMERIC          =>   1,
     OPpSORT_QSORT            =>  32,
     OPpSORT_REVERSE          =>   4,
@@ -665,6 +673,8 @@ our %labels = (
     OPpASSIGN_BACKWARDS      => 'BKWARD',
     OPpASSIGN_COMMON         => 'COMMON',
     OPpASSIGN_CV_TO_GV       => 'CV2GV',
+    OPpCMP_KEYDESC           => 'KEYDESC',
+    OPpCMP_SORTKEY           => 'SORTKEY',
     OPpCONST_BARE            => 'BARE',
     OPpCONST_ENTERED         => 'ENTERED',
     OPpCONST_NOVER           => 'NOVER',
@@ -691,6 +701,7 @@ our %labels = (
     OPpEVAL_UNICODE          => 'UNI',
     OPpEXISTS_SUB            => 'SUB',
     OPpFLIP_LINENUM          => 'LINENUM',
+    OPpFORMAT_FAST           => 'FASTFMT',
     OPpFT_ACCESS             => 'FTACCESS',
     OPpFT_AFTER_t            => 'FTAFTERt',
     OPpFT_STACKED            => 'FTSTACKED',
@@ -732,6 +743,7 @@ our %labels = (
     OPpSORT_DESCEND          => 'DESC',
     OPpSORT_INPLACE          => 'INPLACE',
     OPpSORT_INTEGER          => 'INT',
+    OPpSORT_LIMIT            => 'LIMIT',
     OPpSORT_NUMERIC          => 'NUM',
     OPpSORT_QSORT            => 'QSORT',
     OPpSORT_REVERSE          => 'REV',
@@ -754,6 +766,7 @@ our %ops_using = (
     OPpALLOW_FAKE            => [qw(rv2gv)],
     OPpASSIGN_BACKWARDS      => [qw(sassign)],
     OPpASSIGN_COMMON         => [qw(aassign)],
+    OPpCMP_KEYDESC           => [qw(i_ncmp ncmp scmp)],
     OPpCONST_BARE            => [qw(const)],
     OPpCOREARGS_DEREF1       => [qw(coreargs)],
     OPpEARLY_CV              => [qw(gv)],
@@ -763,6 +776,7 @@ our %ops_using = (
     OPpEVAL_BYTES            => [qw(entereval)],
     OPpEXISTS_SUB            => [qw(exists)],
     OPpFLIP_LINENUM          => [qw(flip flop)],
+    OPpFORMAT_FAST           => [qw(prtf sprintf)],
     OPpFT_ACCESS             => [qw(fteexec fteread ftewrite ftrexec ftrread ftrwrite)],
     OPpFT_AFTER_t            => [qw(ftatime ftbinary ftblk ftchr ftctime ftdir fteexec fteowned fteread ftewrite ftfile ftis ftlink ftmtime ftpipe ftrexec ftrowned ftrread ftrwrite ftsgid ftsize ftsock ftsuid ftsvtx fttext fttty ftzero)],
     OPpGREP_LEX              => [qw(grepstart grepwhile mapstart mapwhile)],
@@ -792,11 +806,12 @@ our %ops_using = (
     OPpSORT_DESCEND          => [qw(sort)],
     OPpSPLIT_IMPLIM          => [qw(split)],
     OPpSUBSTR_REPL_FIRST     => [qw(substr)],
-    OPpTARGET_MY             => [qw(abs add atan2 chdir chmod chomp chown chr chroot complement concat cos crypt divide exec exp flock getpgrp getppid getpriority hex i_add i_divide i_modulo i_multiply i_ncmp i_subtract index int kill left_shift length link log match mkdir modulo multiply nbit_and nbit_or nbit_xor ncomplement oct ord pow push rand rename repeat right_shift rindex rmdir schomp scmp scomplement setpgrp setpriority sin sleep split sqrt srand stringify subst subtract symlink system time trans transr unlink unshift utime vec wait waitpid)],
+    OPpTARGET_MY             => [qw(abs add atan2 chdir chmod chomp chown chr chroot complement concat cos crypt divide exec exp flock getpgrp getppid getpriority hex i_add i_divide i_modulo i_multiply i_ncmp i_subtract index int kill left_shift length link log match mkdir modulo multiply nbit_and nbit_or nbit_xor ncomplement oct ord popcount pow push rand rename repeat right_shift rindex rmdir schomp scmp scomplement setpgrp setpriority sin sleep split sqrt srand stringify subst subtract symlink system time trans transr unlink unshift utime vec wait waitpid)],
     OPpTRANS_COMPLEMENT      => [qw(trans transr)],
 );
 
 $ops_using{OPpASSIGN_CV_TO_GV} = $ops_using{OPpASSIGN_BACKWARDS};
+$ops_using{OPpCMP_SORTKEY} = $ops_using{OPpCMP_KEYDESC};
 $ops_using{OPpCONST_ENTERED} = $ops_using{OPpCONST_BARE};
 $ops_using{OPpCONST_NOVER} = $ops_using{OPpCONST_BARE};
 $ops_using{OPpCONST_SHORTCIRCUIT} = $ops_using{OPpCONST_BARE};
@@ -821,6 +836,7 @@ $ops_using{OPpOPEN_OUT_CRLF} = $ops_using{OPpOPEN_IN_CRLF};
 $ops_using{OPpOPEN_OUT_RAW} = $ops_using{OPpOPEN_IN_CRLF};
 $ops_using{OPpSORT_INPLACE} = $ops_using{OPpSORT_DESCEND};
 $ops_using{OPpSORT_INTEGER} = $ops_using{OPpSORT_DESCEND};
+$ops_using{OPpSORT_LIMIT} = $ops_using{OPpSORT_DESCEND};
 $ops_using{OPpSORT_NUMERIC} = $ops_using{OPpSORT_DESCEND};
 $ops_using{OPpSORT_QSORT} = $ops_using{OPpSORT_DESCEND};
 $ops_using{OPpSORT_REVERSE} = $ops_using{OPpSORT_DESCEND};
@@ -13,6 +13,7 @@ our %feature = (
     state           => 'feature_state',
     switch          => 'feature_switch',
     bitwise         => 'feature_bitwise',
+    popcount        => 'feature_popcount',
     evalbytes       => 'feature_evalbytes',
     postderef       => 'feature_postderef',
     array_base      => 'feature_arybase',
@@ -29,7 +30,7 @@ our %feature_bundle = (
     "5.10"    => [qw(array_base say state switch)],
     "5.11"    => [qw(array_base say state switch unicode_strings)],
     "5.15"    => [qw(current_sub evalbytes fc say state switch unicode_eval unicode_strings)],
-    "all"     => [qw(array_base bitwise current_sub evalbytes fc lexical_subs postderef postderef_qq refaliasing say signatures state switch unicode_eval unicode_strings)],
+    "all"     => [qw(array_base bitwise current_sub evalbytes fc lexical_subs popcount postderef postderef_qq refaliasing say signatures state switch unicode_eval unicode_strings)],
     "default" => [qw(array_base)],
 );
 
@@ -338,6 +339,16 @@ See L<perlop/Bitwise String Operators> for details.
 
 This feature is available from Perl 5.22 onwards.
 
+=head2 The 'popcount' feature
+
+C<use feature 'popcount'> tells the compiler to enable the C<popcount>
+function, which counts the bits set in a string.
+
+See L<perlfunc/popcount> for details.
+
+This feature is available from Perl 5.22 onwards.  It is not in any
+feature bundle.
+
 =head1 FEATURE BUNDLES
 
 It's possible to load multiple features together, using
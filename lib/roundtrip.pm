@@ -0,0 +1,65 @@
+package roundtrip;
+
+our $VERSION = '1.00';
+
+=head1 NAME
+
+roundtrip - Perl pragma to stringify numbers so that they read back exactly
+
+=head1 SYNOPSIS
+
+    use roundtrip;
+    print 0.1 + 0.2;       # 0.30000000000000004
+    print 0.1;             # 0.1
+
+    no roundtrip;
+    print 0.1 + 0.2;       # 0.3
+
+=head1 DESCRIPTION
+
+Perl normally turns a floating point number into a string as
+C<sprintf("%.15g")> would, on platforms with the usual 64-bit doubles.
+This is usually what people want to see, but different numbers can come
+out the same: C<0.1 + 0.2> and C<0.3> both become C<"0.3">, and so a
+number which is written out and read back in may not be the number that
+went out.
+
+Under C<use roundtrip>, numbers are stringified with as many significant
+digits as it takes for the string to read back as the same number, and
+no more.  A number that already reads back exactly with the usual digits
+stringifies just as it would otherwise, so only numbers that would lose
+something come out longer.  This is useful when writing out data, such
+as JSON or CSV, that will be read in again.
+
+The pragma is lexically scoped, from here to the end of the enclosing
+BLOCK, and applies wherever a number is turned into a string, such as
+by C<print>, C<join>, concatenation and interpolation.  It does not
+change what C<sprintf> does with an explicit format.
+
+Most numbers are stringified nearly as quickly under C<use roundtrip>
+as without it.  Some, such as very large or very small numbers, are
+slower, as the result is read back to check it.  On some platforms the
+result is not cached with the number.
+
+=head1 BUGS
+
+Where numbers are not the usual 64-bit doubles, more digits than needed
+may occasionally be written.
+
+=head1 SEE ALSO
+
+L<perlop/"Floating-point Arithmetic">, L<perlfunc/sprintf>
+
+=cut
+
+$roundtrip::hint_bits = 0x20000000;
+
+sub import {
+    $^H |= $roundtrip::hint_bits;
+}
+
+sub unimport {
+    $^H &= ~$roundtrip::hint_bits;
+}
+
+1;
@@ -0,0 +1,69 @@
+#!./perl
+
+BEGIN {
+    chdir 't' if -d 't';
+    @INC = '../lib';
+}
+
+use Test::More tests => 17;
+use Config;
+
+my $sum = 0.1 + 0.2;
+my $third = 1 / 3;
+
+is("$sum", "0.3", "numbers stringify with %.15g by default");
+
+SKIP: {
+    skip "needs 64-bit doubles", 13
+        unless $Config{nvsize} == 8 && $Config{d_strtod};
+
+    {
+        use roundtrip;
+        is("$sum", "0.30000000000000004", "use roundtrip adds digits");
+        is("$third", "0.3333333333333333", "... only as many as needed");
+        is(0.1 . "", "0.1", "... and none to numbers that read back");
+        is(join(",", 1e23, -2.5, 1e-30), "1e+23,-2.5,1e-30",
+           "... nor with exponents");
+        is(1e-7 / 3 . "", "3.3333333333333334e-08", "... or small numbers");
+        is(unpack("d", pack "d", "7.581454333883296e-148") . "",
+           "7.581454333883296e-148", "... or tiny ones");
+        is(2 ** 40 - 2 ** -12 . "", "1099511627775.9998",
+           "... or those just below a power of two");
+        is(0.1 * 3 . "", "0.30000000000000004",
+           "... or those just above one");
+        is(sprintf("%g", $sum), "0.3", "sprintf is not affected");
+
+        no roundtrip;
+        is("$sum", "0.3", "no roundtrip");
+    }
+
+    is("$sum", "0.3", "the pragma is lexical");
+
+    my ($bad, $long) = (0, 0);
+    {
+        use roundtrip;
+        srand(42);
+        for (1 .. 2000) {
+            my $nv = $_ % 2 ? rand(10) ** (rand(30) - 15)
+                            : rand() * 10 ** (int(rand 600) - 300);
+            my $str = "$nv";
+            $bad++ unless $str + 0 == $nv;
+            my ($shortest) = grep { $_ + 0 == $nv }
+                             map { sprintf "%.*g", $_, $nv } 15 .. 17;
+            $long++ if length($str) > length($shortest);
+        }
+    }
+    is($bad, 0, "random numbers read back exactly");
+    is($long, 0, "... and are as short as they can be");
+}
+
+sub outside { "$_[0]" }
+{
+    use roundtrip;
+    is(outside($sum), "0.3", "a sub compiled outside the pragma is not affected");
+    is(eval q{"$third"}, $Config{nvsize} == 8 && $Config{d_strtod}
+                       ? "0.3333333333333333" : "0.333333333333333",
+       "string eval inherits the pragma");
+}
+
+is(eval q{ no roundtrip; "$third" }, "0.333333333333333", "no roundtrip in eval");
@@ -2503,6 +2503,14 @@ Perl_magic_setutf8(pTHX_ SV *sv, MAGIC *mg)
     return 0;
 }
 
+/* The string changed, so the index study() built for it is useless now */
+int
+Perl_magic_setstudy(pTHX_ SV *sv, MAGIC *mg)
+{
+    PERL_ARGS_ASSERT_MAGIC_SETSTUDY;
+    return sv_unmagic(sv, mg->mg_type);
+}
+
 int
 Perl_magic_setlvref(pTHX_ SV *sv, MAGIC *mg)
 {
@@ -36,6 +36,8 @@
       "/* envelem 'e' %ENV hash element */" },
     { 'f', "want_vtbl_regexp | PERL_MAGIC_READONLY_ACCEPTABLE | PERL_MAGIC_VALUE_MAGIC",
       "/* fm 'f' Formline ('compiled' format) */" },
+    { 'G', "want_vtbl_study | PERL_MAGIC_VALUE_MAGIC",
+      "/* study 'G' study()ed string index */" },
     { 'g', "want_vtbl_mglob | PERL_MAGIC_READONLY_ACCEPTABLE | PERL_MAGIC_VALUE_MAGIC",
       "/* regex_global 'g' m//g target */" },
     { 'H', "want_vtbl_hints",
@@ -28,6 +28,7 @@
 #define PERL_MAGIC_env            'E' /* %ENV hash */
 #define PERL_MAGIC_envelem        'e' /* %ENV hash element */
 #define PERL_MAGIC_fm             'f' /* Formline ('compiled' format) */
+#define PERL_MAGIC_study          'G' /* study()ed string index */
 #define PERL_MAGIC_regex_global   'g' /* m//g target */
 #define PERL_MAGIC_hints          'H' /* %^H hash */
 #define PERL_MAGIC_hintselem      'h' /* %^H hash element */
@@ -84,6 +85,7 @@ enum {		/* pass one of these to get_vtbl */
     want_vtbl_regdatum,
     want_vtbl_regexp,
     want_vtbl_sigelem,
+    want_vtbl_study,
     want_vtbl_substr,
     want_vtbl_sv,
     want_vtbl_taint,
@@ -120,6 +122,7 @@ EXTCONST char * const PL_magic_vtable_names[magic_vtable_max] = {
     "regdatum",
     "regexp",
     "sigelem",
+    "study",
     "substr",
     "sv",
     "taint",
@@ -183,6 +186,7 @@ EXT_MGVTBL PL_magic_vtables[magic_vtable_max] = {
 #else
   { 0, 0, 0, 0, 0, 0, 0, 0 },
 #endif
+  { 0, Perl_magic_setstudy, 0, 0, 0, 0, 0, 0 },
   { Perl_magic_getsubstr, Perl_magic_setsubstr, 0, 0, 0, 0, 0, 0 },
   { Perl_magic_get, Perl_magic_set, 0, 0, 0, 0, 0, 0 },
   { Perl_magic_gettaint, Perl_magic_settaint, 0, 0, 0, 0, 0, 0 },
@@ -224,6 +228,7 @@ EXT_MGVTBL PL_magic_vtables[magic_vtable_max];
 #define PL_vtbl_regdatum PL_magic_vtables[want_vtbl_regdatum]
 #define PL_vtbl_regexp PL_magic_vtables[want_vtbl_regexp]
 #define PL_vtbl_sigelem PL_magic_vtables[want_vtbl_sigelem]
+#define PL_vtbl_study PL_magic_vtables[want_vtbl_study]
 #define PL_vtbl_substr PL_magic_vtables[want_vtbl_substr]
 #define PL_vtbl_sv PL_magic_vtables[want_vtbl_sv]
 #define PL_vtbl_taint PL_magic_vtables[want_vtbl_taint]
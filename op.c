@@ -857,6 +857,7 @@ Perl_op_clear(pTHX_ OP *o)
         /* FALLTHROUGH */
     case OP_ENTERTRY:
     case OP_ENTEREVAL:	/* Was holding hints. */
+    case OP_SORT:	/* Was holding the OPpSORT_LIMIT limit. */
 	o->op_targ = 0;
 	break;
     default:
@@ -10955,6 +10956,96 @@ Perl_ck_sort(pTHX_ OP *o)
     return o;
 }
 
+/* Is o the package variable $a (var == 'a') or $b in the current
+ * package? */
+
+STATIC bool
+S_is_sort_var(pTHX_ const OP *o, char var)
+{
+    const char *name;
+    GV *gv;
+
+    if (o->op_type != OP_RV2SV || cUNOPx(o)->op_first->op_type != OP_GV)
+	return FALSE;
+    gv = cGVOPx_gv(cUNOPx(o)->op_first);
+    if (GvSTASH(gv) != PL_curstash)
+	return FALSE;
+    name = GvNAME(gv);
+    return name[0] == var && name[1] == '\0';
+}
+
+/* Are the expressions x and y the same apart from x using $a where y
+ * uses $b, or vice versa?  They must only be made of ops which have no
+ * side effects and don't branch, so that the expression can be run
+ * once per element of a sort to get its key. *seen counts the uses of
+ * $a or $b. */
+
+STATIC bool
+S_sort_key_same(pTHX_ const OP *x, const OP *y, char xvar, char yvar,
+		int *seen)
+{
+    if (S_is_sort_var(aTHX_ x, xvar)) {
+	++*seen;
+	return S_is_sort_var(aTHX_ y, yvar) && x->op_flags == y->op_flags
+	    && x->op_private == y->op_private;
+    }
+    if (x->op_type != y->op_type || x->op_flags != y->op_flags
+     || x->op_private != y->op_private)
+	return FALSE;
+
+    switch (x->op_type) {
+    case OP_GV:
+	return cGVOPx_gv(x) == cGVOPx_gv(y)
+	    && !(GvSTASH(cGVOPx_gv(x)) == PL_curstash
+		 && (   strEQ(GvNAME(cGVOPx_gv(x)), "a")
+		     || strEQ(GvNAME(cGVOPx_gv(x)), "b")));
+    case OP_CONST: {
+	SV * const xsv = cSVOPx_sv(x);
+	SV * const ysv = cSVOPx_sv(y);
+	const U32 mask = SVf_IOK|SVf_NOK|SVf_POK|SVf_UTF8|SVf_ROK;
+	if ((SvFLAGS(xsv) & mask) != (SvFLAGS(ysv) & mask) || SvROK(xsv)
+	 || SvMAGICAL(xsv) || SvMAGICAL(ysv))
+	    return FALSE;
+	if (SvPOK(xsv))
+	    return SvCUR(xsv) == SvCUR(ysv)
+		&& memEQ(SvPVX_const(xsv), SvPVX_const(ysv), SvCUR(xsv));
+	if (SvIOK(xsv))
+	    return SvIVX(xsv) == SvIVX(ysv);
+	if (SvNOK(xsv))
+	    return SvNVX(xsv) == SvNVX(ysv);
+	return FALSE;
+    }
+    case OP_PADSV:
+    case OP_PADAV:
+    case OP_PADHV:
+	return x->op_targ == y->op_targ && !(x->op_private & OPpLVAL_INTRO);
+    case OP_NULL:
+    case OP_RV2SV:
+    case OP_RV2AV:
+    case OP_RV2HV:
+    case OP_HELEM:
+    case OP_AELEM:
+    case OP_LC:
+    case OP_UC:
+    case OP_FC:
+    case OP_LENGTH:
+	break;
+    default:
+	return FALSE;
+    }
+
+    if (x->op_flags & OPf_KIDS) {
+	const OP *xkid = cUNOPx(x)->op_first;
+	const OP *ykid = cUNOPx(y)->op_first;
+	for (; xkid && ykid; xkid = OpSIBLING(xkid), ykid = OpSIBLING(ykid))
+	    if (!S_sort_key_same(aTHX_ xkid, ykid, xvar, yvar, seen))
+		return FALSE;
+	if (xkid || ykid)
+	    return FALSE;
+    }
+    return TRUE;
+}
+
 /* for sort { X } ..., where X is one of
  *   $a <=> $b, $b <= $a, $a cmp $b, $b cmp $a
  * elide the second child of the sort (the one containing X),
@@ -10995,6 +11086,26 @@ S_simplify_sort(pTHX_ OP *o)
     if (kBINOP->op_first->op_type != OP_RV2SV
      || kBINOP->op_last ->op_type != OP_RV2SV)
     {
+	/* sort { $h{$a} <=> $h{$b} }, sort { lc $b cmp lc $a } etc.
+	 * compare a key computed from each of $a and $b the same way,
+	 * so pp_sort can compute each element's key just once */
+	if (have_scopeop) {
+	    int seen = 0;
+	    if (S_sort_key_same(aTHX_ kBINOP->op_first, kBINOP->op_last,
+				'a', 'b', &seen) && seen)
+	    {
+		k->op_private |= OPpCMP_SORTKEY;
+		return;
+	    }
+	    seen = 0;
+	    if (S_sort_key_same(aTHX_ kBINOP->op_first, kBINOP->op_last,
+				'b', 'a', &seen) && seen)
+	    {
+		k->op_private |= OPpCMP_SORTKEY|OPpCMP_KEYDESC;
+		return;
+	    }
+	}
+
 	/*
 	   Warn about my($a) or my($b) in a sort block, *if* $a or $b is
 	   then used in a comparison.  This catches most, but not
@@ -12796,6 +12907,65 @@ S_maybe_multideref(pTHX_ OP *start, OP *orig_o, UV orig_action, U8 hints)
 
 
 
+/* Return the sort op if the ex-list o contains nothing but a sort
+ * whose result could be cut short, else NULL. */
+
+STATIC OP *
+S_sort_only_kid(const OP *o)
+{
+    OP *kid;
+
+    if (o->op_type != OP_NULL || !(o->op_flags & OPf_KIDS))
+	return NULL;
+    kid = OpSIBLING(cLISTOPx(o)->op_first);
+    if (!kid || kid->op_type != OP_SORT || OpHAS_SIBLING(kid)
+     || (kid->op_private & (OPpSORT_INPLACE|OPpSORT_REVERSE|OPpSORT_LIMIT)))
+	return NULL;
+    return kid;
+}
+
+/* For (sort ...)[LIST] where LIST is all non-negative integer
+ * constants, return one more than the largest index, else 0.  A folded
+ * range shows up as an rv2av of a constant array. */
+
+STATIC SSize_t
+S_lslice_const_limit(pTHX_ const OP *o)
+{
+    SSize_t max = -1;
+    const OP *kid;
+
+    for (kid = OpSIBLING(cLISTOPx(o)->op_first); kid; kid = OpSIBLING(kid)) {
+	SV **svp, **end;
+
+	if (kid->op_type == OP_CONST) {
+	    svp = cSVOPx_svp(kid);
+	    end = svp + 1;
+	}
+	else if (kid->op_type == OP_RV2AV
+	      && cUNOPx(kid)->op_first->op_type == OP_CONST
+	      && SvTYPE(cSVOPx_sv(cUNOPx(kid)->op_first)) == SVt_PVAV)
+	{
+	    AV * const av = MUTABLE_AV(cSVOPx_sv(cUNOPx(kid)->op_first));
+	    if (SvMAGICAL(av))
+		return 0;
+	    svp = AvARRAY(av);
+	    end = svp + AvFILLp(av) + 1;
+	}
+	else
+	    return 0;
+
+	for (; svp < end; svp++) {
+	    SV * const sv = *svp;
+	    if (!sv || SvGMAGICAL(sv) || !SvIOK(sv) || SvIsUV(sv)
+	     || SvIVX(sv) < 0 || SvIVX(sv) >= (IV)(SSize_t_MAX / 2))
+		return 0;
+	    if (SvIVX(sv) > max)
+		max = SvIVX(sv);
+	}
+    }
+    return max + 1;
+}
+
 /* mechanism for deferring recursion in rpeep() */
 
 #define MAX_DEFERRED 4
@@ -13749,6 +13919,24 @@ Perl_rpeep(pTHX_ OP *o)
                 DEFER(nullop->op_next);
 	    }
 
+	    /* (sort ...)[0..9]: only the first few elements are used, so
+	     * tell pp_sort how many it needs to get right */
+	    {
+		OP *lslice = o->op_next;
+		while (lslice && lslice->op_type == OP_NULL)
+		    lslice = lslice->op_next;
+		if (lslice && lslice->op_type == OP_LSLICE
+		 && S_sort_only_kid(cBINOPx(lslice)->op_last) == o)
+		{
+		    const SSize_t limit =
+			S_lslice_const_limit(aTHX_ cBINOPx(lslice)->op_first);
+		    if (limit) {
+			o->op_private |= OPpSORT_LIMIT;
+			o->op_targ = limit;
+		    }
+		}
+	    }
+
 	    /* check that RHS of sort is a single plain array */
 	    oright = cUNOPo->op_first;
 	    if (!oright || oright->op_type != OP_PUSHMARK)
@@ -13776,6 +13964,28 @@ Perl_rpeep(pTHX_ OP *o)
 		}
 	    }
 
+	    /* sort keys %h: take the keys op out of the execution chain,
+	     * leaving the hash itself on the stack, so that pp_sort can
+	     * sort the hash's keys without making an SV for each first */
+	    if (!(o->op_flags & OPf_STACKED)
+	     && (o->op_flags & OPf_WANT) == OPf_WANT_LIST
+	     && !(o->op_private & OPpSORT_NUMERIC))
+	    {
+		OP * const keys = OpSIBLING(cLISTOPo->op_first);
+		OP *hv;
+
+		if (!keys || keys->op_type != OP_KEYS || OpHAS_SIBLING(keys)
+		 || keys->op_next != o || !(keys->op_flags & OPf_KIDS))
+		    break;
+		hv = cUNOPx(keys)->op_first;
+		if ((hv->op_type == OP_RV2HV || hv->op_type == OP_PADHV)
+		 && (hv->op_flags & OPf_REF) && hv->op_next == keys)
+		{
+		    hv->op_next = o;
+		    op_null(keys);
+		}
+	    }
+
 	    break;
 	}
 
@@ -13871,6 +14081,38 @@ Perl_rpeep(pTHX_ OP *o)
 	    break;
 	}
 
+	case OP_SPRINTF:
+	case OP_PRTF: {
+	    /* a constant format made only of simple directives is compiled
+	     * now, and the steps run by sv_catpvfn_fast() instead of the
+	     * general formatter.  They live in a constant pad slot, whose
+	     * index is kept in the targ of the pushmark, which has no other
+	     * use for it. */
+	    OP * const pushmark = cLISTOPo->op_first;
+	    OP *kid;
+	    if (pushmark->op_type != OP_PUSHMARK || pushmark->op_targ)
+		break;
+	    kid = OpSIBLING(pushmark);
+	    if (kid && o->op_type == OP_PRTF && (o->op_flags & OPf_STACKED))
+		kid = OpSIBLING(kid);                 /* skip filehandle */
+	    if (kid && kid->op_type == OP_CONST) {
+		SV * const fmt = cSVOPx_sv(kid);
+		SV *steps;
+		if (fmt && SvPOK(fmt) && !SvUTF8(fmt) && !SvMAGICAL(fmt)
+		 && (steps = sv_fast_format_compile(SvPVX_const(fmt),
+						    SvCUR(fmt))))
+		{
+		    const PADOFFSET ix = pad_alloc(OP_CONST, SVf_READONLY);
+		    SvREFCNT_dec(PAD_SVl(ix));
+		    PAD_SETSV(ix, steps);
+		    SvREADONLY_on(steps);
+		    pushmark->op_targ = ix;
+		    o->op_private |= OPpFORMAT_FAST;
+		}
+	    }
+	    break;
+	}
+
 	case OP_QR:
 	case OP_MATCH:
 	    if (!(cPMOP->op_pmflags & PMf_ONCE)) {
@@ -13959,6 +14201,31 @@ Perl_rpeep(pTHX_ OP *o)
 	    }
 	    else if (S_aassign_common_vars_aliases_only(aTHX_ o))
 		o->op_private |= OPpASSIGN_COMMON;
+
+	    /* my ($min) = sort ...: in void context only as many elements
+	     * as there are scalars on the left are used */
+	    if ((o->op_flags & OPf_WANT) == OPf_WANT_VOID) {
+		OP * const sortop = S_sort_only_kid(cBINOPo->op_first);
+		SSize_t limit = 0;
+		OP *kid;
+
+		if (!sortop)
+		    break;
+		for (kid = OpSIBLING(cLISTOPx(cBINOPo->op_last)->op_first);
+		     kid; kid = OpSIBLING(kid))
+		{
+		    if (kid->op_type == OP_PADSV || kid->op_type == OP_RV2SV
+		     || kid->op_type == OP_UNDEF
+		     || (kid->op_type == OP_NULL && kid->op_targ == OP_RV2SV))
+			limit++;
+		    else
+			break;
+		}
+		if (limit && !kid) {
+		    sortop->op_private |= OPpSORT_LIMIT;
+		    sortop->op_targ = limit;
+		}
+	    }
 	    break;
 
 	case OP_CUSTOM: {
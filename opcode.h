@@ -546,6 +546,7 @@ EXTCONST char* const PL_op_name[] = {
 	"lvrefslice",
 	"lvavref",
 	"anonconst",
+	"popcount",
 	"freed",
 };
 #endif
@@ -950,6 +951,7 @@ EXTCONST char* const PL_op_desc[] = {
 	"lvalue ref assignment",
 	"lvalue array reference",
 	"anonymous constant",
+	"popcount",
 	"freed op",
 };
 #endif
@@ -1368,6 +1370,7 @@ EXT Perl_ppaddr_t PL_ppaddr[] /* or perlvars.h */
 	Perl_pp_lvrefslice,
 	Perl_pp_lvavref,
 	Perl_pp_anonconst,
+	Perl_pp_popcount,
 }
 #endif
 #ifdef PERL_PPADDR_INITED
@@ -1782,6 +1785,7 @@ EXT Perl_check_t PL_check[] /* or perlvars.h */
 	Perl_ck_null,		/* lvrefslice */
 	Perl_ck_null,		/* lvavref */
 	Perl_ck_null,		/* anonconst */
+	Perl_ck_fun,		/* popcount */
 }
 #endif
 #ifdef PERL_CHECK_INITED
@@ -2190,6 +2194,7 @@ EXTCONST U32 PL_opargs[] = {
 	0x00000440,	/* lvrefslice */
 	0x00000b40,	/* lvavref */
 	0x00000144,	/* anonconst */
+	0x0099141e,	/* popcount */
 };
 #endif
 
@@ -2239,6 +2244,7 @@ END_EXTERN_C
 #define OPpCONST_ENTERED        0x10
 #define OPpDEREF_AV             0x10
 #define OPpEVAL_COPHH           0x10
+#define OPpFORMAT_FAST          0x10
 #define OPpFT_AFTER_t           0x10
 #define OPpLVREF_AV             0x10
 #define OPpMAYBE_TRUEBOOL       0x10
@@ -2265,6 +2271,7 @@ END_EXTERN_C
 #define OPpALLOW_FAKE           0x40
 #define OPpASSIGN_BACKWARDS     0x40
 #define OPpASSIGN_COMMON        0x40
+#define OPpCMP_KEYDESC          0x40
 #define OPpCONST_BARE           0x40
 #define OPpCOREARGS_SCALARMOD   0x40
 #define OPpENTERSUB_DB          0x40
@@ -2283,6 +2290,7 @@ END_EXTERN_C
 #define OPpTRANS_GROWS          0x40
 #define OPpPADRANGE_COUNTMASK   0x7f
 #define OPpASSIGN_CV_TO_GV      0x80
+#define OPpCMP_SORTKEY          0x80
 #define OPpCOREARGS_PUSHMARK    0x80
 #define OPpENTERSUB_NOPAREN     0x80
 #define OPpLVALUE               0x80
@@ -2290,6 +2298,7 @@ END_EXTERN_C
 #define OPpOFFBYONE             0x80
 #define OPpOPEN_OUT_CRLF        0x80
 #define OPpPV_IS_UTF8           0x80
+#define OPpSORT_LIMIT           0x80
 #define OPpSPLIT_IMPLIM         0x80
 #define OPpTRANS_DELETE         0x80
 START_EXTERN_C
@@ -2349,6 +2358,7 @@ EXTCONST char PL_op_private_labels[] = {
     'E','N','T','E','R','E','D','\0',
     'E','X','I','S','T','S','\0',
     'F','A','K','E','\0',
+    'F','A','S','T','F','M','T','\0',
     'F','T','A','C','C','E','S','S','\0',
     'F','T','A','F','T','E','R','t','\0',
     'F','T','S','T','A','C','K','E','D','\0',
@@ -2367,6 +2377,8 @@ EXTCONST char PL_op_private_labels[] = {
     'I','N','P','L','A','C','E','\0',
     'I','N','T','\0',
     'I','T','E','R','\0',
+    'K','E','Y','D','E','S','C','\0',
+    'L','I','M','I','T','\0',
     'L','I','N','E','N','U','M','\0',
     'L','V','\0',
     'L','V','D','E','F','E','R','\0',
@@ -2390,6 +2402,7 @@ EXTCONST char PL_op_private_labels[] = {
     'S','H','O','R','T','\0',
     'S','L','I','C','E','\0',
     'S','L','I','C','E','W','A','R','N','\0',
+    'S','O','R','T','K','E','Y','\0',
     'S','Q','U','A','S','H','\0',
     'S','T','A','B','L','E','\0',
     'S','T','A','T','E','\0',
@@ -2423,7 +2436,7 @@ EXTCONST I16 PL_op_private_bitfields[] = {
     0, 8, -1,
     0, 8, -1,
     4, -1, 1, 137, 2, 144, 3, 151, -1,
-    4, -1, 0, 495, 1, 26, 2, 264, 3, 83, -1,
+    4, -1, 0, 525, 1, 26, 2, 272, 3, 83, -1,
 
 };
 
@@ -2515,15 +2528,15 @@ EXTCONST I16  PL_op_private_bitdef_ix[] = {
       12, /* i_eq */
       12, /* ne */
       12, /* i_ne */
-      12, /* ncmp */
-      74, /* i_ncmp */
+      81, /* ncmp */
+      84, /* i_ncmp */
       12, /* slt */
       12, /* sgt */
       12, /* sle */
       12, /* sge */
       12, /* seq */
       12, /* sne */
-      74, /* scmp */
+      84, /* scmp */
       12, /* bit_and */
       12, /* bit_xor */
       12, /* bit_or */
@@ -2553,11 +2566,11 @@ EXTCONST I16  PL_op_private_bitdef_ix[] = {
       72, /* oct */
       72, /* abs */
       72, /* length */
-      81, /* substr */
-      84, /* vec */
+      88, /* substr */
+      91, /* vec */
       79, /* index */
       79, /* rindex */
-      48, /* sprintf */
+      94, /* sprintf */
       48, /* formline */
       72, /* ord */
       72, /* chr */
@@ -2567,30 +2580,30 @@ EXTCONST I16  PL_op_private_bitdef_ix[] = {
        0, /* uc */
        0, /* lc */
        0, /* quotemeta */
-      87, /* rv2av */
-      93, /* aelemfast */
-      93, /* aelemfast_lex */
-      94, /* aelem */
-      99, /* aslice */
-     102, /* kvaslice */
+      96, /* rv2av */
+     102, /* aelemfast */
+     102, /* aelemfast_lex */
+     103, /* aelem */
+     108, /* aslice */
+     111, /* kvaslice */
        0, /* aeach */
        0, /* akeys */
        0, /* avalues */
        0, /* each */
        0, /* values */
       39, /* keys */
-     103, /* delete */
-     106, /* exists */
-     108, /* rv2hv */
-      94, /* helem */
-      99, /* hslice */
-     102, /* kvhslice */
-     116, /* multideref */
+     112, /* delete */
+     115, /* exists */
+     117, /* rv2hv */
+     103, /* helem */
+     108, /* hslice */
+     111, /* kvhslice */
+     125, /* multideref */
       48, /* unpack */
       48, /* pack */
-     123, /* split */
+     132, /* split */
       48, /* join */
-     126, /* list */
+     135, /* list */
       12, /* lslice */
       48, /* anonlist */
       48, /* anonhash */
@@ -2599,48 +2612,48 @@ EXTCONST I16  PL_op_private_bitdef_ix[] = {
        0, /* pop */
        0, /* shift */
       79, /* unshift */
-     128, /* sort */
-     135, /* reverse */
-     137, /* grepstart */
-     137, /* grepwhile */
-     137, /* mapstart */
-     137, /* mapwhile */
+     137, /* sort */
+     145, /* reverse */
+     147, /* grepstart */
+     147, /* grepwhile */
+     147, /* mapstart */
+     147, /* mapwhile */
        0, /* range */
-     139, /* flip */
-     139, /* flop */
+     149, /* flip */
+     149, /* flop */
        0, /* and */
        0, /* or */
       12, /* xor */
        0, /* dor */
-     141, /* cond_expr */
+     151, /* cond_expr */
        0, /* andassign */
        0, /* orassign */
        0, /* dorassign */
        0, /* method */
-     143, /* entersub */
-     150, /* leavesub */
-     150, /* leavesublv */
-     152, /* caller */
+     153, /* entersub */
+     160, /* leavesub */
+     160, /* leavesublv */
+     162, /* caller */
       48, /* warn */
       48, /* die */
       48, /* reset */
       -1, /* lineseq */
-     154, /* nextstate */
-     154, /* dbstate */
+     164, /* nextstate */
+     164, /* dbstate */
       -1, /* unstack */
       -1, /* enter */
-     155, /* leave */
+     165, /* leave */
       -1, /* scope */
-     157, /* enteriter */
-     161, /* iter */
+     167, /* enteriter */
+     171, /* iter */
       -1, /* enterloop */
-     162, /* leaveloop */
+     172, /* leaveloop */
       -1, /* return */
-     164, /* last */
-     164, /* next */
-     164, /* redo */
-     164, /* dump */
-     164, /* goto */
+     174, /* last */
+     174, /* next */
+     174, /* redo */
+     174, /* dump */
+     174, /* goto */
       48, /* exit */
        0, /* method_named */
        0, /* method_super */
@@ -2652,7 +2665,7 @@ EXTCONST I16  PL_op_private_bitdef_ix[] = {
        0, /* leavewhen */
       -1, /* break */
       -1, /* continue */
-     166, /* open */
+     176, /* open */
       48, /* close */
       48, /* pipe_op */
       48, /* fileno */
@@ -2668,8 +2681,8 @@ EXTCONST I16  PL_op_private_bitdef_ix[] = {
       48, /* getc */
       48, /* read */
       48, /* enterwrite */
-     150, /* leavewrite */
-      -1, /* prtf */
+     160, /* leavewrite */
+     181, /* prtf */
       -1, /* print */
       -1, /* say */
       48, /* sysopen */
@@ -2698,33 +2711,33 @@ EXTCONST I16  PL_op_private_bitdef_ix[] = {
        0, /* getpeername */
        0, /* lstat */
        0, /* stat */
-     171, /* ftrread */
-     171, /* ftrwrite */
-     171, /* ftrexec */
-     171, /* fteread */
-     171, /* ftewrite */
-     171, /* fteexec */
-     176, /* ftis */
-     176, /* ftsize */
-     176, /* ftmtime */
-     176, /* ftatime */
-     176, /* ftctime */
-     176, /* ftrowned */
-     176, /* fteowned */
-     176, /* ftzero */
-     176, /* ftsock */
-     176, /* ftchr */
-     176, /* ftblk */
-     176, /* ftfile */
-     176, /* ftdir */
-     176, /* ftpipe */
-     176, /* ftsuid */
-     176, /* ftsgid */
-     176, /* ftsvtx */
-     176, /* ftlink */
-     176, /* fttty */
-     176, /* fttext */
-     176, /* ftbinary */
+     182, /* ftrread */
+     182, /* ftrwrite */
+     182, /* ftrexec */
+     182, /* fteread */
+     182, /* ftewrite */
+     182, /* fteexec */
+     187, /* ftis */
+     187, /* ftsize */
+     187, /* ftmtime */
+     187, /* ftatime */
+     187, /* ftctime */
+     187, /* ftrowned */
+     187, /* fteowned */
+     187, /* ftzero */
+     187, /* ftsock */
+     187, /* ftchr */
+     187, /* ftblk */
+     187, /* ftfile */
+     187, /* ftdir */
+     187, /* ftpipe */
+     187, /* ftsuid */
+     187, /* ftsgid */
+     187, /* ftsvtx */
+     187, /* ftlink */
+     187, /* fttty */
+     187, /* fttext */
+     187, /* ftbinary */
       79, /* chdir */
       79, /* chown */
       72, /* chroot */
@@ -2744,17 +2757,17 @@ EXTCONST I16  PL_op_private_bitdef_ix[] = {
        0, /* rewinddir */
        0, /* closedir */
       -1, /* fork */
-     180, /* wait */
+     191, /* wait */
       79, /* waitpid */
       79, /* system */
       79, /* exec */
       79, /* kill */
-     180, /* getppid */
+     191, /* getppid */
       79, /* getpgrp */
       79, /* setpgrp */
       79, /* getpriority */
       79, /* setpriority */
-     180, /* time */
+     191, /* time */
       -1, /* tms */
        0, /* localtime */
       48, /* gmtime */
@@ -2774,8 +2787,8 @@ EXTCONST I16  PL_op_private_bitdef_ix[] = {
        0, /* require */
        0, /* dofile */
       -1, /* hintseval */
-     181, /* entereval */
-     150, /* leaveeval */
+     192, /* entereval */
+     160, /* leaveeval */
        0, /* entertry */
       -1, /* leavetry */
        0, /* ghbyname */
@@ -2816,18 +2829,19 @@ EXTCONST I16  PL_op_private_bitdef_ix[] = {
        0, /* reach */
       39, /* rkeys */
        0, /* rvalues */
-     187, /* coreargs */
+     198, /* coreargs */
        3, /* runcv */
        0, /* fc */
       -1, /* padcv */
       -1, /* introcv */
       -1, /* clonecv */
-     191, /* padrange */
-     193, /* refassign */
-     199, /* lvref */
-     205, /* lvrefslice */
-     206, /* lvavref */
+     202, /* padrange */
+     204, /* refassign */
+     210, /* lvref */
+     216, /* lvrefslice */
+     217, /* lvavref */
        0, /* anonconst */
+      79, /* popcount */
 
 };
 
@@ -2847,69 +2861,73 @@ EXTCONST I16  PL_op_private_bitdef_ix[] = {
 
 EXTCONST U16  PL_op_private_bitdefs[] = {
     0x0003, /* scalar, prototype, refgen, srefgen, ref, readline, regcmaybe, regcreset, regcomp, chop, schop, defined, undef, study, preinc, i_preinc, predec, i_predec, postinc, i_postinc, postdec, i_postdec, negate, i_negate, not, ucfirst, lcfirst, uc, lc, quotemeta, aeach, akeys, avalues, each, values, pop, shift, range, and, or, dor, andassign, orassign, dorassign, method, method_named, method_super, method_redir, method_redir_super, entergiven, leavegiven, enterwhen, leavewhen, untie, tied, dbmclose, getsockname, getpeername, lstat, stat, readlink, readdir, telldir, rewinddir, closedir, localtime, alarm, require, dofile, entertry, ghbyname, gnbyname, gpbyname, shostent, snetent, sprotoent, sservent, gpwnam, gpwuid, ggrnam, ggrgid, lock, once, reach, rvalues, fc, anonconst */
-    0x29dc, 0x3bd9, /* pushmark */
+    0x2c9c, 0x3f99, /* pushmark */
     0x00bd, /* wantarray, runcv */
-    0x03b8, 0x1570, 0x3c8c, 0x3748, 0x2da5, /* const */
-    0x29dc, 0x2ef9, /* gvsv */
+    0x03b8, 0x1570, 0x404c, 0x3a08, 0x3065, /* const */
+    0x2c9c, 0x31b9, /* gvsv */
     0x13d5, /* gv */
-    0x0067, /* gelem, lt, i_lt, gt, i_gt, le, i_le, ge, i_ge, eq, i_eq, ne, i_ne, ncmp, slt, sgt, sle, sge, seq, sne, bit_and, bit_xor, bit_or, sbit_and, sbit_xor, sbit_or, smartmatch, lslice, xor */
-    0x29dc, 0x3bd8, 0x0257, /* padsv */
-    0x29dc, 0x3bd8, 0x2acc, 0x38c9, /* padav */
-    0x29dc, 0x3bd8, 0x0534, 0x05d0, 0x2acc, 0x38c9, /* padhv */
-    0x3699, /* pushre, qr */
-    0x29dc, 0x1758, 0x0256, 0x2acc, 0x2cc8, 0x3c84, 0x0003, /* rv2gv */
-    0x29dc, 0x2ef8, 0x0256, 0x3c84, 0x0003, /* rv2sv */
-    0x2acc, 0x0003, /* av2arylen, pos, keys, rkeys */
-    0x2c3c, 0x0b98, 0x08f4, 0x028c, 0x3e48, 0x3c84, 0x0003, /* rv2cv */
-    0x012f, /* bless, glob, sprintf, formline, unpack, pack, join, anonlist, anonhash, splice, warn, die, reset, exit, close, pipe_op, fileno, umask, binmode, tie, dbmopen, sselect, select, getc, read, enterwrite, sysopen, sysseek, sysread, syswrite, eof, tell, seek, truncate, fcntl, ioctl, send, recv, socket, sockpair, bind, connect, listen, accept, shutdown, gsockopt, ssockopt, open_dir, seekdir, gmtime, shmget, shmctl, shmread, shmwrite, msgget, msgctl, msgsnd, msgrcv, semop, semget, semctl, ghbyaddr, gnbyaddr, gpbynumber, gsbyname, gsbyport, syscall */
-    0x30dc, 0x2ff8, 0x24b4, 0x23f0, 0x0003, /* backtick */
-    0x3698, 0x3ef1, /* match, subst */
-    0x3698, 0x0003, /* substcont */
-    0x0c9c, 0x1dd8, 0x0834, 0x3ef0, 0x3a0c, 0x2168, 0x01e4, 0x0141, /* trans, transr */
+    0x0067, /* gelem, lt, i_lt, gt, i_gt, le, i_le, ge, i_ge, eq, i_eq, ne, i_ne, slt, sgt, sle, sge, seq, sne, bit_and, bit_xor, bit_or, sbit_and, sbit_xor, sbit_or, smartmatch, lslice, xor */
+    0x2c9c, 0x3f98, 0x0257, /* padsv */
+    0x2c9c, 0x3f98, 0x2d8c, 0x3b89, /* padav */
+    0x2c9c, 0x3f98, 0x0534, 0x05d0, 0x2d8c, 0x3b89, /* padhv */
+    0x3959, /* pushre, qr */
+    0x2c9c, 0x1758, 0x0256, 0x2d8c, 0x2f88, 0x4044, 0x0003, /* rv2gv */
+    0x2c9c, 0x31b8, 0x0256, 0x4044, 0x0003, /* rv2sv */
+    0x2d8c, 0x0003, /* av2arylen, pos, keys, rkeys */
+    0x2efc, 0x0b98, 0x08f4, 0x028c, 0x4208, 0x4044, 0x0003, /* rv2cv */
+    0x012f, /* bless, glob, formline, unpack, pack, join, anonlist, anonhash, splice, warn, die, reset, exit, close, pipe_op, fileno, umask, binmode, tie, dbmopen, sselect, select, getc, read, enterwrite, sysopen, sysseek, sysread, syswrite, eof, tell, seek, truncate, fcntl, ioctl, send, recv, socket, sockpair, bind, connect, listen, accept, shutdown, gsockopt, ssockopt, open_dir, seekdir, gmtime, shmget, shmctl, shmread, shmwrite, msgget, msgctl, msgsnd, msgrcv, semop, semget, semctl, ghbyaddr, gnbyaddr, gpbynumber, gsbyname, gsbyport, syscall */
+    0x339c, 0x32b8, 0x25b4, 0x24f0, 0x0003, /* backtick */
+    0x3958, 0x42b1, /* match, subst */
+    0x3958, 0x0003, /* substcont */
+    0x0c9c, 0x1ed8, 0x0834, 0x42b0, 0x3dcc, 0x2268, 0x01e4, 0x0141, /* trans, transr */
     0x0adc, 0x0458, 0x0067, /* sassign */
-    0x0758, 0x2acc, 0x0067, /* aassign */
-    0x3ef0, 0x0003, /* chomp, schomp, complement, ncomplement, scomplement, sin, cos, exp, log, sqrt, int, hex, oct, abs, length, ord, chr, chroot, rmdir */
-    0x3ef0, 0x0067, /* pow, multiply, i_multiply, divide, i_divide, modulo, i_modulo, add, i_add, subtract, i_subtract, concat, left_shift, right_shift, i_ncmp, scmp, nbit_and, nbit_xor, nbit_or */
-    0x1058, 0x3ef0, 0x0067, /* repeat */
-    0x3ef0, 0x012f, /* stringify, atan2, rand, srand, index, rindex, crypt, push, unshift, flock, chdir, chown, unlink, chmod, utime, rename, link, symlink, mkdir, waitpid, system, exec, kill, getpgrp, setpgrp, getpriority, setpriority, sleep */
-    0x33f0, 0x2acc, 0x00cb, /* substr */
-    0x3ef0, 0x2acc, 0x0067, /* vec */
-    0x29dc, 0x2ef8, 0x2acc, 0x38c8, 0x3c84, 0x0003, /* rv2av */
+    0x0758, 0x2d8c, 0x0067, /* aassign */
+    0x42b0, 0x0003, /* chomp, schomp, complement, ncomplement, scomplement, sin, cos, exp, log, sqrt, int, hex, oct, abs, length, ord, chr, chroot, rmdir */
+    0x42b0, 0x0067, /* pow, multiply, i_multiply, divide, i_divide, modulo, i_modulo, add, i_add, subtract, i_subtract, concat, left_shift, right_shift, nbit_and, nbit_xor, nbit_or */
+    0x1058, 0x42b0, 0x0067, /* repeat */
+    0x42b0, 0x012f, /* stringify, atan2, rand, srand, index, rindex, crypt, push, unshift, flock, chdir, chown, unlink, chmod, utime, rename, link, symlink, mkdir, waitpid, system, exec, kill, getpgrp, setpgrp, getpriority, setpriority, sleep, popcount */
+    0x3cdc, 0x2878, 0x0067, /* ncmp */
+    0x3cdc, 0x2878, 0x42b0, 0x0067, /* i_ncmp, scmp */
+    0x36b0, 0x2d8c, 0x00cb, /* substr */
+    0x42b0, 0x2d8c, 0x0067, /* vec */
+    0x17f0, 0x012f, /* sprintf */
+    0x2c9c, 0x31b8, 0x2d8c, 0x3b88, 0x4044, 0x0003, /* rv2av */
     0x01ff, /* aelemfast, aelemfast_lex */
-    0x29dc, 0x28d8, 0x0256, 0x2acc, 0x0067, /* aelem, helem */
-    0x29dc, 0x2acc, 0x38c9, /* aslice, hslice */
-    0x2acd, /* kvaslice, kvhslice */
-    0x29dc, 0x3818, 0x0003, /* delete */
-    0x3d78, 0x0003, /* exists */
-    0x29dc, 0x2ef8, 0x0534, 0x05d0, 0x2acc, 0x38c8, 0x3c84, 0x0003, /* rv2hv */
-    0x29dc, 0x28d8, 0x0d14, 0x1670, 0x2acc, 0x3c84, 0x0003, /* multideref */
-    0x223c, 0x2ef8, 0x3ef1, /* split */
-    0x29dc, 0x1e99, /* list */
-    0x3af8, 0x3194, 0x0fb0, 0x254c, 0x34e8, 0x2644, 0x2e61, /* sort */
-    0x254c, 0x0003, /* reverse */
-    0x1cc4, 0x0003, /* grepstart, grepwhile, mapstart, mapwhile */
-    0x2778, 0x0003, /* flip, flop */
-    0x29dc, 0x0003, /* cond_expr */
-    0x29dc, 0x0b98, 0x0256, 0x028c, 0x3e48, 0x3c84, 0x2301, /* entersub */
-    0x3258, 0x0003, /* leavesub, leavesublv, leavewrite, leaveeval */
+    0x2c9c, 0x2b98, 0x0256, 0x2d8c, 0x0067, /* aelem, helem */
+    0x2c9c, 0x2d8c, 0x3b89, /* aslice, hslice */
+    0x2d8d, /* kvaslice, kvhslice */
+    0x2c9c, 0x3ad8, 0x0003, /* delete */
+    0x4138, 0x0003, /* exists */
+    0x2c9c, 0x31b8, 0x0534, 0x05d0, 0x2d8c, 0x3b88, 0x4044, 0x0003, /* rv2hv */
+    0x2c9c, 0x2b98, 0x0d14, 0x1670, 0x2d8c, 0x4044, 0x0003, /* multideref */
+    0x233c, 0x31b8, 0x42b1, /* split */
+    0x2c9c, 0x1f99, /* list */
+    0x297c, 0x3eb8, 0x3454, 0x0fb0, 0x264c, 0x37a8, 0x2744, 0x3121, /* sort */
+    0x264c, 0x0003, /* reverse */
+    0x1dc4, 0x0003, /* grepstart, grepwhile, mapstart, mapwhile */
+    0x2a38, 0x0003, /* flip, flop */
+    0x2c9c, 0x0003, /* cond_expr */
+    0x2c9c, 0x0b98, 0x0256, 0x028c, 0x4208, 0x4044, 0x2401, /* entersub */
+    0x3518, 0x0003, /* leavesub, leavesublv, leavewrite, leaveeval */
     0x00bc, 0x012f, /* caller */
-    0x2075, /* nextstate, dbstate */
-    0x287c, 0x3259, /* leave */
-    0x29dc, 0x2ef8, 0x0c0c, 0x3569, /* enteriter */
-    0x3569, /* iter */
-    0x287c, 0x0067, /* leaveloop */
-    0x405c, 0x0003, /* last, next, redo, dump, goto */
-    0x30dc, 0x2ff8, 0x24b4, 0x23f0, 0x012f, /* open */
-    0x1910, 0x1b6c, 0x1a28, 0x17e4, 0x0003, /* ftrread, ftrwrite, ftrexec, fteread, ftewrite, fteexec */
-    0x1910, 0x1b6c, 0x1a28, 0x0003, /* ftis, ftsize, ftmtime, ftatime, ftctime, ftrowned, fteowned, ftzero, ftsock, ftchr, ftblk, ftfile, ftdir, ftpipe, ftsuid, ftsgid, ftsvtx, ftlink, fttty, fttext, ftbinary */
-    0x3ef1, /* wait, getppid, time */
-    0x32f4, 0x09b0, 0x068c, 0x3fc8, 0x1f84, 0x0003, /* entereval */
-    0x2b9c, 0x0018, 0x0ec4, 0x0de1, /* coreargs */
-    0x29dc, 0x019b, /* padrange */
-    0x29dc, 0x3bd8, 0x0376, 0x26cc, 0x14c8, 0x0067, /* refassign */
-    0x29dc, 0x3bd8, 0x0376, 0x26cc, 0x14c8, 0x0003, /* lvref */
-    0x29dd, /* lvrefslice */
-    0x29dc, 0x3bd8, 0x0003, /* lvavref */
+    0x2175, /* nextstate, dbstate */
+    0x2b3c, 0x3519, /* leave */
+    0x2c9c, 0x31b8, 0x0c0c, 0x3829, /* enteriter */
+    0x3829, /* iter */
+    0x2b3c, 0x0067, /* leaveloop */
+    0x441c, 0x0003, /* last, next, redo, dump, goto */
+    0x339c, 0x32b8, 0x25b4, 0x24f0, 0x012f, /* open */
+    0x17f1, /* prtf */
+    0x1a10, 0x1c6c, 0x1b28, 0x18e4, 0x0003, /* ftrread, ftrwrite, ftrexec, fteread, ftewrite, fteexec */
+    0x1a10, 0x1c6c, 0x1b28, 0x0003, /* ftis, ftsize, ftmtime, ftatime, ftctime, ftrowned, fteowned, ftzero, ftsock, ftchr, ftblk, ftfile, ftdir, ftpipe, ftsuid, ftsgid, ftsvtx, ftlink, fttty, fttext, ftbinary */
+    0x42b1, /* wait, getppid, time */
+    0x35b4, 0x09b0, 0x068c, 0x4388, 0x2084, 0x0003, /* entereval */
+    0x2e5c, 0x0018, 0x0ec4, 0x0de1, /* coreargs */
+    0x2c9c, 0x019b, /* padrange */
+    0x2c9c, 0x3f98, 0x0376, 0x27cc, 0x14c8, 0x0067, /* refassign */
+    0x2c9c, 0x3f98, 0x0376, 0x27cc, 0x14c8, 0x0003, /* lvref */
+    0x2c9d, /* lvrefslice */
+    0x2c9c, 0x3f98, 0x0003, /* lvavref */
 
 };
 
@@ -3001,15 +3019,15 @@ EXTCONST U8 PL_op_private_valid[] = {
     /* I_EQ       */ (OPpARG2_MASK),
     /* NE         */ (OPpARG2_MASK),
     /* I_NE       */ (OPpARG2_MASK),
-    /* NCMP       */ (OPpARG2_MASK),
-    /* I_NCMP     */ (OPpARG2_MASK|OPpTARGET_MY),
+    /* NCMP       */ (OPpARG2_MASK|OPpCMP_KEYDESC|OPpCMP_SORTKEY),
+    /* I_NCMP     */ (OPpARG2_MASK|OPpTARGET_MY|OPpCMP_KEYDESC|OPpCMP_SORTKEY),
     /* SLT        */ (OPpARG2_MASK),
     /* SGT        */ (OPpARG2_MASK),
     /* SLE        */ (OPpARG2_MASK),
     /* SGE        */ (OPpARG2_MASK),
     /* SEQ        */ (OPpARG2_MASK),
     /* SNE        */ (OPpARG2_MASK),
-    /* SCMP       */ (OPpARG2_MASK|OPpTARGET_MY),
+    /* SCMP       */ (OPpARG2_MASK|OPpTARGET_MY|OPpCMP_KEYDESC|OPpCMP_SORTKEY),
     /* BIT_AND    */ (OPpARG2_MASK),
     /* BIT_XOR    */ (OPpARG2_MASK),
     /* BIT_OR     */ (OPpARG2_MASK),
@@ -3043,7 +3061,7 @@ EXTCONST U8 PL_op_private_valid[] = {
     /* VEC        */ (OPpARG2_MASK|OPpMAYBE_LVSUB|OPpTARGET_MY),
     /* INDEX      */ (OPpARG4_MASK|OPpTARGET_MY),
     /* RINDEX     */ (OPpARG4_MASK|OPpTARGET_MY),
-    /* SPRINTF    */ (OPpARG4_MASK),
+    /* SPRINTF    */ (OPpARG4_MASK|OPpFORMAT_FAST),
     /* FORMLINE   */ (OPpARG4_MASK),
     /* ORD        */ (OPpARG1_MASK|OPpTARGET_MY),
     /* CHR        */ (OPpARG1_MASK|OPpTARGET_MY),
@@ -3085,7 +3103,7 @@ EXTCONST U8 PL_op_private_valid[] = {
     /* POP        */ (OPpARG1_MASK),
     /* SHIFT      */ (OPpARG1_MASK),
     /* UNSHIFT    */ (OPpARG4_MASK|OPpTARGET_MY),
-    /* SORT       */ (OPpSORT_NUMERIC|OPpSORT_INTEGER|OPpSORT_REVERSE|OPpSORT_INPLACE|OPpSORT_DESCEND|OPpSORT_QSORT|OPpSORT_STABLE),
+    /* SORT       */ (OPpSORT_NUMERIC|OPpSORT_INTEGER|OPpSORT_REVERSE|OPpSORT_INPLACE|OPpSORT_DESCEND|OPpSORT_QSORT|OPpSORT_STABLE|OPpSORT_LIMIT),
     /* REVERSE    */ (OPpARG1_MASK|OPpREVERSE_INPLACE),
     /* GREPSTART  */ (OPpARG1_MASK|OPpGREP_LEX),
     /* GREPWHILE  */ (OPpARG1_MASK|OPpGREP_LEX),
@@ -3155,7 +3173,7 @@ EXTCONST U8 PL_op_private_valid[] = {
     /* READ       */ (OPpARG4_MASK),
     /* ENTERWRITE */ (OPpARG4_MASK),
     /* LEAVEWRITE */ (OPpARG1_MASK|OPpREFCOUNTED),
-    /* PRTF       */ (0),
+    /* PRTF       */ (OPpFORMAT_FAST),
     /* PRINT      */ (0),
     /* SAY        */ (0),
     /* SYSOPEN    */ (OPpARG4_MASK),
@@ -3314,6 +3332,7 @@ EXTCONST U8 PL_op_private_valid[] = {
     /* LVREFSLICE */ (OPpLVAL_INTRO),
     /* LVAVREF    */ (OPpARG1_MASK|OPpPAD_STATE|OPpLVAL_INTRO),
     /* ANONCONST  */ (OPpARG1_MASK),
+    /* POPCOUNT   */ (OPpARG4_MASK|OPpTARGET_MY),
 
 };
 
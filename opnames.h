@@ -410,10 +410,11 @@ typedef enum opcode {
 	OP_LVREFSLICE	 = 393,
 	OP_LVAVREF	 = 394,
 	OP_ANONCONST	 = 395,
+	OP_POPCOUNT	 = 396,
 	OP_max		
 } opcode;
 
-#define MAXO 396
+#define MAXO 397
 #define OP_FREED MAXO
 
 /* the OP_IS_* macros are optimized to a simple range check because
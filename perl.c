@@ -873,6 +873,8 @@ perl_destruct(pTHXx)
 #endif
 
 
+    reg_cache_free();
+
     SvREFCNT_dec(MUTABLE_SV(PL_stashcache));
     PL_stashcache = NULL;
 
@@ -1756,6 +1756,17 @@ typedef UVTYPE UV;
 #define PTR2NV(p)	NUM2PTR(NV,p)
 #define PTR2nat(p)	(PTRV)(p)	/* pointer to integer of PTRSIZE */
 
+#ifdef PERL_CORE
+/* Some string loops in the core look at a whole word (a UV) at a time
+ * rather than at each byte.  These give the size of such a word, the mask
+ * for finding whether a pointer is aligned on one, a word with 0x01 in each
+ * byte, and a word with just the high bit of each byte set */
+#  define PERL_WORDSIZE            UVSIZE
+#  define PERL_WORD_BOUNDARY_MASK  (PERL_WORDSIZE - 1)
+#  define PERL_COUNT_MULTIPLIER    (~ (UV) 0 / 0xFF)
+#  define PERL_VARIANTS_WORD_MASK  (PERL_COUNT_MULTIPLIER * 0x80)
+#endif
+
 /* According to strict ANSI C89 one cannot freely cast between
  * data pointers and function (code) pointers.  There are at least
  * two ways around this.  One (used below) is to do two casts,
@@ -5294,6 +5305,8 @@ typedef enum {
 
 #define HINT_FEATURE_MASK	0x1c000000 /* 3 bits for feature bundles */
 
+#define HINT_ROUNDTRIP		0x20000000 /* roundtrip pragma */
+
 				/* Note: Used for HINT_M_VMSISH_*,
 				   currently defined by vms/vmsish.h:
 				0x40000000
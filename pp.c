@@ -722,16 +722,61 @@ PP(pp_study)
 {
     dSP; dTOPss;
     STRLEN len;
-
-    (void)SvPV(sv, len);
-    if (len == 0 || len > I32_MAX || !SvPOK(sv) || SvUTF8(sv) || SvVALID(sv)) {
-	/* Historically, study was skipped in these cases. */
+    const U8 *s;
+    MAGIC *mg;
+    struct study_index *idx;
+    U32 next[256];
+    STRLEN i;
+    int c;
+
+    s = (const U8 *)SvPV(sv, len);
+    if (len == 0 || len > I32_MAX || !SvPOK(sv) || SvUTF8(sv) || SvVALID(sv)
+        || SvGMAGICAL(sv)
+        || len > (I32_MAX - sizeof(struct study_index)) / sizeof(U32))
+    {
+	/* Historically, study was skipped in these cases.  Tied values can
+	   change under us without set magic, and the index has to fit in
+	   mg_len. */
 	SETs(&PL_sv_no);
 	return NORMAL;
     }
+    if (SvREADONLY(sv) || SvPADTMP(sv) || len < 256) {
+	/* Constants and temporaries are shared or about to go, and on short
+	   strings fbm_instr() is as quick as the index would be, so leave
+	   these as they are rather than upgrade them to carry one. */
+	SETs(&PL_sv_yes);
+	return NORMAL;
+    }
 
-    /* Make study a no-op. It's no longer useful and its existence
-       complicates matters elsewhere. */
+    if (SvSMAGICAL(sv) && (mg = mg_find(sv, PERL_MAGIC_study))) {
+	idx = (struct study_index *)mg->mg_ptr;
+	if (idx->pv == SvPVX_const(sv) && idx->cur == len) {
+	    SETs(&PL_sv_yes);
+	    return NORMAL;
+	}
+	sv_unmagic(sv, PERL_MAGIC_study);
+    }
+
+    /* Build the positions of each byte value with a counting sort, so that
+       study_instr() can go straight to the places a search could match */
+    idx = (struct study_index *)safemalloc(STRUCT_OFFSET(struct study_index, pos)
+                                           + len * sizeof(U32));
+    idx->pv = SvPVX_const(sv);
+    idx->cur = len;
+    Zero(next, 256, U32);
+    for (i = 0; i < len; i++)
+	next[s[i]]++;
+    idx->first[0] = 0;
+    for (c = 0; c < 256; c++) {
+	idx->first[c + 1] = idx->first[c] + next[c];
+	next[c] = idx->first[c];
+    }
+    for (i = 0; i < len; i++)
+	idx->pos[next[s[i]]++] = (U32)i;
+
+    mg = sv_magicext(sv, NULL, PERL_MAGIC_study, &PL_vtbl_study,
+                     (const char *)idx, 0);
+    mg->mg_len = STRUCT_OFFSET(struct study_index, pos) + len * sizeof(U32);
     SETs(&PL_sv_yes);
     return NORMAL;
 }
@@ -3355,6 +3400,71 @@ PP(pp_vec)
     RETURN;
 }
 
+/* Counts the bits set in a string, or in the range of its bits given by
+ * an offset and length.  The bits are numbered as vec() with a size of 1
+ * numbers them, and those past the end of the string count as zero. */
+
+PP(pp_popcount)
+{
+    dSP; dTARGET;
+    const int maxarg = MAXARG;
+    const bool length_given = maxarg >= 3 && (TOPs || ((void)POPs,0));
+    IV length = 0;
+    IV offset = 0;
+    SV *src;
+    const U8 *s;
+    STRLEN len;
+    UV nbits, start, end;
+    UV count = 0;
+
+    /* &CORE::popcount pushes NULL for the arguments it was not given */
+    if (length_given)
+	length = POPi;
+    if (maxarg >= 2 && (TOPs || ((void)POPs,0)))
+	offset = POPi;
+    src = POPs;
+    if (offset < 0)
+	DIE(aTHX_ "Negative offset to popcount");
+    if (length < 0)
+	DIE(aTHX_ "Negative length to popcount");
+
+    s = (const U8 *) SvPV_const(src, len);
+    if (DO_UTF8(src)) {
+	bool is_utf8 = TRUE;
+	s = bytes_from_utf8(s, &len, &is_utf8);
+	if (is_utf8)
+	    DIE(aTHX_ "Use of strings with code points over 0xFF as arguments"
+		      " to popcount is not allowed");
+	SAVEFREEPV(s);
+    }
+
+    nbits = (UV) len * 8;
+    start = offset;
+    if (start >= nbits)
+	end = start;
+    else if (!length_given || (UV) length >= nbits - start)
+	end = nbits;
+    else
+	end = start + length;
+
+    if (start < end) {
+	const STRLEN first = start >> 3;
+	const STRLEN last = (end - 1) >> 3;
+	const U8 head = (U8) (0xFF << (start & 7));
+	const U8 tail = (U8) (0xFF >> (7 - ((end - 1) & 7)));
+
+	if (first == last)
+	    count = PL_bitcount[s[first] & head & tail];
+	else
+	    count = PL_bitcount[s[first] & head]
+		  + count_bits(s + first + 1, s + last)
+		  + PL_bitcount[s[last] & tail];
+    }
+
+    PUSHu(count);
+    RETURN;
+}
+
 
 /* also used for: pp_rindex() */
 
@@ -3459,7 +3569,7 @@ PP(pp_index)
     else if (offset > (SSize_t)biglen)
 	offset = biglen;
     if (!(little_p = is_index
-	  ? fbm_instr((unsigned char*)big_p + offset,
+	  ? study_instr(big, (unsigned char*)big_p + offset,
 		      (unsigned char*)big_p + biglen, little, 0)
 	  : rninstr(big_p,  big_p  + offset,
 		    little_p, little_p + llen)))
@@ -3968,6 +4078,11 @@ PP(pp_uc)
 	 * itself) and so can't be checked properly to see if it ever gets
 	 * revised.  But the likelihood of it changing is remote */
 	bool in_iota_subscript = FALSE;
+#ifdef USE_LOCALE_CTYPE
+	const bool in_locale = cBOOL(IN_LC_RUNTIME(LC_CTYPE));
+#else
+	const bool in_locale = FALSE;
+#endif
 
 	while (s < send) {
 	    STRLEN u;
@@ -3981,6 +4096,15 @@ PP(pp_uc)
 		in_iota_subscript = FALSE;
             }
 
+            /* Outside of locale, ASCII characters uppercase to ASCII, and
+             * the same length, so runs of them can be done all at once */
+            if (isASCII(*s) && ! in_locale) {
+                u = change_case_ascii_run(d, s, send, TRUE);
+                d += u;
+                s += u;
+                continue;
+            }
+
             /* Then handle the current character.  Get the changed case value
              * and copy it to the output buffer */
 
@@ -4044,8 +4168,15 @@ PP(pp_uc)
 	    else
 #endif
                  if (! IN_UNI_8_BIT) {
-		for (; s < send; d++, s++) {
-		    *d = toUPPER(*s);
+		while (s < send) {
+		    const STRLEN n = change_case_ascii_run(d, s, send, TRUE);
+		    d += n;
+		    s += n;
+
+		    /* Only ASCII changes case under these rules */
+		    if (s < send) {
+			*d++ = *s++;
+		    }
 		}
 	    }
 	    else {
@@ -4053,6 +4184,15 @@ PP(pp_uc)
           do_uni_rules:
 #endif
 		for (; s < send; d++, s++) {
+		    if (isASCII(*s)) {
+			const STRLEN n = change_case_ascii_run(d, s, send, TRUE);
+
+			/* Leave the loop increments to step past the last one
+			 * done */
+			d += n - 1;
+			s += n - 1;
+			continue;
+		    }
 		    *d = toUPPER_LATIN1_MOD(*s);
 		    if (LIKELY(*d != LATIN_SMALL_LETTER_Y_WITH_DIAERESIS)) {
                         continue;
@@ -4197,11 +4337,25 @@ PP(pp_lc)
     if (DO_UTF8(source)) {
 	const U8 *const send = s + len;
 	U8 tmpbuf[UTF8_MAXBYTES_CASE+1];
+#ifdef USE_LOCALE_CTYPE
+	const bool in_locale = cBOOL(IN_LC_RUNTIME(LC_CTYPE));
+#else
+	const bool in_locale = FALSE;
+#endif
 
 	while (s < send) {
 	    const STRLEN u = UTF8SKIP(s);
 	    STRLEN ulen;
 
+	    /* Outside of locale, ASCII characters lowercase to ASCII, and the
+	     * same length, so runs of them can be done all at once */
+	    if (isASCII(*s) && ! in_locale) {
+		const STRLEN n = change_case_ascii_run(d, s, send, FALSE);
+		d += n;
+		s += n;
+		continue;
+	    }
+
 #ifdef USE_LOCALE_CTYPE
 	    _to_utf8_lower_flags(s, tmpbuf, &ulen, IN_LC_RUNTIME(LC_CTYPE));
 #else
@@ -4252,13 +4406,26 @@ PP(pp_lc)
 	    else
 #endif
             if (! IN_UNI_8_BIT) {
-		for (; s < send; d++, s++) {
-		    *d = toLOWER(*s);
+		while (s < send) {
+		    const STRLEN n = change_case_ascii_run(d, s, send, FALSE);
+		    d += n;
+		    s += n;
+
+		    /* Only ASCII changes case under these rules */
+		    if (s < send) {
+			*d++ = *s++;
+		    }
 		}
 	    }
 	    else {
-		for (; s < send; d++, s++) {
-		    *d = toLOWER_LATIN1(*s);
+		while (s < send) {
+		    const STRLEN n = change_case_ascii_run(d, s, send, FALSE);
+		    d += n;
+		    s += n;
+		    if (s < send) {
+			*d++ = toLOWER_LATIN1(*s);
+			s++;
+		    }
 		}
 	    }
 	}
@@ -4408,6 +4575,15 @@ PP(pp_fc)
             const STRLEN u = UTF8SKIP(s);
             STRLEN ulen;
 
+            /* Outside of locale, the fold of an ASCII character is its
+             * lowercase, so runs of them can be done all at once */
+            if (isASCII(*s) && ! (flags & FOLD_FLAGS_LOCALE)) {
+                const STRLEN n = change_case_ascii_run(d, s, send, FALSE);
+                d += n;
+                s += n;
+                continue;
+            }
+
             _to_utf8_fold_flags(s, tmpbuf, &ulen, flags);
 
             if (ulen > u && (SvLEN(dest) < (min += ulen - u))) {
@@ -4435,8 +4611,15 @@ PP(pp_fc)
         else
 #endif
         if ( !IN_UNI_8_BIT ) { /* Under nothing, or bytes */
-            for (; s < send; d++, s++)
-                *d = toFOLD(*s);
+            while (s < send) {
+                const STRLEN n = change_case_ascii_run(d, s, send, FALSE);
+                d += n;
+                s += n;
+
+                /* Only ASCII folds under these rules */
+                if (s < send)
+                    *d++ = *s++;
+            }
         }
         else {
 #ifdef USE_LOCALE_CTYPE
@@ -4448,6 +4631,15 @@ PP(pp_fc)
              * under any fold becomes \x{3BC} (\N{GREEK SMALL LETTER MU}) --
              * For the rest, the casefold is their lowercase.  */
             for (; s < send; d++, s++) {
+                if (isASCII(*s)) {
+                    const STRLEN n = change_case_ascii_run(d, s, send, FALSE);
+
+                    /* Leave the loop increments to step past the last one
+                     * done */
+                    d += n - 1;
+                    s += n - 1;
+                    continue;
+                }
                 if (*s == MICRO_SIGN) {
                     /* \N{MICRO SIGN}'s casefold is \N{GREEK SMALL LETTER MU},
                      * which is outside of the latin-1 range. There's a couple
@@ -5636,6 +5828,25 @@ PP(pp_reverse)
     RETURN;
 }
 
+/* Find the fixed string sep in s..strend for split: memchr() (usually
+ * vectorised by the C library) for its first byte, then compare the rest.
+ * This also works on UTF-8, as sep's first byte can only match at the
+ * start of a character. */
+
+PERL_STATIC_INLINE const char *
+S_split_find(const char *s, const char * const strend,
+	     const char * const sep, const STRLEN seplen)
+{
+    while ((STRLEN)(strend - s) >= seplen
+	   && (s = (const char *)memchr(s, *sep, strend - s - seplen + 1)))
+    {
+	if (memEQ(s + 1, sep + 1, seplen - 1))
+	    return s;
+	s++;
+    }
+    return NULL;
+}
+
 PP(pp_split)
 {
     dSP; dTARG;
@@ -5887,12 +6098,23 @@ PP(pp_split)
 	SV * const csv = CALLREG_INTUIT_STRING(rx);
 
 	len = RX_MINLENRET(rx);
-	if (len == 1 && !RX_UTF8(rx) && !tail) {
-	    const char c = *SvPV_nolen_const(csv);
+	if (!tail) {
+	    /* the separator is a fixed string */
+	    STRLEN seplen;
+	    const char * const sep = SvPV_const(csv, seplen);
+
+	    if (!gimme_scalar) {
+		/* count the fields first, so that the stack (which may be
+		 * the array being assigned to) is only extended once */
+		SSize_t fields = 1;
+		IV n = limit;
+		for (m = s; --n && (m = S_split_find(m, strend, sep, seplen));
+		     m += seplen)
+		    fields++;
+		EXTEND(SP, fields);
+	    }
 	    while (--limit) {
-		for (m = s; m < strend && *m != c; m++)
-		    ;
-		if (m >= strend)
+		if (!(m = S_split_find(s, strend, sep, seplen)))
 		    break;
 		if (gimme_scalar) {
 		    iters++;
@@ -5903,14 +6125,9 @@ PP(pp_split)
 		} else {
 		    dstr = newSVpvn_flags(s, m-s,
 					 (do_utf8 ? SVf_UTF8 : 0) | make_mortal);
-		    XPUSHs(dstr);
+		    PUSHs(dstr);
 		}
-		/* The rx->minlen is in characters but we want to step
-		 * s ahead by bytes. */
- 		if (do_utf8)
-		    s = (char*)utf8_hop((U8*)m, len);
- 		else
-		    s = m + len; /* Fake \n at the end */
+		s = m + seplen;
 	    }
 	}
 	else {
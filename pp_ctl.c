@@ -129,31 +129,34 @@ PP(pp_regcomp)
 	ReANY(new_re)->qr_anoncv
 			= (CV*) SvREFCNT_inc(PAD_SV(PL_op->op_targ));
 
-    if (is_bare_re) {
-	REGEXP *tmp;
-	/* The match's LHS's get-magic might need to access this op's regexp
-	   (e.g. $' =~ /$re/ while foo; see bug 70764).  So we must call
-	   get-magic now before we replace the regexp. Hopefully this hack can
-	   be replaced with the approach described at
-	   http://www.nntp.perl.org/group/perl.perl5.porters/2007/03/msg122415.html
-	   some day. */
-	if (pm->op_type == OP_MATCH) {
-	    SV *lhs;
-	    const bool was_tainted = TAINT_get;
-	    if (pm->op_flags & OPf_STACKED)
-		lhs = args[-1];
-	    else if (pm->op_targ)
-		lhs = PAD_SV(pm->op_targ);
-	    else lhs = DEFSV;
-	    SvGETMAGIC(lhs);
-	    /* Restore the previous value of PL_tainted (which may have been
-	       modified by get-magic), to avoid incorrectly setting the
-	       RXf_TAINTED flag with RX_TAINT_on further down. */
-	    TAINT_set(was_tainted);
+    /* The match's LHS's get-magic might need to access this op's regexp
+       (e.g. $' =~ /$re/ while foo; see bug 70764).  So we must call
+       get-magic now before we replace the regexp; pp_match won't call it
+       again for a copy of a qr// or of a pattern from the compiled
+       pattern cache, both of which have mother_re set. Hopefully this
+       hack can be replaced with the approach described at
+       http://www.nntp.perl.org/group/perl.perl5.porters/2007/03/msg122415.html
+       some day. */
+    if ((is_bare_re || ReANY(new_re)->mother_re) && pm->op_type == OP_MATCH) {
+	SV *lhs;
+	const bool was_tainted = TAINT_get;
+	if (pm->op_flags & OPf_STACKED)
+	    lhs = args[-1];
+	else if (pm->op_targ)
+	    lhs = PAD_SV(pm->op_targ);
+	else lhs = DEFSV;
+	SvGETMAGIC(lhs);
+	/* Restore the previous value of PL_tainted (which may have been
+	   modified by get-magic), to avoid incorrectly setting the
+	   RXf_TAINTED flag with RX_TAINT_on further down. */
+	TAINT_set(was_tainted);
 #ifdef NO_TAINT_SUPPORT
-            PERL_UNUSED_VAR(was_tainted);
+        PERL_UNUSED_VAR(was_tainted);
 #endif
-	}
+    }
+
+    if (is_bare_re) {
+	REGEXP *tmp;
 	tmp = reg_temp_copy(NULL, new_re);
 	ReREFCNT_dec(new_re);
 	new_re = tmp;
@@ -1373,6 +1373,10 @@ PP(pp_qr)
     RETURN;
 }
 
+/* Strings at least this long are given room for a COW reference count
+ * before being matched; see pp_match */
+#define PERL_MATCH_COW_GROW_MIN 0x10000
+
 PP(pp_match)
 {
     dSP; dTARG;
@@ -1409,6 +1413,24 @@ PP(pp_match)
 	 : SvPV_const(TARG, len);
     if (!truebase)
 	DIE(aTHX_ "panic: pp_match");
+#ifdef PERL_NEW_COPY_ON_WRITE
+    /* A string with no spare byte to keep a COW reference count in can't
+       be shared with the captures of a successful match, so the part of
+       it they cover gets copied (see S_reg_set_capture_string()), which
+       for a long string is a lot of copying each time.  Make room for the
+       count instead: then the captures refer to the string itself, and
+       it's only copied if changed while they're still wanted. */
+    if (len >= PERL_MATCH_COW_GROW_MIN
+	&& !SvIsCOW(TARG)
+	&& (SvFLAGS(TARG) & CAN_COW_MASK) == CAN_COW_FLAGS
+	&& SvLEN(TARG) && SvCUR(TARG) + 1 >= SvLEN(TARG))
+    {
+	/* not SvGROW(), which would add a quarter again */
+	SvPV_set(TARG, (char *)saferealloc(SvPVX_mutable(TARG), len + 2));
+	SvLEN_set(TARG, len + 2);
+	truebase = SvPVX_const(TARG);
+    }
+#endif
     strend = truebase + len;
     rxtainted = (RX_ISTAINTED(rx) ||
 		 (TAINT_get && (pm->op_pmflags & PMf_RETAINT)));
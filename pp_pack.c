@@ -1131,11 +1131,13 @@ S_unpack_rec(pTHX_ tempsym_t* symptr, const char *s, const char *strbeg, const c
 			cuv += PL_bitcount[uni_to_byte(aTHX_ &s, strend, datumtype)];
 			len -= 8;
 		    }
-		else
-		    while (len >= 8) {
-			cuv += PL_bitcount[*(U8 *)s++];
-			len -= 8;
-		    }
+		else {
+		    /* The bit order doesn't matter for the count, so all the
+		     * whole bytes can be counted at once */
+		    cuv += count_bits((const U8 *) s, (const U8 *) s + len / 8);
+		    s += len / 8;
+		    len %= 8;
+		}
 		if (len && s < strend) {
 		    U8 bits;
 		    bits = SHIFT_BYTE(utf8, s, strend, datumtype);
@@ -1423,6 +1423,443 @@ S_qsortsv(pTHX_ gptr *list1, size_t nmemb, SVCOMPARE_t cmp, U32 flags)
     }
 }
 
+#define SvNSIOK(sv) ((SvFLAGS(sv) & SVf_NOK) || ((SvFLAGS(sv) & (SVf_IOK|SVf_IVisUV)) == SVf_IOK))
+#define SvSIOK(sv) ((SvFLAGS(sv) & (SVf_IOK|SVf_IVisUV)) == SVf_IOK)
+#define SvNSIV(sv) ( SvNOK(sv) ? SvNVX(sv) : ( SvSIOK(sv) ? SvIVX(sv) : sv_2nv(sv) ) )
+
+/*
+ * Sorting on keys.
+ *
+ * When the comparison is one of the builtin ones (S_sv_ncmp, S_sv_i_ncmp
+ * or sv_cmp without locale) and every element is a plain scalar whose
+ * value is already cached, the value each comparison would look at is
+ * copied out into an array of keys, and the keys are sorted instead of
+ * calling the comparison function O(n log n) times.  Numbers are sorted
+ * with an LSD radix sort on a U64 which orders as the number does;
+ * strings are radix sorted on their first 8 bytes, and runs sharing those
+ * are then merge sorted on the whole string.  Comparing keys runs no perl
+ * code and touches no SVs, so with ithreads large arrays are split
+ * between several threads, each sorting a slice, and the sorted slices
+ * are then merged.  All of this is stable, so the result is the one the
+ * mergesort above would give.  Anything the keys can't represent (magic,
+ * overloading, NaNs, values which would need converting, strings of mixed
+ * UTF-8ness) leaves the sort to the usual code.
+ */
+
+#if defined(HAS_QUAD) && !defined(PERL_SORT_NO_KEYS)
+#  define PERL_SORT_KEYS
+#endif
+
+#if defined(PERL_SORT_KEYS) && defined(USE_ITHREADS) && defined(I_PTHREAD) \
+ && !defined(I_MACH_CTHREADS) && !defined(WIN32) && !defined(NETWARE) \
+ && !defined(OS2) && !defined(VMS) && !defined(PERL_SORT_NO_THREADS)
+#  define PERL_SORT_THREADS
+#endif
+
+#ifdef PERL_SORT_KEYS
+
+#ifndef SORT_KEY_MIN
+#  define SORT_KEY_MIN (64)		/* fewest elements worth the keys */
+#endif
+#define SORT_KEY_INSERTION (16)		/* runs this small use insertion */
+
+/* A number's key is a U64 which compares as the number does.  A string's
+ * key has its first 8 bytes, big-endian, so that most comparisons need not
+ * look at the string itself. */
+
+typedef struct {
+    U64 k;
+    SV *sv;
+} sort_key;
+
+#define SORT_KEY_SIGN (((U64) 1) << 63)
+
+PERL_STATIC_INLINE int
+S_sort_key_cmp(const sort_key *a, const sort_key *b, const int sense,
+	       const bool strings)
+{
+    STRLEN alen, blen, len;
+    int retval;
+
+    if (a->k != b->k)
+	return a->k < b->k ? -sense : sense;
+    if (!strings)
+	return 0;
+
+    /* as sv_cmp() for two strings of the same UTF-8ness */
+    alen = SvCUR(a->sv);
+    blen = SvCUR(b->sv);
+    len = alen < blen ? alen : blen;
+    retval = len > 8
+	   ? memcmp(SvPVX_const(a->sv) + 8, SvPVX_const(b->sv) + 8, len - 8)
+	   : 0;
+    if (retval)
+	return retval < 0 ? -sense : sense;
+    return alen < blen ? -sense : alen > blen ? sense : 0;
+}
+
+/* Stably sort keys[0..n) in place, with room for n/2 keys in tmp */
+
+static void
+S_sort_key_msort(sort_key *keys, const size_t n, sort_key *tmp,
+		 const int sense, const bool strings)
+{
+    size_t h;
+
+    if (n <= SORT_KEY_INSERTION) {
+	size_t i, j;
+	for (i = 1; i < n; i++) {
+	    const sort_key k = keys[i];
+	    for (j = i; j > 0 && S_sort_key_cmp(&keys[j-1], &k, sense, strings) > 0;
+		 j--)
+		keys[j] = keys[j-1];
+	    keys[j] = k;
+	}
+	return;
+    }
+
+    h = n / 2;
+    S_sort_key_msort(keys, h, tmp, sense, strings);
+    S_sort_key_msort(keys + h, n - h, tmp, sense, strings);
+    if (S_sort_key_cmp(&keys[h-1], &keys[h], sense, strings) <= 0)
+	return;				/* already in order */
+
+    /* merge the left half, moved out of the way, with the right */
+    Copy(keys, tmp, h, sort_key);
+    {
+	const sort_key *l = tmp;
+	const sort_key * const lend = tmp + h;
+	const sort_key *r = keys + h;
+	const sort_key * const rend = keys + n;
+	sort_key *d = keys;
+
+	while (l < lend && r < rend) {
+	    if (S_sort_key_cmp(l, r, sense, strings) <= 0)
+		*d++ = *l++;
+	    else
+		*d++ = *r++;
+	}
+	if (l < lend)
+	    Copy(l, d, lend - l, sort_key);
+    }
+}
+
+/* Stably sort keys[0..n) in place, with room for n keys in tmp.  All
+ * eight byte histograms are made in one pass, and bytes which are the same
+ * in every key are skipped. */
+
+static void
+S_sort_key_radix(sort_key *keys, const size_t n, sort_key *tmp,
+		 const int sense, const bool strings)
+{
+    const U64 flip = sense < 0 ? ~(U64) 0 : 0;
+    size_t count[8][256];
+    sort_key *from = keys, *to = tmp;
+    size_t i;
+    int byte;
+
+    Zero(count, 8, size_t[256]);
+    for (i = 0; i < n; i++) {
+	const U64 k = keys[i].k ^ flip;
+	for (byte = 0; byte < 8; byte++)
+	    count[byte][(k >> (byte * 8)) & 0xFF]++;
+    }
+
+    for (byte = 0; byte < 8; byte++) {
+	size_t * const c = count[byte];
+	const int shift = byte * 8;
+	size_t sum = 0;
+
+	if (c[((keys[0].k ^ flip) >> shift) & 0xFF] == n)
+	    continue;
+	for (i = 0; i < 256; i++) {
+	    const size_t here = c[i];
+	    c[i] = sum;
+	    sum += here;
+	}
+	for (i = 0; i < n; i++)
+	    to[c[((from[i].k ^ flip) >> shift) & 0xFF]++] = from[i];
+	{
+	    sort_key * const t = from;
+	    from = to;
+	    to = t;
+	}
+    }
+    if (from != keys)
+	Copy(from, keys, n, sort_key);
+
+    /* strings with the same first 8 bytes are still in their original
+     * order, so sort each such run on the whole string */
+    if (strings) {
+	size_t start = 0;
+	for (i = 1; i <= n; i++) {
+	    if (i == n || keys[i].k != keys[start].k) {
+		if (i - start > 1)
+		    S_sort_key_msort(keys + start, i - start, tmp, sense,
+				     strings);
+		start = i;
+	    }
+	}
+    }
+}
+
+/* Fill in the key for sv as compared by cmp, returning false if the key
+ * can't stand in for sv */
+
+STATIC bool
+S_sort_key_make(pTHX_ sort_key *key, SV *const sv, SVCOMPARE_t cmp)
+{
+    if (!sv || SvGMAGICAL(sv) || SvAMAGIC(sv))
+	return FALSE;
+    key->sv = sv;
+    if (cmp == S_sv_i_ncmp) {
+	if (!SvIOK(sv))
+	    return FALSE;
+	key->k = (U64) (SvIVX(sv)) ^ SORT_KEY_SIGN;
+    }
+#if NVSIZE == 8
+    else if (cmp == S_sv_ncmp) {
+	union { NV nv; U64 u; } bits;
+
+	if (SvNOK(sv))
+	    bits.nv = SvNVX(sv);
+	else if (SvSIOK(sv))
+	    bits.nv = (NV) SvIVX(sv);
+	else
+	    return FALSE;
+#  if defined(NAN_COMPARE_BROKEN) && defined(Perl_isnan)
+	if (Perl_isnan(bits.nv))
+#  else
+	if (bits.nv != bits.nv)
+#  endif
+	    return FALSE;		/* S_sv_ncmp() warns about NaNs */
+	if (bits.nv == 0.0)
+	    bits.nv = 0.0;		/* -0.0 is equal to 0.0 */
+	key->k = (bits.u & SORT_KEY_SIGN) ? ~bits.u : bits.u | SORT_KEY_SIGN;
+    }
+#endif
+    else if (cmp == sv_cmp_static) {
+	const U8 *s;
+	STRLEN len, i;
+
+	if (!SvPOK(sv))
+	    return FALSE;
+	s = (const U8 *) SvPVX_const(sv);
+	len = SvCUR(sv);
+	key->k = 0;
+	for (i = 0; i < 8; i++)
+	    key->k = (key->k << 8) | (i < len ? s[i] : 0);
+    }
+    else
+	return FALSE;
+    return TRUE;
+}
+
+#ifdef PERL_SORT_THREADS
+
+#ifndef SORT_THREAD_MIN
+#  define SORT_THREAD_MIN (100000)	/* fewest elements worth the threads */
+#endif
+#ifndef SORT_THREAD_MAX
+#  define SORT_THREAD_MAX (8)		/* power of 2 */
+#endif
+
+typedef struct {
+    sort_key *src;		/* one or two adjacent sorted runs */
+    sort_key *dst;		/* where they go merged, or scratch */
+    size_t n1;
+    size_t n2;			/* 0 means sort the n1 in src using dst */
+    int sense;			/* -1 to sort descending */
+    bool strings;		/* the keys are of strings */
+} sort_key_job;
+
+/* Stably merge the runs src[0..n1) and src[n1..n1+n2) into dst */
+
+static void
+S_sort_key_merge(const sort_key *src, const size_t n1, const size_t n2,
+		 sort_key *dst, const int sense, const bool strings)
+{
+    const sort_key *l = src;
+    const sort_key * const lend = src + n1;
+    const sort_key *r = lend;
+    const sort_key * const rend = lend + n2;
+
+    while (l < lend && r < rend) {
+	if (S_sort_key_cmp(l, r, sense, strings) <= 0)
+	    *dst++ = *l++;
+	else
+	    *dst++ = *r++;
+    }
+    if (l < lend)
+	Copy(l, dst, lend - l, sort_key);
+    else if (r < rend)
+	Copy(r, dst, rend - r, sort_key);
+}
+
+static void *
+S_sort_key_work(void *arg)
+{
+    sort_key_job * const job = (sort_key_job *) arg;
+
+    if (job->n2)
+	S_sort_key_merge(job->src, job->n1, job->n2, job->dst, job->sense,
+			 job->strings);
+    else
+	S_sort_key_radix(job->src, job->n1, job->dst, job->sense,
+			 job->strings);
+    return NULL;
+}
+
+/* Run the jobs, all but the first in new threads, and wait for them.  The
+ * threads start with signals blocked so that they're all delivered to
+ * the thread running perl.  A job whose thread can't be started is run
+ * here instead. */
+
+static void
+S_sort_key_run(sort_key_job *jobs, const int njobs)
+{
+    pthread_t tids[SORT_THREAD_MAX];
+    bool started[SORT_THREAD_MAX];
+    sigset_t newmask, oldmask;
+    int i;
+
+    sigfillset(&newmask);
+    pthread_sigmask(SIG_BLOCK, &newmask, &oldmask);
+    for (i = 1; i < njobs; i++)
+	started[i] = pthread_create(&tids[i], NULL, S_sort_key_work,
+				    &jobs[i]) == 0;
+    pthread_sigmask(SIG_SETMASK, &oldmask, NULL);
+
+    S_sort_key_work(&jobs[0]);
+    for (i = 1; i < njobs; i++) {
+	if (started[i])
+	    pthread_join(tids[i], NULL);
+	else
+	    S_sort_key_work(&jobs[i]);
+    }
+}
+
+/* How many threads to sort nmemb elements with; less than 2 means don't */
+
+static int
+S_sort_threads(const size_t nmemb)
+{
+    long ncpu = 1;
+    int nthreads = 1;
+
+    if (nmemb < SORT_THREAD_MIN)
+	return 1;
+#ifdef _SC_NPROCESSORS_ONLN
+    ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    while (nthreads * 2 <= ncpu && nthreads * 2 <= SORT_THREAD_MAX
+	   && nmemb / (nthreads * 2) >= SORT_THREAD_MIN / 2)
+	nthreads *= 2;
+    return nthreads;
+}
+
+/* Sort the slices of keys on separate threads, then merge pairs of runs
+ * back and forth between keys and aux, a thread per pair.  Returns where
+ * the result ended up. */
+
+static sort_key *
+S_sort_key_threaded(sort_key *keys, sort_key *aux, const size_t nmemb,
+		    const int nthreads, const int sense, const bool strings)
+{
+    sort_key_job jobs[SORT_THREAD_MAX];
+    const size_t slice = nmemb / nthreads;
+    sort_key *from = keys, *to = aux;
+    int runs, j;
+
+    for (j = 0; j < nthreads; j++) {
+	jobs[j].src = keys + j * slice;
+	jobs[j].dst = aux + j * slice;
+	jobs[j].n1 = j == nthreads - 1 ? nmemb - j * slice : slice;
+	jobs[j].n2 = 0;
+	jobs[j].sense = sense;
+	jobs[j].strings = strings;
+    }
+    S_sort_key_run(jobs, nthreads);
+
+    for (runs = nthreads; runs > 1; runs /= 2) {
+	const size_t len = slice * (nthreads / runs);
+	for (j = 0; j < runs / 2; j++) {
+	    const size_t off = 2 * j * len;
+	    jobs[j].src = from + off;
+	    jobs[j].dst = to + off;
+	    jobs[j].n1 = len;
+	    jobs[j].n2 = j == runs / 2 - 1 ? nmemb - off - len : len;
+	}
+	S_sort_key_run(jobs, runs / 2);
+	{
+	    sort_key * const t = from;
+	    from = to;
+	    to = t;
+	}
+    }
+    return from;
+}
+
+#endif /* PERL_SORT_THREADS */
+
+/* Sort array on its keys if cmp is a builtin comparison and the elements
+ * allow it.  Returns false, having done nothing, otherwise. */
+
+STATIC bool
+S_sortsv_keyed(pTHX_ SV **array, const size_t nmemb, SVCOMPARE_t cmp,
+	       const U32 flags)
+{
+    const int sense = (flags & SORTf_DESC) ? -1 : 1;
+    const bool strings = cmp == sv_cmp_static;
+    sort_key *keys, *aux, *sorted;
+    size_t i;
+
+    if (nmemb < SORT_KEY_MIN
+	|| ((flags & SORTf_QSORT) && !(flags & SORTf_STABLE)))
+	return FALSE;
+    /* array may not even hold SVs for other comparisons */
+    if (cmp != S_sv_i_ncmp && cmp != sv_cmp_static
+#if NVSIZE == 8
+	&& cmp != S_sv_ncmp
+#endif
+	)
+	return FALSE;
+
+    Newx(keys, nmemb, sort_key);
+    for (i = 0; i < nmemb; i++) {
+	if (!S_sort_key_make(aTHX_ &keys[i], array[i], cmp)
+	    /* sv_cmp() of mixed UTF-8ness isn't a byte comparison */
+	    || (strings && SvUTF8(array[i]) != SvUTF8(array[0])))
+	{
+	    Safefree(keys);
+	    return FALSE;
+	}
+    }
+
+    Newx(aux, nmemb, sort_key);
+    sorted = keys;
+#ifdef PERL_SORT_THREADS
+    {
+	const int nthreads = S_sort_threads(nmemb);
+	if (nthreads > 1)
+	    sorted = S_sort_key_threaded(keys, aux, nmemb, nthreads, sense,
+					 strings);
+	else
+	    S_sort_key_radix(keys, nmemb, aux, sense, strings);
+    }
+#else
+    S_sort_key_radix(keys, nmemb, aux, sense, strings);
+#endif
+
+    for (i = 0; i < nmemb; i++)
+	array[i] = sorted[i].sv;
+    Safefree(aux);
+    Safefree(keys);
+    return TRUE;
+}
+
+#endif /* PERL_SORT_KEYS */
+
 /*
 =head1 Array Manipulation Functions
 
@@ -1458,15 +1895,361 @@ Perl_sortsv_flags(pTHX_ SV **array, size_t nmemb, SVCOMPARE_t cmp, U32 flags)
 {
     PERL_ARGS_ASSERT_SORTSV_FLAGS;
 
+#ifdef PERL_SORT_KEYS
+    if (S_sortsv_keyed(aTHX_ array, nmemb, cmp, flags))
+	return;
+#endif
     if (flags & SORTf_QSORT)
 	S_qsortsv(aTHX_ array, nmemb, cmp, flags);
     else
 	S_mergesortsv(aTHX_ array, nmemb, cmp, flags);
 }
 
-#define SvNSIOK(sv) ((SvFLAGS(sv) & SVf_NOK) || ((SvFLAGS(sv) & (SVf_IOK|SVf_IVisUV)) == SVf_IOK))
-#define SvSIOK(sv) ((SvFLAGS(sv) & (SVf_IOK|SVf_IVisUV)) == SVf_IOK)
-#define SvNSIV(sv) ( SvNOK(sv) ? SvNVX(sv) : ( SvSIOK(sv) ? SvIVX(sv) : sv_2nv(sv) ) )
+/* The optimiser sets OPpSORT_LIMIT (and the limit in op_targ) when only
+ * the first few elements of the sorted list can be used, as in
+ * (sort @a)[0..9] or my ($min) = sort @a.  Then we only need to find
+ * which elements make up that prefix and sort those.
+ *
+ * A bounded heap holds the best limit elements seen so far, ordered by
+ * comparison result and then by original position, so its root is the
+ * element a stable sort would put last among them.  A later element only
+ * displaces the root if it compares strictly before it.  The survivors
+ * are then put back in their original order and sorted normally, which
+ * gives exactly the prefix a full stable sort would have produced.
+ */
+
+#define SORT_LIMIT_MIN 64
+
+typedef struct {
+    SV *sv;
+    SSize_t ix;
+} sort_top;
+
+/* does a sort before b? */
+
+STATIC bool
+S_sort_top_before(pTHX_ const sort_top *a, const sort_top *b,
+		  SVCOMPARE_t cmp, U32 flags)
+{
+    I32 c = cmp(aTHX_ a->sv, b->sv);
+    if (flags & SORTf_DESC)
+	c = -c;
+    return c < 0 || (c == 0 && a->ix < b->ix);
+}
+
+STATIC void
+S_sort_top_sift(pTHX_ sort_top *heap, SSize_t n, SSize_t i,
+		SVCOMPARE_t cmp, U32 flags)
+{
+    const sort_top item = heap[i];
+
+    for (;;) {
+	SSize_t child = 2 * i + 1;
+	if (child >= n)
+	    break;
+	if (child + 1 < n
+	    && S_sort_top_before(aTHX_ &heap[child], &heap[child + 1],
+				 cmp, flags))
+	    child++;
+	if (!S_sort_top_before(aTHX_ &item, &heap[child], cmp, flags))
+	    break;
+	heap[i] = heap[child];
+	i = child;
+    }
+    heap[i] = item;
+}
+
+/* Sort the first limit elements of array into place, and return how
+ * many elements of the result are meaningful. */
+
+STATIC SSize_t
+S_sortsv_limit(pTHX_ SV **array, SSize_t nmemb, SSize_t limit,
+	       SVCOMPARE_t cmp, U32 flags)
+{
+    sort_top *heap;
+    char *keep;
+    SSize_t i, j;
+
+    if (limit >= nmemb) {
+	sortsv_flags(array, nmemb, cmp, flags);
+	return nmemb;
+    }
+    /* a large prefix is no cheaper to select than to sort */
+    if (nmemb < SORT_LIMIT_MIN || limit > nmemb / 4) {
+	sortsv_flags(array, nmemb, cmp, flags);
+	return limit;
+    }
+
+    Newx(heap, limit, sort_top);
+    SAVEFREEPV(heap);
+    for (i = 0; i < limit; i++) {
+	heap[i].sv = array[i];
+	heap[i].ix = i;
+    }
+    for (i = limit / 2; i-- > 0; )
+	S_sort_top_sift(aTHX_ heap, limit, i, cmp, flags);
+
+    for (i = limit; i < nmemb; i++) {
+	/* i is after everything in the heap, so ties stay out */
+	I32 c = cmp(aTHX_ array[i], heap[0].sv);
+	if (flags & SORTf_DESC)
+	    c = -c;
+	if (c < 0) {
+	    heap[0].sv = array[i];
+	    heap[0].ix = i;
+	    S_sort_top_sift(aTHX_ heap, limit, 0, cmp, flags);
+	}
+    }
+
+    Newxz(keep, nmemb, char);
+    SAVEFREEPV(keep);
+    for (i = 0; i < limit; i++)
+	keep[heap[i].ix] = 1;
+    for (i = j = 0; i < nmemb; i++)
+	if (keep[i])
+	    array[j++] = array[i];
+
+    sortsv_flags(array, limit, cmp, flags);
+    return limit;
+}
+
+/* The compiler sets OPpCMP_SORTKEY on the comparison in sort blocks
+ * like { $h{$a} <=> $h{$b} } or { lc($b) cmp lc($a) }, where the same
+ * side-effect free expression of $a and $b is compared.  Rather than
+ * run the block O(n log n) times, we run it once for each pair of
+ * elements, stopping just before the comparison, which leaves the keys
+ * of both elements on the stack; then sort the elements by comparing
+ * their keys directly.
+ *
+ * Keys which the comparison would warn about or which are overloaded
+ * make us fall back to running the block in the usual way.
+ */
+
+typedef struct {
+    SV *key;
+    SV *sv;
+} sort_bykey;
+
+static I32
+S_cmp_bykey(pTHX_ SV *const a, SV *const b)
+{
+    return PL_sort_RealCmp(aTHX_ ((sort_bykey *)a)->key,
+			   ((sort_bykey *)b)->key);
+}
+
+static I32
+S_cmp_bykey_desc(pTHX_ SV *const a, SV *const b)
+{
+    return PL_sort_RealCmp(aTHX_ ((sort_bykey *)b)->key,
+			   ((sort_bykey *)a)->key);
+}
+
+static I32
+S_ncmp_bykey(pTHX_ SV *const a, SV *const b)
+{
+    return do_ncmp(a, b);	/* the keys are known not to be NaN */
+}
+
+/* Run the sort block with $a and $b set to a and b until it gets to the
+ * comparison cmpop, and return the two values it is about to compare */
+
+static bool
+S_sort_key_pair(pTHX_ SV *a, SV *b, const OP *cmpop, SV **first,
+		SV **second)
+{
+    const I32 oldsaveix = PL_savestack_ix;
+    const I32 oldscopeix = PL_scopestack_ix;
+    PMOP * const pm = PL_curpm;
+    OP * const sortop = PL_op;
+    COP * const cop = PL_curcop;
+    bool ok;
+
+    GvSV(PL_firstgv) = a;
+    GvSV(PL_secondgv) = b;
+    PL_stack_sp = PL_stack_base;
+    PL_op = PL_sortcop;
+    do {
+	PL_op = PL_op->op_ppaddr(aTHX);
+    } while (PL_op && PL_op != cmpop);
+    ok = PL_op && PL_stack_sp == PL_stack_base + 2;
+    if (ok) {
+	*first = PL_stack_base[1];
+	*second = PL_stack_base[2];
+	/* targets get reused on the next run */
+	if (SvPADTMP(*first))
+	    *first = sv_mortalcopy(*first);
+	if (SvPADTMP(*second))
+	    *second = sv_mortalcopy(*second);
+    }
+    PL_op = sortop;
+    PL_curcop = cop;
+    while (PL_scopestack_ix > oldscopeix) {
+	LEAVE;
+    }
+    leave_scope(oldsaveix);
+    PL_curpm = pm;
+    return ok;
+}
+
+/* Sort array by key, as described above.  Returns false if the block
+ * has to be run as usual instead. */
+
+static bool
+S_sortsv_bykey(pTHX_ SV **array, SSize_t *nmemb, SSize_t limit,
+	       const OP *cmpop, U32 flags)
+{
+    const SSize_t n = *nmemb;
+    const bool desc = cBOOL(cmpop->op_private & OPpCMP_KEYDESC);
+    SVCOMPARE_t cmp;
+    SVCOMPARE_t savecmp;
+    sort_bykey *keys;
+    sort_bykey **ptrs;
+    SSize_t i;
+
+    /* the block would warn about these, or call magic more often */
+    for (i = 0; i < n; i++)
+	if (!SvOK(array[i]) || SvGMAGICAL(array[i]))
+	    return FALSE;
+
+    Newx(keys, n, sort_bykey);
+    SAVEFREEPV(keys);
+    for (i = 0; i < n; i += 2) {
+	const SSize_t j = i + 1 < n ? i + 1 : i;
+	SV *ka, *kb;
+	if (!S_sort_key_pair(aTHX_ array[i], array[j], cmpop,
+			     desc ? &kb : &ka, desc ? &ka : &kb))
+	    return FALSE;
+	keys[i].sv = array[i];
+	keys[i].key = ka;
+	keys[j].sv = array[j];
+	keys[j].key = kb;
+    }
+
+    for (i = 0; i < n; i++) {
+	SV * const key = keys[i].key;
+	if (!SvOK(key) || SvMAGICAL(key) || SvAMAGIC(key))
+	    return FALSE;
+	if (cmpop->op_type != OP_SCMP) {
+	    if (!SvNIOK(key)) {
+		if (!looks_like_number(key))
+		    return FALSE;
+		(void)SvNV_nomg(key);
+	    }
+	    /* <=> returns undef for NaNs */
+	    if (SvNOK(key) && cmpop->op_type == OP_NCMP) {
+		const NV nv = SvNVX(key);
+#if defined(NAN_COMPARE_BROKEN) && defined(Perl_isnan)
+		if (Perl_isnan(nv))
+#else
+		if (nv != nv)
+#endif
+		    return FALSE;
+	    }
+	}
+    }
+
+    switch (cmpop->op_type) {
+    case OP_NCMP:
+	cmp = S_ncmp_bykey;
+	break;
+    case OP_I_NCMP:
+	cmp = S_sv_i_ncmp;
+	break;
+    default:
+#ifdef USE_LOCALE_COLLATE
+	if (IN_LC_RUNTIME(LC_COLLATE))
+	    cmp = (SVCOMPARE_t)sv_cmp_locale_static;
+	else
+#endif
+	    cmp = (SVCOMPARE_t)sv_cmp_static;
+	break;
+    }
+
+    Newx(ptrs, n, sort_bykey *);
+    SAVEFREEPV(ptrs);
+    for (i = 0; i < n; i++)
+	ptrs[i] = &keys[i];
+    savecmp = PL_sort_RealCmp;
+    PL_sort_RealCmp = cmp;
+    if (limit)
+	*nmemb = S_sortsv_limit(aTHX_ (SV **)ptrs, n, limit,
+				desc ? S_cmp_bykey_desc : S_cmp_bykey, flags);
+    else
+	sortsv_flags((SV **)ptrs, n, desc ? S_cmp_bykey_desc : S_cmp_bykey,
+		     flags);
+    PL_sort_RealCmp = savecmp;
+    for (i = 0; i < *nmemb; i++)
+	array[i] = ptrs[i]->sv;
+    return TRUE;
+}
+
+/* "sort keys %h" (see rpeep): the keys op has been taken out of the
+ * execution chain, so the hash itself is on the stack.  Replace it with
+ * its keys.  For a plain hash and a plain string comparison the keys'
+ * HEKs are sorted first, and the key SVs are only made afterwards, in
+ * order; the return value says whether that was done. */
+
+static I32
+S_sort_hek_cmp(pTHX_ SV *const a, SV *const b)
+{
+    const HEK * const ha = (const HEK *)a;
+    const HEK * const hb = (const HEK *)b;
+    const I32 la = HEK_LEN(ha);
+    const I32 lb = HEK_LEN(hb);
+
+    if (HEK_UTF8(ha) == HEK_UTF8(hb)) {
+	const int r = memcmp(HEK_KEY(ha), HEK_KEY(hb), la < lb ? la : lb);
+	if (r)
+	    return r < 0 ? -1 : 1;
+	return la < lb ? -1 : la > lb;
+    }
+    else {
+	const int r = HEK_UTF8(hb)
+	    ?  bytes_cmp_utf8((const U8 *)HEK_KEY(ha), la,
+			      (const U8 *)HEK_KEY(hb), lb)
+	    : -bytes_cmp_utf8((const U8 *)HEK_KEY(hb), lb,
+			      (const U8 *)HEK_KEY(ha), la);
+	return r < 0 ? -1 : r > 0;
+    }
+}
+
+static bool
+S_sort_hv_keys(pTHX_ U32 flags)
+{
+    dSP;
+    HV * const hv = MUTABLE_HV(POPs);
+    HE *entry;
+    HEK **heks;
+    SSize_t i, n;
+
+    (void)hv_iterinit(hv);
+
+    if (SvRMAGICAL(hv) || IN_BYTES
+#ifdef USE_LOCALE_COLLATE
+	|| IN_LC_RUNTIME(LC_COLLATE)
+#endif
+	) {
+	/* as pp_keys would have */
+	EXTEND(SP, HvUSEDKEYS(hv));
+	while ((entry = hv_iternext(hv)))
+	    XPUSHs(hv_iterkeysv(entry));
+	PUTBACK;
+	return FALSE;
+    }
+
+    n = HvUSEDKEYS(hv);
+    Newx(heks, n, HEK *);
+    SAVEFREEPV(heks);
+    for (i = 0; i < n && (entry = hv_iternext(hv)); i++)
+	heks[i] = HeKEY_hek(entry);
+    n = i;
+    sortsv_flags((SV **)heks, n, S_sort_hek_cmp, flags);
+    EXTEND(SP, n);
+    for (i = 0; i < n; i++)
+	PUSHs(sv_2mortal(newSVhek(heks[i])));
+    PUTBACK;
+    return TRUE;
+}
 
 PP(pp_sort)
 {
@@ -1489,6 +2272,9 @@ PP(pp_sort)
     void (*sortsvp)(pTHX_ SV **array, size_t nmemb, SVCOMPARE_t cmp, U32 flags)
       = Perl_sortsv_flags;
     I32 all_SIVs = 1;
+    SSize_t limit = 0;
+    const OP *keycmp = NULL;
+    bool presorted = FALSE;
 
     if ((priv & OPpSORT_DESCEND) != 0)
 	sort_flags |= SORTf_DESC;
@@ -1502,14 +2288,25 @@ PP(pp_sort)
 	EXTEND(SP,1);
 	RETPUSHUNDEF;
     }
+    /* only the first op_targ elements of the result will be used */
+    if ((priv & (OPpSORT_LIMIT|OPpSORT_REVERSE|OPpSORT_INPLACE))
+	== OPpSORT_LIMIT)
+	limit = PL_op->op_targ;
 
     ENTER;
     SAVEVPTR(PL_sortcop);
     if (flags & OPf_STACKED) {
 	if (flags & OPf_SPECIAL) {
             OP *nullop = OpSIBLING(cLISTOP->op_first);  /* pass pushmark */
+            const OP *scope = cUNOPx(nullop)->op_first;
             assert(nullop->op_type == OP_NULL);
 	    PL_sortcop = nullop->op_next;
+	    if (scope->op_type == OP_SCOPE
+	     && (cLISTOPx(scope)->op_last->op_private & OPpCMP_SORTKEY)
+	     && (   cLISTOPx(scope)->op_last->op_type == OP_NCMP
+		 || cLISTOPx(scope)->op_last->op_type == OP_I_NCMP
+		 || cLISTOPx(scope)->op_last->op_type == OP_SCMP))
+		keycmp = cLISTOPx(scope)->op_last;
 	}
 	else {
 	    GV *autogv = NULL;
@@ -1593,6 +2390,16 @@ PP(pp_sort)
 	}
     }
     else {
+	const OP * const kid = OpSIBLING(cLISTOP->op_first);
+	if (!(flags & OPf_STACKED) && kid
+	 && kid->op_type == OP_NULL && kid->op_targ == OP_KEYS)
+	{
+	    PUTBACK;
+	    presorted = S_sort_hv_keys(aTHX_ sort_flags);
+	    SPAGAIN;
+	    MARK = ORIGMARK;
+	    p1 = MARK+1;
+	}
 	p2 = MARK+1;
 	max = SP - MARK;
    }
@@ -1696,7 +2503,15 @@ PP(pp_sort)
 	    cx->cx_type |= CXp_MULTICALL;
 	    
 	    start = p1 - max;
-	    sortsvp(aTHX_ start, max,
+	    if (keycmp
+		&& S_sortsv_bykey(aTHX_ start, &max, limit, keycmp, sort_flags))
+		NOOP;
+	    else if (limit)
+		max = S_sortsv_limit(aTHX_ start, max, limit,
+		    (is_xsub ? S_sortcv_xsub : hasargs ? S_sortcv_stacked : S_sortcv),
+		    sort_flags);
+	    else
+		sortsvp(aTHX_ start, max,
 		    (is_xsub ? S_sortcv_xsub : hasargs ? S_sortcv_stacked : S_sortcv),
 		    sort_flags);
 
@@ -1714,9 +2529,7 @@ PP(pp_sort)
 	    CATCH_SET(oldcatch);
 	}
 	else {
-	    MEXTEND(SP, 20);	/* Can't afford stack realloc on signal. */
-	    start = sorting_av ? AvARRAY(av) : ORIGMARK+1;
-	    sortsvp(aTHX_ start, max,
+	    const SVCOMPARE_t cmp =
 		    (priv & OPpSORT_NUMERIC)
 		        ? ( ( ( priv & OPpSORT_INTEGER) || all_SIVs)
 			    ? ( overloading ? S_amagic_i_ncmp : S_sv_i_ncmp)
@@ -1729,8 +2542,16 @@ PP(pp_sort)
 				: (SVCOMPARE_t)sv_cmp_locale_static)
                             :
 #endif
-			      ( overloading ? (SVCOMPARE_t)S_amagic_cmp : (SVCOMPARE_t)sv_cmp_static)),
-		    sort_flags);
+			      ( overloading ? (SVCOMPARE_t)S_amagic_cmp : (SVCOMPARE_t)sv_cmp_static));
+
+	    MEXTEND(SP, 20);	/* Can't afford stack realloc on signal. */
+	    start = sorting_av ? AvARRAY(av) : ORIGMARK+1;
+	    if (presorted)
+		NOOP;
+	    else if (limit)
+		max = S_sortsv_limit(aTHX_ start, max, limit, cmp, sort_flags);
+	    else
+		sortsvp(aTHX_ start, max, cmp, sort_flags);
 	}
 	if ((priv & OPpSORT_REVERSE) != 0) {
 	    SV **q = start+max-1;
@@ -2602,6 +2602,12 @@ PERL_CALLCONV int	Perl_magic_setsig(pTHX_ SV* sv, MAGIC* mg)
 #define PERL_ARGS_ASSERT_MAGIC_SETSIG	\
 	assert(mg)
 
+PERL_CALLCONV int	Perl_magic_setstudy(pTHX_ SV* sv, MAGIC* mg)
+			__attribute__nonnull__(pTHX_1)
+			__attribute__nonnull__(pTHX_2);
+#define PERL_ARGS_ASSERT_MAGIC_SETSTUDY	\
+	assert(sv); assert(mg)
+
 PERL_CALLCONV int	Perl_magic_setsubstr(pTHX_ SV* sv, MAGIC* mg)
 			__attribute__nonnull__(pTHX_1)
 			__attribute__nonnull__(pTHX_2);
@@ -3657,6 +3663,13 @@ PERL_CALLCONV struct refcounted_he *	Perl_refcounted_he_new_sv(pTHX_ struct refc
 #define PERL_ARGS_ASSERT_REFCOUNTED_HE_NEW_SV	\
 	assert(key)
 
+PERL_CALLCONV void	Perl_reg_cache_free(pTHX);
+PERL_CALLCONV void	Perl_reg_cache_resize(pTHX_ const U32 size);
+PERL_CALLCONV SV*	Perl_reg_freeze(pTHX_ REGEXP * const rx)
+			__attribute__nonnull__(pTHX_1);
+#define PERL_ARGS_ASSERT_REG_FREEZE	\
+	assert(rx)
+
 PERL_CALLCONV SV*	Perl_reg_named_buff(pTHX_ REGEXP * const rx, SV * const key, SV * const value, const U32 flags)
 			__attribute__nonnull__(pTHX_1);
 #define PERL_ARGS_ASSERT_REG_NAMED_BUFF	\
@@ -3725,6 +3738,11 @@ PERL_CALLCONV REGEXP*	Perl_reg_temp_copy(pTHX_ REGEXP* ret_x, REGEXP* rx)
 #define PERL_ARGS_ASSERT_REG_TEMP_COPY	\
 	assert(rx)
 
+PERL_CALLCONV REGEXP*	Perl_reg_thaw(pTHX_ const char *pv, const STRLEN len)
+			__attribute__nonnull__(pTHX_1);
+#define PERL_ARGS_ASSERT_REG_THAW	\
+	assert(pv)
+
 PERL_CALLCONV SV*	Perl_regclass_swash(pTHX_ const regexp *prog, const struct regnode *node, bool doinit, SV **listsvp, SV **altsvp)
 			__attribute__nonnull__(pTHX_2);
 #define PERL_ARGS_ASSERT_REGCLASS_SWASH	\
@@ -4132,6 +4150,14 @@ PERL_CALLCONV NV	Perl_str_to_version(pTHX_ SV *sv)
 #define PERL_ARGS_ASSERT_STR_TO_VERSION	\
 	assert(sv)
 
+PERL_CALLCONV char*	Perl_study_instr(pTHX_ SV* bigsv, unsigned char* big, unsigned char* bigend, SV* littlestr, U32 flags)
+			__attribute__warn_unused_result__
+			__attribute__nonnull__(pTHX_2)
+			__attribute__nonnull__(pTHX_3)
+			__attribute__nonnull__(pTHX_4);
+#define PERL_ARGS_ASSERT_STUDY_INSTR	\
+	assert(big); assert(bigend); assert(littlestr)
+
 PERL_CALLCONV void	Perl_sub_crush_depth(pTHX_ CV* cv)
 			__attribute__nonnull__(pTHX_1);
 #define PERL_ARGS_ASSERT_SUB_CRUSH_DEPTH	\
@@ -4275,6 +4301,14 @@ PERL_CALLCONV void	Perl_sv_catpvf_mg(pTHX_ SV *const sv, const char *const pat,
 #define PERL_ARGS_ASSERT_SV_CATPVF_MG	\
 	assert(sv); assert(pat)
 
+PERL_CALLCONV void	Perl_sv_catpvfn_fast(pTHX_ SV *const sv, const char *const pat, const STRLEN patlen, const SV *const steps, SV **const svargs, const I32 svmax)
+			__attribute__nonnull__(pTHX_1)
+			__attribute__nonnull__(pTHX_2)
+			__attribute__nonnull__(pTHX_4)
+			__attribute__nonnull__(pTHX_5);
+#define PERL_ARGS_ASSERT_SV_CATPVFN_FAST	\
+	assert(sv); assert(pat); assert(steps); assert(svargs)
+
 /* PERL_CALLCONV void	Perl_sv_catpvn(pTHX_ SV *dsv, const char *sstr, STRLEN len)
 			__attribute__nonnull__(pTHX_1)
 			__attribute__nonnull__(pTHX_2); */
@@ -4412,6 +4446,11 @@ PERL_CALLCONV void	Perl_sv_dump(pTHX_ SV* sv)
 
 /* PERL_CALLCONV I32	sv_eq(pTHX_ SV* sv1, SV* sv2); */
 PERL_CALLCONV I32	Perl_sv_eq_flags(pTHX_ SV* sv1, SV* sv2, const U32 flags);
+PERL_CALLCONV SV*	Perl_sv_fast_format_compile(pTHX_ const char *const pat, const STRLEN patlen)
+			__attribute__nonnull__(pTHX_1);
+#define PERL_ARGS_ASSERT_SV_FAST_FORMAT_COMPILE	\
+	assert(pat)
+
 /* PERL_CALLCONV void	Perl_sv_force_normal(pTHX_ SV *sv)
 			__attribute__nonnull__(pTHX_1); */
 #define PERL_ARGS_ASSERT_SV_FORCE_NORMAL	\
@@ -5765,6 +5804,35 @@ PERL_CALLCONV SV*	Perl_sv_setsv_cow(pTHX_ SV* dstr, SV* sstr)
 
 #endif
 #if defined(PERL_CORE)
+PERL_STATIC_INLINE STRLEN	S_change_case_ascii_run(U8 *d, const U8 *s, const U8 * const e, const bool to_upper)
+			__attribute__warn_unused_result__
+			__attribute__nonnull__(1)
+			__attribute__nonnull__(2)
+			__attribute__nonnull__(3);
+#define PERL_ARGS_ASSERT_CHANGE_CASE_ASCII_RUN	\
+	assert(d); assert(s); assert(e)
+
+PERL_STATIC_INLINE STRLEN	S_count_bits(const U8 *s, const U8 * const e)
+			__attribute__warn_unused_result__
+			__attribute__nonnull__(1)
+			__attribute__nonnull__(2);
+#define PERL_ARGS_ASSERT_COUNT_BITS	\
+	assert(s); assert(e)
+
+PERL_STATIC_INLINE STRLEN	S_count_byte(const U8 *s, const U8 * const e, const U8 c)
+			__attribute__warn_unused_result__
+			__attribute__nonnull__(1)
+			__attribute__nonnull__(2);
+#define PERL_ARGS_ASSERT_COUNT_BYTE	\
+	assert(s); assert(e)
+
+PERL_STATIC_INLINE const U8 *	S_find_first_variant(const U8 *s, const U8 * const e)
+			__attribute__warn_unused_result__
+			__attribute__nonnull__(1)
+			__attribute__nonnull__(2);
+#define PERL_ARGS_ASSERT_FIND_FIRST_VARIANT	\
+	assert(s); assert(e)
+
 PERL_CALLCONV void	Perl_opslab_force_free(pTHX_ OPSLAB *slab)
 			__attribute__nonnull__(pTHX_1);
 #define PERL_ARGS_ASSERT_OPSLAB_FORCE_FREE	\
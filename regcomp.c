@@ -191,6 +191,7 @@ struct RExC_state_t {
     scan_frame *frame_last;
     U32         frame_count;
     U32         strict;
+    bool        warned;                 /* has it given a warning? */
 #ifdef ADD_TO_REGEXEC
     char 	*starttry;		/* -Dr: where regtry was called. */
 #define RExC_starttry	(pRExC_state->starttry)
@@ -261,6 +262,7 @@ struct RExC_state_t {
 #define RExC_frame_last (pRExC_state->frame_last)
 #define RExC_frame_count (pRExC_state->frame_count)
 #define RExC_strict (pRExC_state->strict)
+#define RExC_warned (pRExC_state->warned)
 
 /* Heuristic check on the complexity of the pattern: if TOO_NAUGHTY, we set
  * a flag to disable back-off on the fixed/floating substrings - if it's
@@ -641,30 +643,35 @@ static const scan_data_t zero_scan_data =
 /* m is not necessarily a "literal string", in this macro */
 #define reg_warn_non_literal_string(loc, m) STMT_START {                \
     const IV offset = loc - RExC_precomp;                               \
+    RExC_warned = TRUE;                                                 \
     __ASSERT_(PASS2) Perl_warner(aTHX_ packWARN(WARN_REGEXP), "%s" REPORT_LOCATION,      \
             m, REPORT_LOCATION_ARGS(offset));       \
 } STMT_END
 
 #define	ckWARNreg(loc,m) STMT_START {					\
     const IV offset = loc - RExC_precomp;				\
+    RExC_warned = TRUE;                                                 \
     __ASSERT_(PASS2) Perl_ck_warner(aTHX_ packWARN(WARN_REGEXP), m REPORT_LOCATION,	\
 	    REPORT_LOCATION_ARGS(offset));		\
 } STMT_END
 
 #define	vWARN(loc, m) STMT_START {				        \
     const IV offset = loc - RExC_precomp;				\
+    RExC_warned = TRUE;                                                 \
     __ASSERT_(PASS2) Perl_warner(aTHX_ packWARN(WARN_REGEXP), m REPORT_LOCATION,	\
 	    REPORT_LOCATION_ARGS(offset));	        \
 } STMT_END
 
 #define	vWARN_dep(loc, m) STMT_START {				        \
     const IV offset = loc - RExC_precomp;				\
+    RExC_warned = TRUE;                                                 \
     __ASSERT_(PASS2) Perl_warner(aTHX_ packWARN(WARN_DEPRECATED), m REPORT_LOCATION,	\
 	    REPORT_LOCATION_ARGS(offset));	        \
 } STMT_END
 
 #define	ckWARNdep(loc,m) STMT_START {				        \
     const IV offset = loc - RExC_precomp;				\
+    RExC_warned = TRUE;                                                 \
     __ASSERT_(PASS2) Perl_ck_warner_d(aTHX_ packWARN(WARN_DEPRECATED),	                \
 	    m REPORT_LOCATION,						\
 	    REPORT_LOCATION_ARGS(offset));		\
@@ -672,6 +679,7 @@ static const scan_data_t zero_scan_data =
 
 #define	ckWARNregdep(loc,m) STMT_START {				\
     const IV offset = loc - RExC_precomp;				\
+    RExC_warned = TRUE;                                                 \
     __ASSERT_(PASS2) Perl_ck_warner_d(aTHX_ packWARN2(WARN_DEPRECATED, WARN_REGEXP),	\
 	    m REPORT_LOCATION,						\
 	    REPORT_LOCATION_ARGS(offset));		\
@@ -679,6 +687,7 @@ static const scan_data_t zero_scan_data =
 
 #define	ckWARN2reg_d(loc,m, a1) STMT_START {				\
     const IV offset = loc - RExC_precomp;				\
+    RExC_warned = TRUE;                                                 \
     __ASSERT_(PASS2) Perl_ck_warner_d(aTHX_ packWARN(WARN_REGEXP),			\
 	    m REPORT_LOCATION,						\
 	    a1, REPORT_LOCATION_ARGS(offset));	\
@@ -686,36 +695,42 @@ static const scan_data_t zero_scan_data =
 
 #define	ckWARN2reg(loc, m, a1) STMT_START {				\
     const IV offset = loc - RExC_precomp;				\
+    RExC_warned = TRUE;                                                 \
     __ASSERT_(PASS2) Perl_ck_warner(aTHX_ packWARN(WARN_REGEXP), m REPORT_LOCATION,	\
 	    a1, REPORT_LOCATION_ARGS(offset));	\
 } STMT_END
 
 #define	vWARN3(loc, m, a1, a2) STMT_START {				\
     const IV offset = loc - RExC_precomp;				\
+    RExC_warned = TRUE;                                                 \
     __ASSERT_(PASS2) Perl_warner(aTHX_ packWARN(WARN_REGEXP), m REPORT_LOCATION,		\
 	    a1, a2, REPORT_LOCATION_ARGS(offset));	\
 } STMT_END
 
 #define	ckWARN3reg(loc, m, a1, a2) STMT_START {				\
     const IV offset = loc - RExC_precomp;				\
+    RExC_warned = TRUE;                                                 \
     __ASSERT_(PASS2) Perl_ck_warner(aTHX_ packWARN(WARN_REGEXP), m REPORT_LOCATION,	\
 	    a1, a2, REPORT_LOCATION_ARGS(offset));	\
 } STMT_END
 
 #define	vWARN4(loc, m, a1, a2, a3) STMT_START {				\
     const IV offset = loc - RExC_precomp;				\
+    RExC_warned = TRUE;                                                 \
     __ASSERT_(PASS2) Perl_warner(aTHX_ packWARN(WARN_REGEXP), m REPORT_LOCATION,		\
 	    a1, a2, a3, REPORT_LOCATION_ARGS(offset)); \
 } STMT_END
 
 #define	ckWARN4reg(loc, m, a1, a2, a3) STMT_START {			\
     const IV offset = loc - RExC_precomp;				\
+    RExC_warned = TRUE;                                                 \
     __ASSERT_(PASS2) Perl_ck_warner(aTHX_ packWARN(WARN_REGEXP), m REPORT_LOCATION,	\
 	    a1, a2, a3, REPORT_LOCATION_ARGS(offset)); \
 } STMT_END
 
 #define	vWARN5(loc, m, a1, a2, a3, a4) STMT_START {			\
     const IV offset = loc - RExC_precomp;				\
+    RExC_warned = TRUE;                                                 \
     __ASSERT_(PASS2) Perl_warner(aTHX_ packWARN(WARN_REGEXP), m REPORT_LOCATION,		\
 	    a1, a2, a3, a4, REPORT_LOCATION_ARGS(offset)); \
 } STMT_END
@@ -803,6 +818,9 @@ static const scan_data_t zero_scan_data =
             if (RExC_seen & REG_GPOS_SEEN)                                  \
                 PerlIO_printf(Perl_debug_log,"REG_GPOS_SEEN ");             \
                                                                             \
+            if (RExC_seen & REG_LOOKAHEAD_SEEN)                             \
+                PerlIO_printf(Perl_debug_log,"REG_LOOKAHEAD_SEEN ");        \
+                                                                            \
             if (RExC_seen & REG_CANY_SEEN)                                  \
                 PerlIO_printf(Perl_debug_log,"REG_CANY_SEEN ");             \
                                                                             \
@@ -4734,6 +4752,7 @@ S_study_chunk(pTHX_ RExC_state_t *pRExC_state, regnode **scanp,
 		{
 		    /* Fatal warnings may leak the regexp without this: */
 		    SAVEFREESV(RExC_rx_sv);
+		    RExC_warned = TRUE;
 		    Perl_ck_warner(aTHX_ packWARN(WARN_REGEXP),
 			"Quantifier unexpected on zero-length expression "
 			"in regex m/%"UTF8f"/",
@@ -6328,6 +6347,229 @@ S_setup_longest(pTHX_ RExC_state_t *pRExC_state, SV* sv_longest,
     return TRUE;
 }
 
+/*
+ - Compiled pattern cache
+
+ The pattern of an op like m/$re/ is only recompiled when its string
+ differs from the one the op last saw, but code which runs one op over
+ several patterns in turn still compiles on nearly every match.  So
+ Perl_re_op_compile() keeps the last PL_reg_cache->size patterns it
+ compiled at run time in PL_reg_cache, keyed on the pattern string and
+ everything else the compiled program depends on, and on a hit returns
+ a reg_temp_copy() of the one it has, as m/$qr/ does.  The least
+ recently used entry goes when a new one needs the room.
+
+ The warnings in effect are part of the key, as they decide what
+ compiling the pattern says.  Patterns with code blocks aren't kept, nor
+ are ones which gave a warning when compiled, so that each op still
+ gives it, nor are ones with \N{...} or \p{...}, whose meanings depend
+ on the scope they are compiled in, nor the empty pattern, which means
+ the last one matched, nor those of m//o, which pp_regcomp() doesn't see
+ again.  Under "use re 'debug'" nothing is cached, so each compilation
+ is shown.  re::regcache_stats() and re::regcache_size() report on and
+ size the cache.
+*/
+
+/* The most steps a match of a pattern compiled now may take, under
+ * "use re steps => N"; or 0 */
+
+static UV
+S_reg_steps_hint(pTHX)
+{
+    SV * const sv = cop_hints_fetch_pvs(PL_curcop, "re_steps", 0);
+    return sv != &PL_sv_placeholder && SvOK(sv) ? SvUV(sv) : 0;
+}
+
+/* Whether patterns compiled now count what matching them costs, under
+ * "use re 'stats'" */
+
+#define REG_STATS_HINT \
+    (cop_hints_fetch_pvs(PL_curcop, "re_stats", 0) != &PL_sv_placeholder)
+
+/* Return new, zeroed counts for the program of rx, in PL_reg_stats */
+
+static reg_stats *
+S_reg_stats_new(pTHX_ REGEXP * const rx)
+{
+    reg_stats *stats;
+
+    Newxz(stats, 1, reg_stats);
+    stats->rx = rx;
+    stats->next = PL_reg_stats;
+    if (PL_reg_stats)
+	PL_reg_stats->prev = stats;
+    PL_reg_stats = stats;
+    return stats;
+}
+
+#ifndef PERL_IN_XSUB_RE
+
+/* Return a new key for the pattern exp[0..plen) compiled with the other
+ * things given, or NULL if it shouldn't be cached */
+
+static SV *
+S_reg_cache_key(pTHX_ const regexp_engine *eng, const char *exp,
+		const STRLEN plen, const bool utf8, const U32 rx_flags,
+		const U32 pm_flags)
+{
+    struct {
+	const regexp_engine *eng;
+	U32 rx_flags;
+	U32 pm_flags;
+	UV steps;
+	bool utf8;
+	bool jit;
+	bool stats;
+    } head;
+    const char *s = exp;
+    const char * const e = exp + plen;
+    SV *key;
+
+    while ((s = (const char *)memchr(s, '\\', e - s)) && ++s < e) {
+	if (*s == 'N' || *s == 'p' || *s == 'P')
+	    return NULL;
+	s++;
+    }
+
+    Zero(&head, 1, head);
+    head.eng = eng;
+    head.rx_flags = rx_flags;
+    head.pm_flags = pm_flags;
+    head.utf8 = utf8;
+    head.jit = cop_hints_fetch_pvs(PL_curcop, "re_jit", 0)
+	       != &PL_sv_placeholder;
+    head.steps = S_reg_steps_hint(aTHX);
+    head.stats = REG_STATS_HINT;
+    key = newSV(sizeof(head) + plen);
+    sv_setpvn(key, (char *)&head, sizeof(head));
+
+    /* then the warnings, which compiling may give, in a form which says
+     * where it ends */
+    {
+	const STRLEN * const warnings = PL_curcop->cop_warnings;
+	U8 tag[2];
+	tag[0] = PL_dowarn;
+	tag[1] = specialWARN(warnings) ? (U8)PTR2UV(warnings) : 0xFF;
+	sv_catpvn(key, (char *)tag, sizeof(tag));
+	if (!specialWARN(warnings))
+	    sv_catpvn(key, (const char *)warnings,
+		      sizeof(*warnings) + *warnings);
+    }
+
+    sv_catpvn(key, exp, plen);
+    return key;
+}
+
+/* Return the cached pattern with this key, or NULL */
+
+static REGEXP *
+S_reg_cache_fetch(pTHX_ SV *key, U32 *hashp)
+{
+    reg_cache *cache = PL_reg_cache;
+    const char * const k = SvPVX_const(key);
+    const STRLEN klen = SvCUR(key);
+    U32 hash;
+    U32 i;
+
+    PERL_HASH(hash, k, klen);
+    *hashp = hash;
+    if (!cache) {
+	Newxz(cache, 1, reg_cache);
+	cache->size = PERL_REG_CACHE_SIZE;
+	PL_reg_cache = cache;
+    }
+    for (i = 0; i < cache->count; i++) {
+	reg_cache_entry * const e = &cache->entries[i];
+	if (e->hash == hash && SvCUR(e->key) == klen
+	    && memEQ(SvPVX_const(e->key), k, klen))
+	{
+	    e->used = ++cache->tick;
+	    cache->hits++;
+	    return e->rx;
+	}
+    }
+    cache->misses++;
+    return NULL;
+}
+
+/* Keep rx under key, which it takes over, unless the cache is off.
+ * S_reg_cache_fetch() will have been called with the key first */
+
+static void
+S_reg_cache_store(pTHX_ SV *key, const U32 hash, REGEXP *rx)
+{
+    reg_cache * const cache = PL_reg_cache;
+    reg_cache_entry *e;
+
+    if (!cache->size) {
+	SvREFCNT_dec(key);
+	return;
+    }
+    if (cache->count < cache->size) {
+	if (!cache->entries)
+	    Newx(cache->entries, cache->size, reg_cache_entry);
+	e = &cache->entries[cache->count++];
+    }
+    else {
+	U32 i;
+	e = cache->entries;
+	for (i = 1; i < cache->count; i++)
+	    if (cache->entries[i].used < e->used)
+		e = &cache->entries[i];
+	SvREFCNT_dec(e->key);
+	ReREFCNT_dec(e->rx);
+    }
+    e->key = key;
+    e->hash = hash;
+    e->used = ++cache->tick;
+    e->rx = ReREFCNT_inc(rx);
+}
+
+/* Make the cache keep up to size patterns, dropping the least recently
+ * used ones if it has more */
+
+void
+Perl_reg_cache_resize(pTHX_ const U32 size)
+{
+    reg_cache *cache = PL_reg_cache;
+
+    if (!cache) {
+	Newxz(cache, 1, reg_cache);
+	cache->size = PERL_REG_CACHE_SIZE;
+	PL_reg_cache = cache;
+    }
+    while (cache->count > size) {
+	reg_cache_entry *e = cache->entries;
+	U32 i;
+	for (i = 1; i < cache->count; i++)
+	    if (cache->entries[i].used < e->used)
+		e = &cache->entries[i];
+	SvREFCNT_dec(e->key);
+	ReREFCNT_dec(e->rx);
+	*e = cache->entries[--cache->count];
+    }
+    if (size != cache->size) {
+	if (cache->entries)
+	    Renew(cache->entries, size ? size : 1, reg_cache_entry);
+	cache->size = size;
+    }
+}
+
+/* Free the cache and all it keeps */
+
+void
+Perl_reg_cache_free(pTHX)
+{
+    if (PL_reg_cache) {
+	reg_cache_resize(0);
+	Safefree(PL_reg_cache->entries);
+	Safefree(PL_reg_cache);
+	PL_reg_cache = NULL;
+    }
+}
+
+#endif /* PERL_IN_XSUB_RE */
+
 /*
  * Perl_re_op_compile - the perl internal RE engine's function to compile a
  * regular expression into internal code.
@@ -6389,6 +6631,10 @@ Perl_re_op_compile(pTHX_ SV ** const patternp, int pat_count,
     SV *pat;
     SV *code_blocksv = NULL;
     SV** new_patternp = patternp;
+#ifndef PERL_IN_XSUB_RE
+    SV *cache_key = NULL;       /* if it's to be cached, under this */
+    U32 cache_hash = 0;
+#endif
 
     /* these are all flags - maybe they should be turned
      * into a single int with different bit masks */
@@ -6547,6 +6793,7 @@ Perl_re_op_compile(pTHX_ SV ** const patternp, int pat_count,
     RExC_contains_locale = 0;
     RExC_contains_i = 0;
     RExC_strict = cBOOL(pm_flags & RXf_PMf_STRICT);
+    RExC_warned = FALSE;
     pRExC_state->runtime_code_qr = NULL;
     RExC_frame_head= NULL;
     RExC_frame_last= NULL;
@@ -6594,6 +6841,37 @@ Perl_re_op_compile(pTHX_ SV ** const patternp, int pat_count,
         return old_re;
     }
 
+#ifndef PERL_IN_XSUB_RE
+    /* or one compiled at run time not long ago; see "Compiled pattern
+     * cache" above.  (The pattern may have been upgraded to UTF-8 since
+     * the key was made, but it's the one we started with that counts.) */
+    if (   IN_PERL_RUNTIME
+        && !cache_key
+        && plen
+        && !runtime_code
+        && !pRExC_state->num_code_blocks
+        && !(pm_flags & (PMf_HAS_CV|PMf_KEEP))
+        && (cache_key = S_reg_cache_key(aTHX_ eng, exp, plen, RExC_utf8,
+                                        orig_rx_flags, pm_flags)))
+    {
+        REGEXP * const cached
+            = S_reg_cache_fetch(aTHX_ cache_key, &cache_hash);
+        if (cached) {
+            SvREFCNT_dec(cache_key);
+            Safefree(pRExC_state->code_blocks);
+            DEBUG_COMPILE_r(PerlIO_printf(Perl_debug_log,
+                                "Using cached REx\n"));
+            rx = reg_temp_copy(NULL, cached);
+#ifdef USE_ITHREADS
+            if (old_re && SvREADONLY(old_re))
+                SvREADONLY_on(rx);
+#endif
+            return rx;
+        }
+        sv_2mortal(cache_key);
+    }
+#endif
+
     rx_flags = orig_rx_flags;
 
     if (rx_flags & PMf_FOLD) {
@@ -6726,14 +7004,12 @@ Perl_re_op_compile(pTHX_ SV ** const patternp, int pat_count,
 	 char, regexp_internal);
     if ( r == NULL || ri == NULL )
 	FAIL("Regexp out of space");
-#ifdef DEBUGGING
-    /* avoid reading uninitialized memory in DEBUGGING code in study_chunk() */
+    /* bulk initialize base fields with 0, and the program too: this
+     * avoids reading uninitialized memory in DEBUGGING code in
+     * study_chunk(), and means that the unused bytes in nodes are the same
+     * each time a pattern is compiled, as reg_freeze() writes them */
     Zero(ri, sizeof(regexp_internal) + (unsigned)RExC_size * sizeof(regnode),
          char);
-#else
-    /* bulk initialize base fields with 0. */
-    Zero(ri, sizeof(regexp_internal), char);
-#endif
 
     /* non-zero initialization begins here */
     RXi_SET( r, ri );
@@ -7292,6 +7568,39 @@ Perl_re_op_compile(pTHX_ SV ** const patternp, int pat_count,
 	r->intflags |= PREGf_CUTGROUP_SEEN;
     if (pm_flags & PMf_USE_RE_EVAL)
 	r->intflags |= PREGf_USE_RE_EVAL;
+
+    /* Patterns that need none of the backtracking engine's extras are
+     * matched with a lazily built DFA; see "Lazy DFA" in regexec.c.  \b,
+     * \K and lookbehind all set REG_LOOKBEHIND_SEEN.  A pattern with
+     * captures (and so any with backreferences) would need regtry() to
+     * run after the DFA anyway, so gets nothing from it.  Only patterns
+     * whose matches can vary in length have anything to backtrack over,
+     * so the others are left to regmatch() too. */
+    if (! RExC_utf8
+        && ! LOC
+        && ! pRExC_state->num_code_blocks
+        && ! (RExC_seen & (REG_LOOKBEHIND_SEEN | REG_LOOKAHEAD_SEEN
+                           | REG_GPOS_SEEN
+                           | REG_RECURSE_SEEN | REG_GOSTART_SEEN
+                           | REG_VERBARG_SEEN | REG_CUTGROUP_SEEN)))
+    {
+        if (r->minlen != r->maxlen && ! r->nparens && ! RExC_sawback)
+            r->intflags |= PREGf_DFA;
+
+        /* and under "use re 'jit'", once hot, they are matched by a
+         * compiled version of the program; see "Compiled programs" in
+         * regexec.c */
+        if (cop_hints_fetch_pvs(PL_curcop, "re_jit", 0) != &PL_sv_placeholder)
+            r->intflags |= PREGf_JIT;
+    }
+
+    /* under "use re steps => N", matches croak after N steps */
+    ri->maxsteps = S_reg_steps_hint(aTHX);
+
+    /* under "use re 'stats'", matches count what they cost */
+    if (REG_STATS_HINT)
+        ri->stats = S_reg_stats_new(aTHX_ rx);
+
     if (RExC_paren_names)
         RXp_PAREN_NAMES(r) = MUTABLE_HV(SvREFCNT_inc(RExC_paren_names));
     else
@@ -7384,6 +7693,16 @@ Perl_re_op_compile(pTHX_ SV ** const patternp, int pat_count,
     });
 #endif
 
+#ifndef PERL_IN_XSUB_RE
+    if (cache_key && !RExC_warned) {
+        REGEXP * const compiled = rx;
+        S_reg_cache_store(aTHX_ SvREFCNT_inc_simple_NN(cache_key),
+                          cache_hash, compiled);
+        rx = reg_temp_copy(NULL, compiled);
+        ReREFCNT_dec(compiled);
+    }
+#endif
+
 #ifdef USE_ITHREADS
     /* under ithreads the ?pat? PMf_USED flag on the pmop is simulated
      * by setting the regexp SV to readonly-only instead. If the
@@ -10051,9 +10370,11 @@ S_reg(pTHX_ RExC_state_t *pRExC_state, I32 paren, I32 *flagp,U32 depth)
                 /* FALLTHROUGH */
 	    case '=':           /* (?=...) */
 		RExC_seen_zerolen++;
+                RExC_seen |= REG_LOOKAHEAD_SEEN;
                 break;
 	    case '!':           /* (?!...) */
 		RExC_seen_zerolen++;
+                RExC_seen |= REG_LOOKAHEAD_SEEN;
 		/* check if we're really just a "FAIL" assertion */
 		--RExC_parse;
 		nextchar(pRExC_state);
@@ -13122,6 +13443,7 @@ S_handle_regex_sets(pTHX_ RExC_state_t *pRExC_state, SV** return_invlist,
      * these things, we need to realize that something preceded by a backslash
      * is escaped, so we have to keep track of backslashes */
     if (PASS2) {
+        RExC_warned = TRUE;
         Perl_ck_warner_d(aTHX_
             packWARN(WARN_EXPERIMENTAL__REGEX_SETS),
             "The regex_sets feature is experimental" REPORT_LOCATION,
@@ -15739,6 +16061,19 @@ Perl__get_regclass_nonbitmap_data(pTHX_ const regexp *prog,
 				      0, /* not from tr/// */
 				      invlist,
 				      &swash_init_flags);
+
+                /* Matching only ever asks whether a code point is in this
+                 * binary swash, which its inversion list answers without
+                 * building swatches.  So keep just that, as
+                 * _core_swash_init() itself does for the smaller ones */
+                if (sw && SvROK(sw) && SvTYPE(SvRV(sw)) == SVt_PVHV) {
+                    SV * const sw_invlist = _get_swash_invlist(sw);
+                    if (sw_invlist) {
+                        SV * const rv = newRV_inc(sw_invlist);
+                        SvREFCNT_dec_NN(sw);
+                        sw = rv;
+                    }
+                }
 		(void)av_store(av, 1, sw);
 	    }
 	}
@@ -16935,6 +17270,49 @@ Perl_regfree_internal(pTHX_ REGEXP * const rx)
 	Safefree(ri->code_blocks);
     }
 
+    if (ri->dfa) {
+        reg_dfa * const dfa = ri->dfa;
+        int i;
+        for (i = 0; i < 2; i++) {
+            reg_dfa_machine * const m = i ? &dfa->rev : &dfa->fwd;
+            Safefree(m->nfa);
+            Safefree(m->trans);
+            Safefree(m->accepts);
+            Safefree(m->setoff);
+            Safefree(m->setlen);
+            Safefree(m->sets);
+            Safefree(m->hash);
+            Safefree(m->stack);
+            Safefree(m->set);
+            Safefree(m->seen);
+        }
+        Safefree(dfa->classes);
+        Safefree(dfa);
+    }
+
+    if (ri->jit) {
+        reg_jit * const jit = ri->jit;
+        Safefree(jit->ops);
+        Safefree(jit->classes);
+        Safefree(jit->strings);
+        Safefree(jit->stack);
+        Safefree(jit);
+    }
+
+    Safefree(ri->stclass_skip);
+    Safefree(ri->prefilter);
+
+    if (ri->stats) {
+        reg_stats * const stats = ri->stats;
+        if (stats->prev)
+            stats->prev->next = stats->next;
+        else
+            PL_reg_stats = stats->next;
+        if (stats->next)
+            stats->next->prev = stats->prev;
+        Safefree(stats);
+    }
+
     if (ri->data) {
 	int n = ri->data->count;
 
@@ -17162,6 +17540,12 @@ Perl_regdupe_internal(pTHX_ REGEXP * const rx, CLONE_PARAMS *param)
 	reti->code_blocks = NULL;
 
     reti->regstclass = NULL;
+    reti->dfa = NULL;		/* rebuilt when it is next needed */
+    reti->jit = NULL;
+    reti->stclass_skip = NULL;
+    reti->prefilter = NULL;
+    reti->maxsteps = ri->maxsteps;
+    reti->stats = ri->stats ? S_reg_stats_new(aTHX_ rx) : NULL;
 
     if (ri->data) {
 	struct reg_data *d;
@@ -17235,6 +17619,850 @@ Perl_regdupe_internal(pTHX_ REGEXP * const rx, CLONE_PARAMS *param)
 
 #ifndef PERL_IN_XSUB_RE
 
+/*
+ - Frozen regexps
+
+ reg_freeze() turns a compiled pattern into a string from which
+ reg_thaw() makes the same pattern again without compiling it, so that a
+ large set of patterns can be compiled once and then loaded quickly; see
+ re::regfreeze() and re::regthaw().
+
+ The string holds the regexp's fields, its program, its substrings and
+ the items in ri->data, the structs being written as they are in memory.
+ What matching builds as it goes (the DFA, the flat program, the skip
+ tables and the prefilter) is left out, and a swash which has been set
+ up is kept as just its inversion list.  So a frozen regexp is only good
+ for a build of perl with the same version, regnodes and struct layouts.
+ It starts with a signature of those, which reg_thaw() checks, and a
+ checksum of the rest.
+
+ Patterns with code blocks, and ones compiled by another engine, can't
+ be frozen.
+*/
+
+#define REG_FREEZE_MAGIC	"PRX1"
+#define REG_FREEZE_HEADLEN	(sizeof(REG_FREEZE_MAGIC) - 1 + 2 * sizeof(U32))
+
+/* how each SV is tagged, in S_reg_freeze_sv() */
+#define REG_FREEZE_POK	0x01
+#define REG_FREEZE_UTF8	0x02
+#define REG_FREEZE_IOK	0x04
+#define REG_FREEZE_ISUV	0x08
+#define REG_FREEZE_NOK	0x10
+
+/* and each substring, in S_reg_freeze_substr() */
+#define REG_FREEZE_SUBSTR_VALID	0x01
+#define REG_FREEZE_SUBSTR_TAIL	0x02
+#define REG_FREEZE_SUBSTR_UTF8	0x04
+
+#define FREEZE_PUT(out, ptr, n)	sv_catpvn(out, (const char *)(ptr), (n))
+#define FREEZE_VAL(out, v)	FREEZE_PUT(out, &(v), sizeof(v))
+
+typedef struct {
+    const char *p;
+    const char *end;
+} reg_thaw_buf;
+
+#define THAW_VAL(t, v)		S_reg_thaw_get(aTHX_ (t), &(v), sizeof(v))
+#define REG_THAW_CORRUPT()	Perl_croak(aTHX_ "Corrupt frozen regexp")
+
+static U32
+S_reg_fnv(U32 h, const void *p, STRLEN n)
+{
+    const U8 *s = (const U8 *)p;
+
+    while (n--) {
+	h ^= *s++;
+	h *= 16777619;
+    }
+    return h;
+}
+
+/* A hash of what the layout of a frozen regexp depends on */
+
+static U32
+S_reg_freeze_signature(void)
+{
+    const U32 consts[] = {
+	0x01020304,		/* for the byte order */
+	PERL_REVISION, PERL_VERSION, PERL_SUBVERSION,
+	REGNODE_MAX,
+	sizeof(void *), sizeof(UV), sizeof(NV), sizeof(STRLEN),
+	sizeof(regnode), sizeof(regnode_ssc),
+	sizeof(struct regnode_1), sizeof(struct regnode_charclass),
+	sizeof(regexp_internal), sizeof(struct reg_substr_data),
+	sizeof(reg_trie_data), sizeof(reg_trie_state),
+	sizeof(reg_trie_trans), sizeof(reg_trie_wordinfo),
+	sizeof(reg_ac_data),
+#ifdef RE_TRACK_PATTERN_OFFSETS
+	1
+#else
+	0
+#endif
+    };
+    U32 h = S_reg_fnv(2166136261U, consts, sizeof(consts));
+    int i;
+
+    h = S_reg_fnv(h, ARCHNAME, sizeof(ARCHNAME));
+    h = S_reg_fnv(h, PL_bincompat_options, strlen(PL_bincompat_options));
+    h = S_reg_fnv(h, PL_regkind, REGNODE_MAX);
+    h = S_reg_fnv(h, regarglen, REGNODE_MAX);
+    for (i = 0; i < REGNODE_MAX; i++)
+	h = S_reg_fnv(h, PL_reg_name[i], strlen(PL_reg_name[i]) + 1);
+    return h;
+}
+
+/* Croak unless there are n more items of the given size to read */
+
+static void
+S_reg_thaw_need(pTHX_ const reg_thaw_buf * const t, const UV n,
+		const STRLEN size)
+{
+    if (n > (UV)(t->end - t->p) / size)
+	REG_THAW_CORRUPT();
+}
+
+static void
+S_reg_thaw_get(pTHX_ reg_thaw_buf * const t, void * const buf,
+	       const STRLEN n)
+{
+    S_reg_thaw_need(aTHX_ t, n, 1);
+    Copy(t->p, buf, n, char);
+    t->p += n;
+}
+
+/* Read n items of the given size into new shared memory, as the trie
+ * structures are kept in */
+
+static void *
+S_reg_thaw_shared(pTHX_ reg_thaw_buf * const t, const UV n,
+		  const STRLEN size)
+{
+    void *p;
+
+    S_reg_thaw_need(aTHX_ t, n, size);
+    p = PerlMemShared_malloc(n ? n * size : 1);
+    Copy(t->p, p, n * size, char);
+    t->p += n * size;
+    return p;
+}
+
+/* Write an SV held in the data of a regexp: a plain scalar, an array,
+ * a hash, a reference or an inversion list */
+
+static void
+S_reg_freeze_sv(pTHX_ SV * const out, SV * const sv)
+{
+    char tag;
+
+    if (!sv) {
+	tag = 'N';
+	FREEZE_VAL(out, tag);
+    }
+    else if (sv == &PL_sv_undef) {
+	tag = 'U';
+	FREEZE_VAL(out, tag);
+    }
+    else if (SvTYPE(sv) == SVt_INVLIST) {
+	const UV len = _invlist_len(sv);
+	tag = 'L';
+	FREEZE_VAL(out, tag);
+	FREEZE_VAL(out, len);
+	if (len)
+	    FREEZE_PUT(out, invlist_array(sv), len * sizeof(UV));
+    }
+    else if (SvROK(sv)) {
+	SV *target = SvRV(sv);
+
+	/* a swash: matching only needs its inversion list */
+	if (SvTYPE(target) == SVt_PVHV
+	    && !(target = _get_swash_invlist(sv)))
+	{
+	    Perl_croak(aTHX_ "Can't freeze a regexp with this character class");
+	}
+	tag = 'R';
+	FREEZE_VAL(out, tag);
+	S_reg_freeze_sv(aTHX_ out, target);
+    }
+    else if (SvTYPE(sv) == SVt_PVAV && !SvRMAGICAL(sv)) {
+	AV * const av = MUTABLE_AV(sv);
+	const SSize_t n = AvFILLp(av) + 1;
+	SSize_t i;
+	tag = 'A';
+	FREEZE_VAL(out, tag);
+	FREEZE_VAL(out, n);
+	for (i = 0; i < n; i++)
+	    S_reg_freeze_sv(aTHX_ out, AvARRAY(av)[i]);
+    }
+    else if (SvTYPE(sv) == SVt_PVHV && !SvRMAGICAL(sv)) {
+	/* in the order of the keys, so that a pattern always freezes the
+	 * same, whatever order the hash is in */
+	HV * const hv = MUTABLE_HV(sv);
+	AV * const keys = MUTABLE_AV(sv_2mortal(MUTABLE_SV(newAV())));
+	U32 n;
+	U32 i;
+	HE *he;
+	(void)hv_iterinit(hv);
+	while ((he = hv_iternext(hv)))
+	    av_push(keys, newSVsv(hv_iterkeysv(he)));
+	n = (U32)(AvFILLp(keys) + 1);
+	sortsv(AvARRAY(keys), n, Perl_sv_cmp);
+	tag = 'H';
+	FREEZE_VAL(out, tag);
+	FREEZE_VAL(out, n);
+	for (i = 0; i < n; i++) {
+	    SV * const key = AvARRAY(keys)[i];
+	    STRLEN klen;
+	    const char * const kpv = SvPV_const(key, klen);
+	    const I32 signed_klen = SvUTF8(key) ? -(I32)klen : (I32)klen;
+	    FREEZE_VAL(out, signed_klen);
+	    FREEZE_PUT(out, kpv, klen);
+	    S_reg_freeze_sv(aTHX_ out, HeVAL(hv_fetch_ent(hv, key, 0, 0)));
+	}
+    }
+    else if (SvTYPE(sv) <= SVt_PVMG && !SvMAGICAL(sv)) {
+	U8 flags = 0;
+	if (SvPOK(sv))
+	    flags |= REG_FREEZE_POK | (SvUTF8(sv) ? REG_FREEZE_UTF8 : 0);
+	if (SvIOK(sv))
+	    flags |= REG_FREEZE_IOK | (SvIsUV(sv) ? REG_FREEZE_ISUV : 0);
+	if (SvNOK(sv))
+	    flags |= REG_FREEZE_NOK;
+	tag = 'P';
+	FREEZE_VAL(out, tag);
+	FREEZE_VAL(out, flags);
+	if (flags & REG_FREEZE_POK) {
+	    const STRLEN len = SvCUR(sv);
+	    FREEZE_VAL(out, len);
+	    FREEZE_PUT(out, SvPVX_const(sv), len);
+	}
+	if (flags & REG_FREEZE_IOK) {
+	    const IV iv = SvIVX(sv);
+	    FREEZE_VAL(out, iv);
+	}
+	if (flags & REG_FREEZE_NOK) {
+	    const NV nv = SvNVX(sv);
+	    FREEZE_VAL(out, nv);
+	}
+    }
+    else
+	Perl_croak(aTHX_ "panic: reg_freeze can't freeze a %s",
+		   sv_reftype(sv, 0));
+}
+
+static SV *
+S_reg_thaw_sv(pTHX_ reg_thaw_buf * const t, const int depth)
+{
+    char tag;
+
+    if (depth > 16)
+	REG_THAW_CORRUPT();
+    THAW_VAL(t, tag);
+    switch (tag) {
+    case 'N':
+	return NULL;
+    case 'U':
+	return &PL_sv_undef;
+    case 'L': {
+	UV len;
+	UV i;
+	SV *invlist;
+	THAW_VAL(t, len);
+	S_reg_thaw_need(aTHX_ t, len, sizeof(UV));
+	invlist = _new_invlist(len);
+	for (i = 0; i < len; i += 2) {
+	    UV start;
+	    UV end = UV_MAX;
+	    THAW_VAL(t, start);
+	    if (i + 1 < len) {
+		THAW_VAL(t, end);
+		if (end <= start)
+		    REG_THAW_CORRUPT();
+		end--;
+	    }
+	    invlist = _add_range_to_invlist(invlist, start, end);
+	}
+	return invlist;
+    }
+    case 'R': {
+	SV * const target = S_reg_thaw_sv(aTHX_ t, depth + 1);
+	if (!target || target == &PL_sv_undef)
+	    REG_THAW_CORRUPT();
+	return newRV_noinc(target);
+    }
+    case 'A': {
+	AV * const av = newAV();
+	SSize_t n;
+	SSize_t i;
+	THAW_VAL(t, n);
+	S_reg_thaw_need(aTHX_ t, n, 1);
+	sv_2mortal(MUTABLE_SV(av));
+	for (i = 0; i < n; i++) {
+	    SV * const elem = S_reg_thaw_sv(aTHX_ t, depth + 1);
+	    if (elem)
+		av_store(av, i, elem);
+	}
+	av_fill(av, n - 1);
+	return SvREFCNT_inc_simple_NN(MUTABLE_SV(av));
+    }
+    case 'H': {
+	HV * const hv = newHV();
+	U32 n;
+	THAW_VAL(t, n);
+	S_reg_thaw_need(aTHX_ t, n, sizeof(I32));
+	sv_2mortal(MUTABLE_SV(hv));
+	while (n--) {
+	    I32 klen;
+	    const char *key;
+	    SV *val;
+	    THAW_VAL(t, klen);
+	    S_reg_thaw_need(aTHX_ t, klen < 0 ? -(UV)klen : (UV)klen, 1);
+	    key = t->p;
+	    t->p += klen < 0 ? -klen : klen;
+	    val = S_reg_thaw_sv(aTHX_ t, depth + 1);
+	    if (!val || val == &PL_sv_undef)
+		REG_THAW_CORRUPT();
+	    (void)hv_store(hv, key, klen, val, 0);
+	}
+	return SvREFCNT_inc_simple_NN(MUTABLE_SV(hv));
+    }
+    case 'P': {
+	SV * const sv = sv_2mortal(newSV(0));
+	U8 flags;
+	THAW_VAL(t, flags);
+	if (flags & REG_FREEZE_POK) {
+	    STRLEN len;
+	    THAW_VAL(t, len);
+	    S_reg_thaw_need(aTHX_ t, len, 1);
+	    sv_setpvn(sv, t->p, len);
+	    t->p += len;
+	    if (flags & REG_FREEZE_UTF8)
+		SvUTF8_on(sv);
+	}
+	if (flags & REG_FREEZE_IOK) {
+	    IV iv;
+	    THAW_VAL(t, iv);
+	    (void)SvUPGRADE(sv, SVt_PVIV);
+	    SvIV_set(sv, iv);
+	    SvIOK_on(sv);
+	    if (flags & REG_FREEZE_ISUV)
+		SvIsUV_on(sv);
+	}
+	if (flags & REG_FREEZE_NOK) {
+	    NV nv;
+	    THAW_VAL(t, nv);
+	    (void)SvUPGRADE(sv, SVt_PVNV);
+	    SvNV_set(sv, nv);
+	    SvNOK_on(sv);
+	}
+	return SvREFCNT_inc_simple_NN(sv);
+    }
+    default:
+	REG_THAW_CORRUPT();
+    }
+}
+
+/* A substring of the pattern is written without the "\n" that
+ * fbm_compile() adds for FBMcf_TAIL, and compiled again when thawed */
+
+static void
+S_reg_freeze_substr(pTHX_ SV * const out, SV * const sv)
+{
+    U8 flags = 0;
+    STRLEN len;
+
+    if (!sv) {
+	len = (STRLEN)-1;
+	FREEZE_VAL(out, len);
+	return;
+    }
+    if (SvVALID(sv))
+	flags |= REG_FREEZE_SUBSTR_VALID;
+    if (SvTAIL(sv))
+	flags |= REG_FREEZE_SUBSTR_TAIL;
+    if (SvUTF8(sv))
+	flags |= REG_FREEZE_SUBSTR_UTF8;
+    len = SvCUR(sv) - ((flags & REG_FREEZE_SUBSTR_TAIL) ? 1 : 0);
+    FREEZE_VAL(out, len);
+    FREEZE_VAL(out, flags);
+    FREEZE_PUT(out, SvPVX_const(sv), len);
+}
+
+static SV *
+S_reg_thaw_substr(pTHX_ reg_thaw_buf * const t)
+{
+    STRLEN len;
+    U8 flags;
+    SV *sv;
+
+    THAW_VAL(t, len);
+    if (len == (STRLEN)-1)
+	return NULL;
+    THAW_VAL(t, flags);
+    S_reg_thaw_need(aTHX_ t, len, 1);
+    sv = newSVpvn_flags(t->p, len,
+			(flags & REG_FREEZE_SUBSTR_UTF8) ? SVf_UTF8 : 0);
+    t->p += len;
+    if (flags & REG_FREEZE_SUBSTR_VALID)
+	fbm_compile(sv, (flags & REG_FREEZE_SUBSTR_TAIL) ? FBMcf_TAIL : 0);
+    return sv;
+}
+
+/* The trie states and words, each copied into zeroed space first, so that
+ * neither the padding nor what is left in a union of its other member
+ * goes into the frozen string */
+
+static void
+S_reg_freeze_states(pTHX_ SV * const out, const reg_trie_state *state,
+		    U32 n)
+{
+    for (; n; n--, state++) {
+	reg_trie_state copy;
+	Zero(&copy, 1, reg_trie_state);
+	copy.wordnum = state->wordnum;
+	copy.trans.base = state->trans.base;
+	FREEZE_VAL(out, copy);
+    }
+}
+
+static void
+S_reg_freeze_words(pTHX_ SV * const out, const reg_trie_wordinfo *word,
+		   U32 n)
+{
+    for (; n; n--, word++) {
+	reg_trie_wordinfo copy;
+	Zero(&copy, 1, reg_trie_wordinfo);
+	copy.prev = word->prev;
+	copy.len = word->len;
+	copy.accept = word->accept;
+	FREEZE_VAL(out, copy);
+    }
+}
+
+/*
+ - reg_freeze - return a new string from which reg_thaw() makes rx again
+ */
+
+SV *
+Perl_reg_freeze(pTHX_ REGEXP * const rx)
+{
+    struct regexp * const r = ReANY(rx);
+    RXi_GET_DECL(r, ri);
+    SV * const out = newSVpvs_flags(REG_FREEZE_MAGIC, SVs_TEMP);
+    const U32 len = ProgLen(ri);
+    const U32 count = ri->data ? ri->data->count : 0;
+    U32 sig = S_reg_freeze_signature();
+    U32 sum = 0;
+    U32 i;
+    U8 u8;
+    U16 u16;
+    STRLEN wraplen;
+
+    PERL_ARGS_ASSERT_REG_FREEZE;
+
+    if (RX_ENGINE(rx) != &PL_core_reg_engine)
+	Perl_croak(aTHX_ "Can't freeze a regexp compiled by another engine");
+    if (ri->num_code_blocks || r->qr_anoncv
+	|| (RX_EXTFLAGS(rx) & RXf_EVAL_SEEN))
+    {
+	Perl_croak(aTHX_ "Can't freeze a regexp with code blocks");
+    }
+
+    FREEZE_VAL(out, sig);
+    FREEZE_VAL(out, sum);		/* filled in at the end */
+
+    /* the program first, so that reg_thaw() always has one to free */
+    FREEZE_VAL(out, len);
+    FREEZE_PUT(out, ri->program, (len + 1) * sizeof(regnode));
+#ifdef RE_TRACK_PATTERN_OFFSETS
+    FREEZE_PUT(out, ri->u.offsets, (2 * len + 1) * sizeof(U32));
+#endif
+    FREEZE_VAL(out, ri->name_list_idx);
+    FREEZE_VAL(out, ri->maxsteps);
+    u8 = ri->stats ? 1 : 0;
+    FREEZE_VAL(out, u8);
+
+    wraplen = RX_WRAPLEN(rx);
+    FREEZE_VAL(out, wraplen);
+    FREEZE_PUT(out, RX_WRAPPED(rx), wraplen);
+    u8 = RX_UTF8(rx) ? 1 : 0;
+    FREEZE_VAL(out, u8);
+    FREEZE_VAL(out, r->extflags);
+    FREEZE_VAL(out, r->minlen);
+    FREEZE_VAL(out, r->minlenret);
+    FREEZE_VAL(out, r->maxlen);
+    FREEZE_VAL(out, r->gofs);
+    FREEZE_VAL(out, r->nparens);
+    FREEZE_VAL(out, r->intflags);
+    u8 = r->pre_prefix;
+    FREEZE_VAL(out, u8);
+    u16 = RXp_COMPFLAGS(r);
+    FREEZE_VAL(out, u16);
+    S_reg_freeze_sv(aTHX_ out, MUTABLE_SV(RXp_PAREN_NAMES(r)));
+
+    /* the substrings; the check substring is one of the other two */
+    FREEZE_VAL(out, r->substrs->check_ix);
+    for (i = 0; i < 3; i++) {
+	FREEZE_VAL(out, r->substrs->data[i].min_offset);
+	FREEZE_VAL(out, r->substrs->data[i].max_offset);
+	FREEZE_VAL(out, r->substrs->data[i].end_shift);
+    }
+    for (i = 0; i < 2; i++) {
+	S_reg_freeze_substr(aTHX_ out, r->substrs->data[i].substr);
+	S_reg_freeze_substr(aTHX_ out, r->substrs->data[i].utf8_substr);
+    }
+    u8 = (r->check_substr || r->check_utf8)
+	 ? ((r->check_substr
+	     ? r->check_substr == r->anchored_substr
+	     : r->check_utf8 == r->anchored_utf8) ? 1 : 2)
+	 : 0;
+    FREEZE_VAL(out, u8);
+
+    FREEZE_VAL(out, count);
+    for (i = 0; i < count; i++) {
+	void * const item = ri->data->data[i];
+	const U8 what = ri->data->what[i];
+
+	FREEZE_VAL(out, what);
+	switch (what) {
+	    /* see also regcomp.h and regfree_internal() */
+	case 'a':
+	case 's':
+	case 'S':
+	case 'u':
+	    S_reg_freeze_sv(aTHX_ out, MUTABLE_SV(item));
+	    break;
+	    /* the structs are written without their pointers, reference
+	     * counts or padding, which reg_thaw() sets up afresh */
+	case 'f': {
+	    const regnode_ssc * const ssc = (regnode_ssc *)item;
+	    regnode_ssc copy;
+	    Zero(&copy, 1, regnode_ssc);
+	    StructCopy(ssc, &copy, struct regnode_charclass);
+	    copy.classflags = ssc->classflags;
+	    FREEZE_VAL(out, copy);
+	    break;
+	}
+	case 't': {
+	    const reg_trie_data * const trie = (reg_trie_data *)item;
+	    reg_trie_data copy;
+	    Zero(&copy, 1, reg_trie_data);
+	    copy.lasttrans = trie->lasttrans;
+	    copy.uniquecharcount = trie->uniquecharcount;
+	    copy.startstate = trie->startstate;
+	    copy.minlen = trie->minlen;
+	    copy.maxlen = trie->maxlen;
+	    copy.prefixlen = trie->prefixlen;
+	    copy.statecount = trie->statecount;
+	    copy.wordcount = trie->wordcount;
+#ifdef DEBUGGING
+	    copy.charcount = trie->charcount;
+#endif
+	    FREEZE_VAL(out, copy);
+	    u8 = (trie->bitmap ? 1 : 0) | (trie->jump ? 2 : 0);
+	    FREEZE_VAL(out, u8);
+	    FREEZE_PUT(out, trie->charmap, 256 * sizeof(U16));
+	    S_reg_freeze_states(aTHX_ out, trie->states, trie->statecount);
+	    FREEZE_PUT(out, trie->trans,
+		       trie->lasttrans * sizeof(reg_trie_trans));
+	    S_reg_freeze_words(aTHX_ out, trie->wordinfo, trie->wordcount + 1);
+	    if (trie->bitmap)
+		FREEZE_PUT(out, trie->bitmap, ANYOF_BITMAP_SIZE);
+	    if (trie->jump)
+		FREEZE_PUT(out, trie->jump,
+			   (trie->wordcount + 1) * sizeof(U16));
+	    break;
+	}
+	case 'T': {
+	    /* the start class made from a trie, which is freed with it */
+	    const reg_ac_data * const aho = (reg_ac_data *)item;
+	    const U32 states =
+		((reg_trie_data *)ri->data->data[aho->trie])->statecount;
+	    reg_ac_data copy;
+	    Zero(&copy, 1, reg_ac_data);
+	    copy.trie = aho->trie;
+	    FREEZE_VAL(out, copy);
+	    S_reg_freeze_states(aTHX_ out, aho->states, states);
+	    FREEZE_PUT(out, aho->fail, states * sizeof(U32));
+	    FREEZE_PUT(out, ri->regstclass,
+		       OP(ri->regstclass) == AHOCORASICKC
+		       ? sizeof(struct regnode_charclass)
+		       : sizeof(struct regnode_1));
+	    break;
+	}
+	case 'l':
+	case 'L':
+	case 'r':
+	    Perl_croak(aTHX_ "Can't freeze a regexp with code blocks");
+	default:
+	    Perl_croak(aTHX_ "panic: reg_freeze unknown data code '%c'", what);
+	}
+    }
+
+    /* a start class in the program; one in the data was set up with it */
+    if (ri->regstclass >= ri->program && ri->regstclass <= ri->program + len) {
+	const U32 offset = ri->regstclass - ri->program;
+	u8 = 1;
+	FREEZE_VAL(out, u8);
+	FREEZE_VAL(out, offset);
+    }
+    else {
+	u8 = 0;
+	FREEZE_VAL(out, u8);
+    }
+
+    sum = S_reg_fnv(2166136261U, SvPVX_const(out) + REG_FREEZE_HEADLEN,
+		    SvCUR(out) - REG_FREEZE_HEADLEN);
+    Copy(&sum, SvPVX(out) + REG_FREEZE_HEADLEN - sizeof(U32), sizeof(U32),
+	 char);
+    return SvREFCNT_inc_simple_NN(out);
+}
+
+/*
+ - reg_thaw - return a new regexp made from the string reg_freeze() gave
+ */
+
+REGEXP *
+Perl_reg_thaw(pTHX_ const char *pv, const STRLEN len)
+{
+    REGEXP *rx;
+    struct regexp *r;
+    regexp_internal *ri;
+    reg_thaw_buf buf;
+    reg_thaw_buf * const t = &buf;
+    U32 sig;
+    U32 sum;
+    U32 proglen;
+    U32 count;
+    U32 i;
+    U8 u8;
+    U16 u16;
+    STRLEN wraplen;
+    char *p;
+
+    PERL_ARGS_ASSERT_REG_THAW;
+
+    if (len < REG_FREEZE_HEADLEN
+	|| memNE(pv, REG_FREEZE_MAGIC, sizeof(REG_FREEZE_MAGIC) - 1))
+    {
+	REG_THAW_CORRUPT();
+    }
+    t->p = pv + sizeof(REG_FREEZE_MAGIC) - 1;
+    t->end = pv + len;
+    THAW_VAL(t, sig);
+    if (sig != S_reg_freeze_signature())
+	Perl_croak(aTHX_
+		   "Can't thaw a regexp frozen by a different build of perl");
+    THAW_VAL(t, sum);
+    if (sum != S_reg_fnv(2166136261U, t->p, t->end - t->p))
+	REG_THAW_CORRUPT();
+
+    THAW_VAL(t, proglen);
+    S_reg_thaw_need(aTHX_ t, (UV)proglen + 1, sizeof(regnode));
+    if (UCHARAT(t->p) != REG_MAGIC)
+	REG_THAW_CORRUPT();
+
+    /* From here on, rx can be freed if this croaks */
+    rx = (REGEXP *)sv_2mortal(newSV_type(SVt_REGEXP));
+    r = ReANY(rx);
+    Newxc(ri, sizeof(regexp_internal) + proglen * sizeof(regnode),
+	  char, regexp_internal);
+    Zero(ri, sizeof(regexp_internal), char);
+    RXi_SET(r, ri);
+    r->engine = &PL_core_reg_engine;
+    Copy(t->p, ri->program, proglen + 1, regnode);
+    t->p += (proglen + 1) * sizeof(regnode);
+#ifdef RE_TRACK_PATTERN_OFFSETS
+    S_reg_thaw_need(aTHX_ t, 2 * (UV)proglen + 1, sizeof(U32));
+    Newx(ri->u.offsets, 2 * proglen + 1, U32);
+    Copy(t->p, ri->u.offsets, 2 * proglen + 1, U32);
+    t->p += (2 * proglen + 1) * sizeof(U32);
+#else
+    SetProgLen(ri, proglen);
+#endif
+    THAW_VAL(t, ri->name_list_idx);
+    THAW_VAL(t, ri->maxsteps);
+    THAW_VAL(t, u8);
+    if (u8)
+	ri->stats = S_reg_stats_new(aTHX_ rx);
+
+    THAW_VAL(t, wraplen);
+    S_reg_thaw_need(aTHX_ t, wraplen, 1);
+    Newx(p, wraplen + 1, char);
+    Copy(t->p, p, wraplen, char);
+    p[wraplen] = '\0';
+    t->p += wraplen;
+    r->xpv_len_u.xpvlenu_pv = p;
+    SvCUR_set(rx, wraplen);
+    THAW_VAL(t, u8);
+    if (u8)
+	SvFLAGS(rx) |= SVf_UTF8;
+    THAW_VAL(t, r->extflags);
+    THAW_VAL(t, r->minlen);
+    THAW_VAL(t, r->minlenret);
+    THAW_VAL(t, r->maxlen);
+    THAW_VAL(t, r->gofs);
+    THAW_VAL(t, r->nparens);
+    THAW_VAL(t, r->intflags);
+    THAW_VAL(t, u8);
+    r->pre_prefix = u8;
+    THAW_VAL(t, u16);
+    RXp_COMPFLAGS(r) = u16;
+    if (r->pre_prefix > wraplen || r->nparens >= I32_MAX)
+	REG_THAW_CORRUPT();
+    Newxz(r->offs, r->nparens + 1, regexp_paren_pair);
+    {
+	SV * const names = S_reg_thaw_sv(aTHX_ t, 0);
+	RXp_PAREN_NAMES(r) = MUTABLE_HV(names);
+	if (names && (names == &PL_sv_undef || SvTYPE(names) != SVt_PVHV)) {
+	    RXp_PAREN_NAMES(r) = NULL;
+	    REG_THAW_CORRUPT();
+	}
+    }
+
+    Newxz(r->substrs, 1, struct reg_substr_data);
+    THAW_VAL(t, r->substrs->check_ix);
+    for (i = 0; i < 3; i++) {
+	THAW_VAL(t, r->substrs->data[i].min_offset);
+	THAW_VAL(t, r->substrs->data[i].max_offset);
+	THAW_VAL(t, r->substrs->data[i].end_shift);
+    }
+    for (i = 0; i < 2; i++) {
+	r->substrs->data[i].substr = S_reg_thaw_substr(aTHX_ t);
+	r->substrs->data[i].utf8_substr = S_reg_thaw_substr(aTHX_ t);
+    }
+    THAW_VAL(t, u8);
+    if (u8 > 2)
+	REG_THAW_CORRUPT();
+    if (u8) {
+	r->check_substr = r->substrs->data[u8 - 1].substr;
+	r->check_utf8 = r->substrs->data[u8 - 1].utf8_substr;
+    }
+
+    THAW_VAL(t, count);
+    if (count) {
+	struct reg_data *d;
+	S_reg_thaw_need(aTHX_ t, count, 2);
+	Newxc(d, sizeof(struct reg_data) + count * sizeof(void *),
+	      char, struct reg_data);
+	Newx(d->what, count, U8);
+	d->count = 0;		/* counts the items thawed so far */
+	ri->data = d;
+    }
+    for (i = 0; i < count; i++) {
+	struct reg_data * const d = ri->data;
+	U8 what;
+
+	THAW_VAL(t, what);
+	d->what[i] = what;
+	switch (what) {
+	case 'a':
+	case 's':
+	case 'S':
+	case 'u':
+	    d->data[i] = S_reg_thaw_sv(aTHX_ t, 0);
+	    d->count = i + 1;
+	    if (d->data[i] == &PL_sv_undef) {
+		d->data[i] = NULL;
+		REG_THAW_CORRUPT();
+	    }
+	    break;
+	case 'f': {
+	    regnode_ssc *ssc;
+	    S_reg_thaw_need(aTHX_ t, 1, sizeof(regnode_ssc));
+	    Newx(ssc, 1, regnode_ssc);
+	    Copy(t->p, ssc, 1, regnode_ssc);
+	    t->p += sizeof(regnode_ssc);
+	    ssc->invlist = NULL;
+	    d->data[i] = ssc;
+	    d->count = i + 1;
+	    ri->regstclass = (regnode *)ssc;
+	    break;
+	}
+	case 't': {
+	    reg_trie_data * const trie = (reg_trie_data *)
+		S_reg_thaw_shared(aTHX_ t, 1, sizeof(reg_trie_data));
+	    U8 has;
+	    trie->refcount = 1;
+	    trie->charmap = NULL;
+	    trie->states = NULL;
+	    trie->trans = NULL;
+	    trie->bitmap = NULL;
+	    trie->jump = NULL;
+	    trie->wordinfo = NULL;
+	    d->data[i] = trie;
+	    d->count = i + 1;
+	    THAW_VAL(t, has);
+	    trie->charmap = (U16 *)
+		S_reg_thaw_shared(aTHX_ t, 256, sizeof(U16));
+	    trie->states = (reg_trie_state *)
+		S_reg_thaw_shared(aTHX_ t, trie->statecount,
+				  sizeof(reg_trie_state));
+	    trie->trans = (reg_trie_trans *)
+		S_reg_thaw_shared(aTHX_ t, trie->lasttrans,
+				  sizeof(reg_trie_trans));
+	    trie->wordinfo = (reg_trie_wordinfo *)
+		S_reg_thaw_shared(aTHX_ t, (UV)trie->wordcount + 1,
+				  sizeof(reg_trie_wordinfo));
+	    if (has & 1)
+		trie->bitmap = (char *)
+		    S_reg_thaw_shared(aTHX_ t, ANYOF_BITMAP_SIZE, 1);
+	    if (has & 2)
+		trie->jump = (U16 *)
+		    S_reg_thaw_shared(aTHX_ t, (UV)trie->wordcount + 1,
+				      sizeof(U16));
+	    break;
+	}
+	case 'T': {
+	    reg_ac_data * const aho = (reg_ac_data *)
+		S_reg_thaw_shared(aTHX_ t, 1, sizeof(reg_ac_data));
+	    struct regnode_1 node;
+	    U32 states;
+	    aho->refcount = 1;
+	    aho->states = NULL;
+	    aho->fail = NULL;
+	    if (aho->trie >= i || d->what[aho->trie] != 't'
+		|| ri->regstclass)
+	    {
+		PerlMemShared_free(aho);
+		REG_THAW_CORRUPT();
+	    }
+	    states = ((reg_trie_data *)d->data[aho->trie])->statecount;
+	    S_reg_thaw_need(aTHX_ t, states,
+			    sizeof(reg_trie_state) + sizeof(U32));
+	    aho->states = (reg_trie_state *)
+		S_reg_thaw_shared(aTHX_ t, states, sizeof(reg_trie_state));
+	    aho->fail = (U32 *)
+		S_reg_thaw_shared(aTHX_ t, states, sizeof(U32));
+	    S_reg_thaw_need(aTHX_ t, 1, sizeof(node));
+	    Copy(t->p, &node, 1, struct regnode_1);
+	    ri->regstclass = (regnode *)
+		S_reg_thaw_shared(aTHX_ t, 1,
+				  OP(&node) == AHOCORASICKC
+				  ? sizeof(struct regnode_charclass)
+				  : sizeof(struct regnode_1));
+	    d->data[i] = aho;
+	    d->count = i + 1;
+	    break;
+	}
+	default:
+	    REG_THAW_CORRUPT();
+	}
+    }
+
+    THAW_VAL(t, u8);
+    if (u8) {
+	THAW_VAL(t, i);
+	if (i > proglen || ri->regstclass)
+	    REG_THAW_CORRUPT();
+	ri->regstclass = ri->program + i;
+    }
+    if (t->p != t->end)
+	REG_THAW_CORRUPT();
+
+    return (REGEXP *)SvREFCNT_inc_simple_NN(rx);
+}
+
 /*
  - regnext - dig the "next" pointer out of a node
  */
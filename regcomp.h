@@ -90,7 +90,167 @@
 /* This is the stuff that used to live in regexp.h that was truly
    private to the engine itself. It now lives here. */
 
+/* A pattern compiled with PREGf_DFA set is matched with a DFA, which is
+ * built from the program once the pattern is hot or given a long string,
+ * and then extended a state at a time as the matches need them.  See "Lazy DFA"
+ * in regexec.c.
+ *
+ * The NFA it is built from has three kinds of state: one with a
+ * transition on a set of bytes (cls is an index into classes[]), one
+ * with a transition on the end of the string (cls is REG_DFA_EOS), and
+ * one with up to two epsilon transitions (cls is REG_DFA_EPSILON), of
+ * which out1 is preferred.  An unused out is -1.
+ *
+ * There are two machines: one which runs forwards over the string to
+ * find where the match ends, and one made from the reverse of its NFA,
+ * which runs backwards from there to find where the match starts. */
+
+#define REG_DFA_EPSILON   -1
+#define REG_DFA_EOS       -2
+
+typedef struct {
+    I32 cls;
+    I32 out1;
+    I32 out2;
+} reg_dfa_nstate;
+
+typedef struct {
+    U8 bits[32];
+} reg_dfa_class;
+
+typedef struct {
+    reg_dfa_nstate *nfa;        /* the NFA's states */
+    I32  nstates;
+    I32  start;                 /* the NFA's start state */
+    I32  match;                 /* and its accepting one */
+    bool ordered;               /* are a state's NFA states kept in order
+                                   of preference, rather than sorted? */
+    bool restart;               /* can a match start at every byte? */
+    /* the DFA states so far; each is a set of NFA states, after a flag
+       saying whether a match has been seen, so no new ones start */
+    I32  *trans;                /* next state by [state * ncols + column],
+                                   or -1 until it has been worked out */
+    U8   *accepts;              /* 1 if the state holds the accepting
+                                   state, 2 if it can never get there */
+    I32  *setoff;               /* where the state's set of NFA states ... */
+    I32  *setlen;               /* ... is in sets[], and how long it is */
+    I32  *sets;
+    I32  *hash;                 /* open hash of the states by their sets */
+    I32  ndstates;
+    I32  maxdstates;
+    I32  setsused;
+    I32  setsmax;
+    I32  hashmask;
+    I32  startstate;            /* DFA state to start in */
+    I32  eosstartstate;         /* the same, at the end of the string */
+    /* workspace for computing a state's successor */
+    I32  *stack;
+    I32  *set;
+    U32  *seen;
+    U32  seengen;
+} reg_dfa_machine;
+
+typedef struct reg_dfa {
+    reg_dfa_class *classes;     /* bitmaps of the byte transitions' bytes */
+    I32  nclasses;
+    U32  runs;                  /* matches of short strings before it was
+                                   built */
+    bool built;
+    bool anchored;              /* can only match at the start of the string */
+    bool failed;                /* too big or complex: backtrack instead */
+    U8   bytemap[256];          /* byte to column of trans[] */
+    U8   repr[257];             /* a byte for each column */
+    U16  ncols;                 /* byte columns, then one for end of string */
+    U8   startskip[256];        /* bytes which leave the forward machine in
+                                   its start state */
+    reg_dfa_machine fwd;
+    reg_dfa_machine rev;
+} reg_dfa;
+
+/* A pattern compiled with PREGf_JIT set (under "use re 'jit'") has its
+ * program compiled, once it has been matched often enough, into a flat
+ * array of the simpler ops below, which S_jit_match() runs instead of
+ * regmatch().  See "Compiled programs" in regexec.c. */
+
+#define REG_JIT_CLASS   0       /* a byte in classes[cls] */
+#define REG_JIT_STR     1       /* the arg2 bytes at strings + arg1 */
+#define REG_JIT_SPLIT   2       /* go on, or if that fails, to arg1
+                                   (after unwinding the captures) */
+#define REG_JIT_JUMP    3       /* go to arg1 */
+#define REG_JIT_REPEAT  4       /* arg1 to arg2 bytes in classes[cls] */
+#define REG_JIT_OPEN    5       /* paren arg1 starts */
+#define REG_JIT_CLOSE   6       /* paren arg1 ends */
+#define REG_JIT_SBOL    7
+#define REG_JIT_MBOL    8
+#define REG_JIT_SEOL    9
+#define REG_JIT_MEOL    10
+#define REG_JIT_EOS     11
+#define REG_JIT_END     12
 
+typedef struct {
+    U8   type;                  /* REG_JIT_* */
+    bool minmod;                /* REPEAT: try the fewest first */
+    I32  cls;
+    I32  follow;                /* REPEAT: the class the byte after it must
+                                   be in, or -1 if that isn't known */
+    I32  arg1;
+    I32  arg2;
+} reg_jit_op;
+
+/* where S_jit_match() goes back to when something fails: a SPLIT's
+ * other way, or a REPEAT with some other count */
+typedef struct {
+    I32     pc;
+    I32     count;
+    SSize_t pos;
+    U32     lastparen;
+    U32     lastcloseparen;
+} reg_jit_frame;
+
+typedef struct reg_jit {
+    U32  runs;                  /* matches so far, until compiled */
+    bool failed;                /* the program can't be compiled */
+    reg_jit_op *ops;            /* NULL until compiled */
+    I32  nops;
+    reg_dfa_class *classes;
+    I32  nclasses;
+    U8   *strings;
+    I32  stringslen;
+    reg_jit_frame *stack;       /* kept from match to match */
+    I32  stackmax;
+} reg_jit;
+
+/* The bytes at which a match of regstclass can start, built by
+ * find_byclass() the first time it has a long string to scan, so that
+ * it can skip the others without testing the class on each one.  For a
+ * UTF-8 target only the invariant bytes are tested; a set bit for each
+ * of the others makes it stop there and test the whole character. */
+
+typedef struct {
+    U8   built;                 /* which of these have been filled in */
+    U8   bytes[32];             /* for a target not in UTF-8 */
+    U8   utf8[32];              /* for a target in UTF-8 */
+} reg_stclass_skip;
+
+#define REG_STCLASS_SKIP_BYTES  0x01
+#define REG_STCLASS_SKIP_UTF8   0x02
+
+/* The literal strings every match of a pattern must start with, if it
+ * has them, for the patterns which have no start class.  Built the first
+ * time such a pattern is matched; see "Literal prefilter" in regexec.c.
+ * Longer literals are cut down to REG_PREFILTER_LEN bytes. */
+
+#define REG_PREFILTER_LEN       8
+#define REG_PREFILTER_MAX       64      /* most literals */
+
+typedef struct {
+    bool failed;                /* the pattern doesn't start with them */
+    U8   first[32];             /* the bytes the literals start with */
+    U8   start[257];            /* literals start[c] .. start[c+1] - 1
+                                   are the ones which start with c */
+    U8   lens[REG_PREFILTER_MAX];
+    char lits[REG_PREFILTER_MAX][REG_PREFILTER_LEN];
+} reg_prefilter;
 
  typedef struct regexp_internal {
         int name_list_idx;	/* Optional data index of an array of paren names */
@@ -111,6 +271,12 @@
                                    a regop is an index into this structure */
 	struct reg_code_block *code_blocks;/* positions of literal (?{}) */
 	int num_code_blocks;	/* size of code_blocks[] */
+	reg_dfa *dfa;		/* DFA for PREGf_DFA patterns, once built */
+	reg_jit *jit;		/* for PREGf_JIT patterns, once matched */
+	reg_stclass_skip *stclass_skip; /* for regstclass, once built */
+	reg_prefilter *prefilter; /* if it has no regstclass, once built */
+	UV maxsteps;		/* under "use re steps => N", N; else 0 */
+	reg_stats *stats;	/* under "use re 'stats'", its counts */
 	regnode program[1];	/* Unwarranted chumminess with compiler. */
 } regexp_internal;
 
@@ -141,6 +307,8 @@
 #define PREGf_ANCH_MBOL         0x00000400
 #define PREGf_ANCH_SBOL         0x00000800
 #define PREGf_ANCH_GPOS         0x00001000
+#define PREGf_DFA               0x00002000 /* try a DFA before backtracking */
+#define PREGf_JIT               0x00004000 /* compiled with "use re 'jit'" */
 
 #define PREGf_ANCH              \
     ( PREGf_ANCH_SBOL | PREGf_ANCH_GPOS | PREGf_ANCH_MBOL )
@@ -598,7 +766,7 @@ struct regnode_ssc {
 #define REG_ZERO_LEN_SEEN                   0x00000001
 #define REG_LOOKBEHIND_SEEN                 0x00000002
 #define REG_GPOS_SEEN                       0x00000004
-/* spare */
+#define REG_LOOKAHEAD_SEEN                  0x00000008
 #define REG_CANY_SEEN                       0x00000010
 #define REG_RECURSE_SEEN                    0x00000020
 #define REG_TOP_LEVEL_BRANCHES_SEEN         0x00000040
@@ -36,6 +36,7 @@ my %feature = (
     unicode_eval    => 'unieval',
     unicode_strings => 'unicode',
     fc              => 'fc',
+    popcount        => 'popcount',
     signatures      => 'signatures',
 );
 
@@ -653,6 +654,16 @@ See L<perlop/Bitwise String Operators> for details.
 
 This feature is available from Perl 5.22 onwards.
 
+=head2 The 'popcount' feature
+
+C<use feature 'popcount'> tells the compiler to enable the C<popcount>
+function, which counts the bits set in a string.
+
+See L<perlfunc/popcount> for details.
+
+This feature is available from Perl 5.22 onwards.  It is not in any
+feature bundle.
+
 =head1 FEATURE BUNDLES
 
 It's possible to load multiple features together, using
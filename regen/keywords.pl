@@ -51,6 +51,8 @@ my %feature_kw = (
 	__SUB__ => '__SUB__',
 
 	fc      => 'fc',
+
+	popcount=> 'popcount',
 	);
 
 my %pos = map { ($_ => 1) } @{$by_strength{'+'}};
@@ -260,6 +262,7 @@ __END__
 +package
 -pipe
 -pop
+-popcount
 +pos
 +print
 +printf
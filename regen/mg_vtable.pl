@@ -74,6 +74,8 @@ my %mg =
      qr => { char => 'r', vtable => 'regexp', value_magic => 1, 
 	     readonly_acceptable => 1, desc => 'Precompiled qr// regex' },
      sig => { char => 'S', desc => '%SIG hash' },
+     study => { char => 'G', vtable => 'study', value_magic => 1,
+		desc => 'study()ed string index' },
      sigelem => { char => 's', vtable => 'sigelem',
 		  desc => '%SIG hash element' },
      taint => { char => 't', vtable => 'taint', value_magic => 1,
@@ -143,6 +145,7 @@ my %sig =
      'backref' => {free => 'killbackrefs'},
      'ovrld' => {free => 'freeovrld'},
      'utf8' => {set => 'setutf8'},
+     'study' => {set => 'setstudy'},
      'collxfrm' => {set => 'setcollxfrm',
 		    cond => '#ifdef USE_LOCALE_COLLATE'},
      'hintselem' => {set => 'sethint', clear => 'clearhint'},
@@ -159,6 +159,14 @@ static const char* const non_utf8_target_but_utf8_required
     locinput = (p);  \
     SET_nextchr
 
+/* Is the (well-formed) UTF-8 character at 'p', which is above Latin1, in the
+ * Posix class 'classnum'?  Only valid for classes below _FIRST_NON_SWASH_CC.
+ * This searches the class's inversion list directly instead of going through
+ * a swash.  The search starts from the range it found the previous time, so
+ * runs of nearby code points are mostly answered without a binary search */
+#define isFOO_utf8_invlist(classnum, p)                                       \
+        _invlist_contains_cp(PL_XPosix_ptrs[classnum],                        \
+                             valid_utf8_to_uvchr((U8 *) (p), NULL))
 
 #define LOAD_UTF8_CHARCLASS(swash_ptr, property_name, invlist) STMT_START {   \
         if (!swash_ptr) {                                                     \
@@ -278,6 +286,8 @@ static const char* const non_utf8_target_but_utf8_required
 static void S_setup_eval_state(pTHX_ regmatch_info *const reginfo);
 static void S_cleanup_regmatch_info_aux(pTHX_ void *arg);
 static regmatch_state * S_push_slab(pTHX);
+static void S_reg_class_bits(pTHX_ regexp *prog, const regnode *p,
+			     const regmatch_info *reginfo, U8 *bits);
 
 #define REGCP_PAREN_ELEMS 3
 #define REGCP_OTHER_ELEMS 3
@@ -515,20 +525,7 @@ S_isFOO_utf8_lc(pTHX_ const U8 classnum, const U8* character)
     _CHECK_AND_OUTPUT_WIDE_LOCALE_UTF8_MSG(character, character + UTF8SKIP(character));
 
     if (classnum < _FIRST_NON_SWASH_CC) {
-
-        /* Initialize the swash unless done already */
-        if (! PL_utf8_swash_ptrs[classnum]) {
-            U8 flags = _CORE_SWASH_INIT_ACCEPT_INVLIST;
-            PL_utf8_swash_ptrs[classnum] =
-                    _core_swash_init("utf8",
-                                     "",
-                                     &PL_sv_undef, 1, 0,
-                                     PL_XPosix_ptrs[classnum], &flags);
-        }
-
-        return cBOOL(swash_fetch(PL_utf8_swash_ptrs[classnum], (U8 *)
-                                 character,
-                                 TRUE /* is UTF */ ));
+        return isFOO_utf8_invlist(classnum, character);
     }
 
     switch ((_char_class_number) classnum) {
@@ -933,7 +930,7 @@ Perl_re_intuit_start(pTHX_
                 start_point);
         });
 
-	check_at = fbm_instr( start_point, end_point,
+	check_at = study_instr(sv, start_point, end_point,
 		      check, multiline ? FBMrf_MULTILINE : 0);
 
         /* Update the count-of-usability, remove useless subpatterns,
@@ -1066,7 +1063,8 @@ Perl_re_intuit_start(pTHX_
 
         must = utf8_target ? other->utf8_substr : other->substr;
         assert(SvPOK(must));
-        s = fbm_instr(
+        s = study_instr(
+            sv,
             (unsigned char*)s,
             (unsigned char*)last + SvCUR(must) - (SvTAIL(must)!=0),
             must,
@@ -1430,6 +1428,8 @@ Perl_re_intuit_start(pTHX_
   fail:
     DEBUG_EXECUTE_r(PerlIO_printf(Perl_debug_log, "%sMatch rejected by optimizer%s\n",
 			  PL_colors[4], PL_colors[5]));
+    if (UNLIKELY(progi->stats))
+        progi->stats->rejected++;
     return NULL;
 }
 
@@ -1556,8 +1556,19 @@ STMT_START {                                          \
     }                                                 \
 } STMT_END
 
+/* If there is a skip bitmap (see S_stclass_skip()), first go past all the
+ * bytes which can't start a match.  They would each set tmp to 1 */
+#define REXEC_FBC_SKIP                                         \
+    if (skip && ! REG_SKIP_TEST(skip, *s)) {                   \
+	s = S_find_next_in_skip(skip, s, strend);              \
+	if (s >= strend)                                       \
+	    break;                                             \
+	tmp = 1;                                               \
+    }
+
 #define REXEC_FBC_UTF8_CLASS_SCAN(COND)                        \
 REXEC_FBC_UTF8_SCAN( /* Loops while (s < strend) */            \
+    REXEC_FBC_SKIP                                             \
     if (COND) {                                                \
 	if (tmp && (reginfo->intuit || regtry(reginfo, &s)))   \
 	    goto got_it;                                       \
@@ -1570,6 +1581,7 @@ REXEC_FBC_UTF8_SCAN( /* Loops while (s < strend) */            \
 
 #define REXEC_FBC_CLASS_SCAN(COND)                             \
 REXEC_FBC_SCAN( /* Loops while (s < strend) */                 \
+    REXEC_FBC_SKIP                                             \
     if (COND) {                                                \
 	if (tmp && (reginfo->intuit || regtry(reginfo, &s)))   \
 	    goto got_it;                                       \
@@ -1729,6 +1741,87 @@ REXEC_FBC_SCAN( /* Loops while (s < strend) */                 \
             TEST_NON_UTF8, PLACEHOLDER, REXEC_FBC_TRYIT)
 
 
+#define REG_SKIP_TEST(bits, c) ((bits)[(U8)(c) >> 3] & (1 << ((U8)(c) & 7)))
+
+/* Don't build a skip bitmap to scan fewer bytes than this */
+#define REG_STCLASS_SKIP_MIN 256
+
+/* Return the first byte from s on whose bit is set in the skip bitmap,
+ * or strend if there isn't one.  This is the inner loop of the class
+ * scans, so it looks at four bytes at a time where it can */
+
+PERL_STATIC_INLINE char *
+S_find_next_in_skip(const U8 * const bits, char *s, const char * const strend)
+{
+    while (strend - s >= 4) {
+	if (REG_SKIP_TEST(bits, s[0]))
+	    return s;
+	if (REG_SKIP_TEST(bits, s[1]))
+	    return s + 1;
+	if (REG_SKIP_TEST(bits, s[2]))
+	    return s + 2;
+	if (REG_SKIP_TEST(bits, s[3]))
+	    return s + 3;
+	s += 4;
+    }
+    while (s < strend && ! REG_SKIP_TEST(bits, *s))
+	s++;
+    return s;
+}
+
+/* Return the skip bitmap for the pattern's start class and the kind of
+ * target in reginfo, building it if 'build' is true and it hasn't been
+ * built yet, or NULL if there isn't one.  Classes which depend on the
+ * locale at run time don't get one */
+
+STATIC const U8 *
+S_stclass_skip(pTHX_ regexp *prog, const regmatch_info *reginfo,
+	       const bool build)
+{
+    RXi_GET_DECL(prog,progi);
+    const regnode * const c = progi->regstclass;
+    const bool utf8_target = reginfo->is_utf8_target;
+    const U8 kind = utf8_target ? REG_STCLASS_SKIP_UTF8
+				: REG_STCLASS_SKIP_BYTES;
+    reg_stclass_skip *skip = progi->stclass_skip;
+    U8 *bits;
+
+    if (skip && (skip->built & kind))
+	return utf8_target ? skip->utf8 : skip->bytes;
+    if (! build)
+	return NULL;
+
+    switch (OP(c)) {
+    case ANYOF:
+	if (ANYOF_FLAGS(c) & ANYOF_LOCALE_FLAGS)
+	    return NULL;
+	break;
+    case POSIXD:
+    case NPOSIXD:
+    case POSIXA:
+    case NPOSIXA:
+    case POSIXU:
+    case NPOSIXU:
+	break;
+    default:
+	return NULL;
+    }
+
+    if (! skip)
+	Newxz(skip, 1, reg_stclass_skip);
+    progi->stclass_skip = skip;
+    bits = utf8_target ? skip->utf8 : skip->bytes;
+    S_reg_class_bits(aTHX_ prog, c, reginfo, bits);
+    if (utf8_target) {
+	int i;
+	for (i = 0; i < 256; i++)
+	    if (! UTF8_IS_INVARIANT(i))
+		bits[i >> 3] |= 1 << (i & 7);
+    }
+    skip->built |= kind;
+    return bits;
+}
+
 /* We know what class REx starts with.  Try to find this position... */
 /* if reginfo->intuit, its a dryrun */
 /* annoyingly all the vars in this routine have different names from their counterparts
@@ -1756,11 +1849,16 @@ S_find_byclass(pTHX_ regexp * prog, const regnode *c, char *s,
                                    with a result inverts that result, as 0^1 =
                                    1 and 1^1 = 0 */
     _char_class_number classnum;
+    const U8 *skip = NULL;  /* bytes which can start a match of c */
 
     RXi_GET_DECL(prog,progi);
 
     PERL_ARGS_ASSERT_FIND_BYCLASS;
 
+    if (c == progi->regstclass)
+        skip = S_stclass_skip(aTHX_ prog, reginfo,
+                              strend - s >= REG_STCLASS_SKIP_MIN);
+
     /* We know what class it must start with. */
     switch (OP(c)) {
     case ANYOFL:
@@ -2025,6 +2123,7 @@ S_find_byclass(pTHX_ regexp * prog, const regnode *c, char *s,
             classnum = (_char_class_number) FLAGS(c);
             if (classnum < _FIRST_NON_SWASH_CC) {
                 while (s < strend) {
+                    REXEC_FBC_SKIP
 
                     /* We avoid loading in the swash as long as possible, but
                      * should we have to, we jump to a separate loop.  This
@@ -2092,26 +2191,18 @@ S_find_byclass(pTHX_ regexp * prog, const regnode *c, char *s,
         }
         break;
 
-      found_above_latin1:   /* Here we have to load a swash to get the result
-                               for the current code point */
-        if (! PL_utf8_swash_ptrs[classnum]) {
-            U8 flags = _CORE_SWASH_INIT_ACCEPT_INVLIST;
-            PL_utf8_swash_ptrs[classnum] =
-                    _core_swash_init("utf8",
-                                     "",
-                                     &PL_sv_undef, 1, 0,
-                                     PL_XPosix_ptrs[classnum], &flags);
-        }
+      found_above_latin1:   /* Here we have to search the class's inversion
+                               list to get the result for the current code
+                               point */
 
         /* This is a copy of the loop above for swash classes, though using the
-         * FBC macro instead of being expanded out.  Since we've loaded the
-         * swash, we don't have to check for that each time through the loop */
+         * FBC macro instead of being expanded out, and looking above-Latin1
+         * code points up in the inversion list */
         REXEC_FBC_UTF8_CLASS_SCAN(
                 to_complement ^ cBOOL(_generic_utf8(
                                       classnum,
                                       s,
-                                      swash_fetch(PL_utf8_swash_ptrs[classnum],
-                                                  (U8 *) s, TRUE))));
+                                      isFOO_utf8_invlist(classnum, s))));
         break;
 
     case AHOCORASICKC:
@@ -2334,163 +2425,2249 @@ S_find_byclass(pTHX_ regexp * prog, const regnode *c, char *s,
         }
         break;
     default:
-        Perl_croak(aTHX_ "panic: unknown regstclass %d", (int)OP(c));
+        Perl_croak(aTHX_ "panic: unknown regstclass %d", (int)OP(c));
+    }
+    return 0;
+  got_it:
+    return s;
+}
+
+/* set RX_SAVED_COPY, RX_SUBBEG etc.
+ * flags have same meanings as with regexec_flags() */
+
+static void
+S_reg_set_capture_string(pTHX_ REGEXP * const rx,
+                            char *strbeg,
+                            char *strend,
+                            SV *sv,
+                            U32 flags,
+                            bool utf8_target)
+{
+    struct regexp *const prog = ReANY(rx);
+
+    if (flags & REXEC_COPY_STR) {
+#ifdef PERL_ANY_COW
+        if (SvCANCOW(sv)) {
+            if (DEBUG_C_TEST) {
+                PerlIO_printf(Perl_debug_log,
+                              "Copy on write: regexp capture, type %d\n",
+                              (int) SvTYPE(sv));
+            }
+            /* Create a new COW SV to share the match string and store
+             * in saved_copy, unless the current COW SV in saved_copy
+             * is valid and suitable for our purpose */
+            if ((   prog->saved_copy
+                 && SvIsCOW(prog->saved_copy)
+                 && SvPOKp(prog->saved_copy)
+                 && SvIsCOW(sv)
+                 && SvPOKp(sv)
+                 && SvPVX(sv) == SvPVX(prog->saved_copy)))
+            {
+                /* just reuse saved_copy SV */
+                if (RXp_MATCH_COPIED(prog)) {
+                    Safefree(prog->subbeg);
+                    RXp_MATCH_COPIED_off(prog);
+                }
+            }
+            else {
+                /* create new COW SV to share string */
+                RX_MATCH_COPY_FREE(rx);
+                prog->saved_copy = sv_setsv_cow(prog->saved_copy, sv);
+            }
+            prog->subbeg = (char *)SvPVX_const(prog->saved_copy);
+            assert (SvPOKp(prog->saved_copy));
+            prog->sublen  = strend - strbeg;
+            prog->suboffset = 0;
+            prog->subcoffset = 0;
+        } else
+#endif
+        {
+            SSize_t min = 0;
+            SSize_t max = strend - strbeg;
+            SSize_t sublen;
+
+            if (    (flags & REXEC_COPY_SKIP_POST)
+                && !(prog->extflags & RXf_PMf_KEEPCOPY) /* //p */
+                && !(PL_sawampersand & SAWAMPERSAND_RIGHT)
+            ) { /* don't copy $' part of string */
+                U32 n = 0;
+                max = -1;
+                /* calculate the right-most part of the string covered
+                 * by a capture. Due to look-ahead, this may be to
+                 * the right of $&, so we have to scan all captures */
+                while (n <= prog->lastparen) {
+                    if (prog->offs[n].end > max)
+                        max = prog->offs[n].end;
+                    n++;
+                }
+                if (max == -1)
+                    max = (PL_sawampersand & SAWAMPERSAND_LEFT)
+                            ? prog->offs[0].start
+                            : 0;
+                assert(max >= 0 && max <= strend - strbeg);
+            }
+
+            if (    (flags & REXEC_COPY_SKIP_PRE)
+                && !(prog->extflags & RXf_PMf_KEEPCOPY) /* //p */
+                && !(PL_sawampersand & SAWAMPERSAND_LEFT)
+            ) { /* don't copy $` part of string */
+                U32 n = 0;
+                min = max;
+                /* calculate the left-most part of the string covered
+                 * by a capture. Due to look-behind, this may be to
+                 * the left of $&, so we have to scan all captures */
+                while (min && n <= prog->lastparen) {
+                    if (   prog->offs[n].start != -1
+                        && prog->offs[n].start < min)
+                    {
+                        min = prog->offs[n].start;
+                    }
+                    n++;
+                }
+                if ((PL_sawampersand & SAWAMPERSAND_RIGHT)
+                    && min >  prog->offs[0].end
+                )
+                    min = prog->offs[0].end;
+
+            }
+
+            assert(min >= 0 && min <= max && min <= strend - strbeg);
+            sublen = max - min;
+
+            if (RX_MATCH_COPIED(rx)) {
+                if (sublen > prog->sublen)
+                    prog->subbeg =
+                            (char*)saferealloc(prog->subbeg, sublen+1);
+            }
+            else
+                prog->subbeg = (char*)safemalloc(sublen+1);
+            Copy(strbeg + min, prog->subbeg, sublen, char);
+            prog->subbeg[sublen] = '\0';
+            prog->suboffset = min;
+            prog->sublen = sublen;
+            RX_MATCH_COPIED_on(rx);
+        }
+        prog->subcoffset = prog->suboffset;
+        if (prog->suboffset && utf8_target) {
+            /* Convert byte offset to chars.
+             * XXX ideally should only compute this if @-/@+
+             * has been seen, a la PL_sawampersand ??? */
+
+            /* If there's a direct correspondence between the
+             * string which we're matching and the original SV,
+             * then we can use the utf8 len cache associated with
+             * the SV. In particular, it means that under //g,
+             * sv_pos_b2u() will use the previously cached
+             * position to speed up working out the new length of
+             * subcoffset, rather than counting from the start of
+             * the string each time. This stops
+             *   $x = "\x{100}" x 1E6; 1 while $x =~ /(.)/g;
+             * from going quadratic */
+            if (SvPOKp(sv) && SvPVX(sv) == strbeg)
+                prog->subcoffset = sv_pos_b2u_flags(sv, prog->subcoffset,
+                                                SV_GMAGIC|SV_CONST_RETURN);
+            else
+                prog->subcoffset = utf8_length((U8*)strbeg,
+                                    (U8*)(strbeg+prog->suboffset));
+        }
+    }
+    else {
+        RX_MATCH_COPY_FREE(rx);
+        prog->subbeg = strbeg;
+        prog->suboffset = 0;
+        prog->subcoffset = 0;
+        prog->sublen = strend - strbeg;
+    }
+}
+
+
+
+
+/*
+ - Lazy DFA
+
+ A pattern that regcomp.c has marked with PREGf_DFA is matched against
+ a non-UTF-8 string without backtracking, in time linear in the length
+ of the string, by two DFAs.
+
+ The first runs forwards from where a match may start (S_dfa_search()).
+ Its states are lists of the NFA's states in the order regmatch() would
+ try them, those of a match starting at a later byte coming after those
+ which started earlier.  Once a match is seen the states after it are
+ dropped, and no more matches are started, so the last match seen ends
+ where the one regmatch() would find does.  If none is seen, the pattern
+ doesn't match, and that is that.  The second DFA, made from the NFA with
+ its transitions reversed, runs backwards from the end of the match to
+ the earliest place it could have started (S_dfa_rsearch()).
+
+ That is the match: regcomp.c only marks patterns without captures, and
+ if the NFA can't keep to regmatch()'s order (for a trie with a word
+ which is the start of another, a repeated group which can match the
+ empty string, or a $ which can match before a newline), the DFA isn't
+ used.  Nor is it if the program has anything the NFA can't express, or
+ either machine would get too big, and the pattern is matched by
+ backtracking alone.  So it is for an anchored pattern with at most one
+ unbounded repeat, and that of a single character, such as /^.*x/s:
+ tried at just the one place, backtracking can't take longer over it.
+
+ Building the machines costs more than a match of a short string, so it
+ waits until the pattern has been matched REG_DFA_HOT times, or is given
+ a string of at least REG_DFA_LONG bytes (S_dfa_compile()).  The DFAs'
+ states are then only made as matching needs them (S_dfa_step()), and
+ are kept for later matches.
+*/
+
+#define DFA_MAX_NSTATES 4096	/* biggest NFA we'll build */
+#define DFA_MAX_DSTATES 2048	/* most DFA states we'll make */
+#define DFA_MAX_DEPTH    400	/* deepest we'll recurse into the program */
+#define DFA_MAX_REPEAT   500	/* largest explicit repeat count we'll expand */
+#define REG_DFA_HOT       16	/* matches before the DFA is built ... */
+#define REG_DFA_LONG     256	/* ... unless the string is this long */
+
+typedef struct {
+    reg_dfa *dfa;
+    regexp *prog;
+    regexp_internal *progi;
+    regmatch_info *reginfo;
+    I32 nstates_max;		/* allocated NFA states */
+    I32 nclasses_max;		/* allocated classes */
+    I32 single[256];		/* class matching just the byte, if made */
+    I32 *memo;			/* S_dfa_from()'s state for each node ... */
+    U32 *memoepoch;		/* ... if made for this copy of a body */
+    U32 epoch;			/* the body being built */
+    U32 epochs;			/* the number of bodies built */
+    I32 cont;			/* where the body goes after it */
+    int depth;
+    int unbounded;		/* unbounded repeats; of more than a single
+				   character, counting twice */
+    bool minmod;		/* the next repeat is a minimal one */
+    bool inexact;		/* the NFA can't keep to regmatch()'s order */
+    bool failed;
+} dfa_build;
+
+/* a new NFA state */
+
+static I32
+S_dfa_state(pTHX_ dfa_build *b, const I32 cls, const I32 out1, const I32 out2)
+{
+    reg_dfa_machine * const m = &b->dfa->fwd;
+    reg_dfa_nstate *st;
+
+    if (m->nstates >= DFA_MAX_NSTATES) {
+	b->failed = TRUE;
+	return -1;
+    }
+    if (m->nstates == b->nstates_max) {
+	b->nstates_max *= 2;
+	Renew(m->nfa, b->nstates_max, reg_dfa_nstate);
+    }
+    st = &m->nfa[m->nstates];
+    st->cls = cls;
+    st->out1 = out1;
+    st->out2 = out2;
+    return m->nstates++;
+}
+
+/* a new class of bytes, for transitions on the bytes in bits */
+
+static I32
+S_dfa_class(pTHX_ dfa_build *b, const U8 *bits)
+{
+    reg_dfa * const dfa = b->dfa;
+
+    if (dfa->nclasses == b->nclasses_max) {
+	b->nclasses_max *= 2;
+	Renew(dfa->classes, b->nclasses_max, reg_dfa_class);
+    }
+    Copy(bits, dfa->classes[dfa->nclasses].bits, 32, U8);
+    return dfa->nclasses++;
+}
+
+/* Set bits to the bytes which match the byte c of an EXACT-like node,
+ * using the same test for a match as regmatch() does when neither the
+ * string nor the pattern is in UTF-8 */
+
+static void
+S_reg_exact_bits(const U8 op, const U8 c, U8 *bits)
+{
+    Zero(bits, 32, U8);
+    if (op == EXACT)
+	bits[c >> 3] |= 1 << (c & 7);
+    else {
+	const U8 * const fold_array = op == EXACTF ? PL_fold : PL_fold_latin1;
+	int i;
+	for (i = 0; i < 256; i++)
+	    if (i == c || fold_array[i] == c)
+		bits[i >> 3] |= 1 << (i & 7);
+    }
+}
+
+/* The same for a node which matches a single character, using the same
+ * tests as regrepeat().  For a UTF-8 target, only the invariant bytes are
+ * set, as the others aren't whole characters */
+
+static void
+S_reg_class_bits(pTHX_ regexp *prog, const regnode *p,
+		 const regmatch_info *reginfo, U8 *bits)
+{
+    const bool utf8_target = reginfo->is_utf8_target;
+    const U8 flags = ANYOF_FLAGS(p);
+    int i;
+
+    Zero(bits, 32, U8);
+    switch (OP(p)) {
+    case REG_ANY:
+	memset(bits, 0xFF, 32);
+	bits['\n' >> 3] &= ~(1 << ('\n' & 7));
+	break;
+    case SANY:
+    case CANY:
+	memset(bits, 0xFF, 32);
+	break;
+
+    case ANYOF:
+	/* the bitmap says all there is to say about the bytes, unless
+	 * something outside it or the locale could match them too */
+	if (! (flags & (ANYOF_LOCALE_FLAGS
+			| ANYOF_HAS_NONBITMAP_NON_UTF8_MATCHES))
+	    && ! (utf8_target && (flags & ANYOF_HAS_UTF8_NONBITMAP_MATCHES)))
+	{
+	    Copy(ANYOF_BITMAP(p), bits, 32, U8);
+	    if ((flags & ANYOF_MATCHES_ALL_NON_UTF8_NON_ASCII) && ! utf8_target)
+		for (i = 0; i < 256; i++)
+		    if (! isASCII(i))
+			bits[i >> 3] |= 1 << (i & 7);
+	    if (flags & ANYOF_INVERT)
+		for (i = 0; i < 32; i++)
+		    bits[i] = ~bits[i];
+	}
+	else {
+	    for (i = 0; i < 256; i++) {
+		const U8 c = (U8)i;
+		if ((! utf8_target || UTF8_IS_INVARIANT(c))
+		    && reginclass(prog, p, &c, &c + 1, utf8_target))
+		    bits[i >> 3] |= 1 << (i & 7);
+	    }
+	}
+	break;
+
+    /* on a UTF-8 target, the invariant bytes match the same as for the
+     * /a classes */
+    case POSIXD:
+    case POSIXA:
+	for (i = 0; i < 256; i++)
+	    if (_generic_isCC_A(i, FLAGS(p)))
+		bits[i >> 3] |= 1 << (i & 7);
+	break;
+    case NPOSIXD:
+    case NPOSIXA:
+	for (i = 0; i < 256; i++)
+	    if (! _generic_isCC_A(i, FLAGS(p)))
+		bits[i >> 3] |= 1 << (i & 7);
+	break;
+    case POSIXU:
+	for (i = 0; i < 256; i++)
+	    if (_generic_isCC(i, FLAGS(p)))
+		bits[i >> 3] |= 1 << (i & 7);
+	break;
+    case NPOSIXU:
+	for (i = 0; i < 256; i++)
+	    if (! _generic_isCC(i, FLAGS(p)))
+		bits[i >> 3] |= 1 << (i & 7);
+	break;
+    default:
+	NOT_REACHED; /* NOTREACHED */
+    }
+    if (utf8_target)
+	for (i = 0; i < 256; i++)
+	    if (! UTF8_IS_INVARIANT(i))
+		bits[i >> 3] &= ~(1 << (i & 7));
+}
+
+/* The NFA state for one byte of an EXACT-like node, going to k */
+
+static I32
+S_dfa_exact_byte(pTHX_ dfa_build *b, const U8 op, const U8 c, const I32 k)
+{
+    U8 bits[32];
+
+    if (op == EXACT) {
+	if (b->single[c] < 0) {
+	    S_reg_exact_bits(op, c, bits);
+	    b->single[c] = S_dfa_class(aTHX_ b, bits);
+	}
+	return S_dfa_state(aTHX_ b, b->single[c], k, -1);
+    }
+    S_reg_exact_bits(op, c, bits);
+    return S_dfa_state(aTHX_ b, S_dfa_class(aTHX_ b, bits), k, -1);
+}
+
+/* The same for a node which matches a single character */
+
+static I32
+S_dfa_class_node(pTHX_ dfa_build *b, const regnode *p, const I32 k)
+{
+    U8 bits[32];
+
+    S_reg_class_bits(aTHX_ b->prog, p, b->reginfo, bits);
+    return S_dfa_state(aTHX_ b, S_dfa_class(aTHX_ b, bits), k, -1);
+}
+
+/* The NFA for a TRIE (which only holds EXACT strings) from its state
+ * on; charclass[] caches a class for each charid. */
+
+static I32
+S_dfa_trie(pTHX_ dfa_build *b, const reg_trie_data *trie, const U32 state,
+	   I32 *charclass, const I32 k)
+{
+    const U32 base = trie->states[state].trans.base;
+    I32 alts = trie->states[state].wordnum ? k : -1;
+
+    if (++b->depth > DFA_MAX_DEPTH) {
+	b->failed = TRUE;
+	return -1;
+    }
+    if (base) {
+	U16 charid;
+	for (charid = 1; charid <= trie->uniquecharcount; charid++) {
+	    const I32 offset = base + charid - 1 - trie->uniquecharcount;
+	    I32 child;
+
+	    if (offset < 0 || (U32)offset >= trie->lasttrans
+		|| trie->trans[offset].check != state)
+		continue;
+	    if (charclass[charid] < 0) {
+		U8 bits[32];
+		int i;
+		Zero(bits, 32, U8);
+		for (i = 0; i < 256; i++)
+		    if (trie->charmap[i] == charid)
+			bits[i >> 3] |= 1 << (i & 7);
+		charclass[charid] = S_dfa_class(aTHX_ b, bits);
+	    }
+	    child = S_dfa_trie(aTHX_ b, trie, trie->trans[offset].next,
+			       charclass, k);
+	    child = S_dfa_state(aTHX_ b, charclass[charid], child, -1);
+	    alts = alts < 0
+		 ? child : S_dfa_state(aTHX_ b, REG_DFA_EPSILON, child, alts);
+	}
+    }
+    b->depth--;
+    /* a state with nowhere to go */
+    if (alts < 0)
+	alts = S_dfa_state(aTHX_ b, REG_DFA_EPSILON, -1, -1);
+    return alts;
+}
+
+static I32 S_dfa_from(pTHX_ dfa_build *b, regnode *p);
+
+/* The NFA for the node p, which matches one character (or for an
+ * EXACT-like node, a string of them), going to k after it */
+
+static I32
+S_dfa_simple(pTHX_ dfa_build *b, regnode *p, I32 k)
+{
+    switch (OP(p)) {
+    case EXACT:
+    case EXACTF:
+    case EXACTFU:
+    case EXACTFA:
+    case EXACTFA_NO_TRIE:
+    {
+	const U8 * const s = (U8 *)STRING(p);
+	I32 i = STR_LEN(p);
+	while (i-- > 0)
+	    k = S_dfa_exact_byte(aTHX_ b, OP(p), s[i], k);
+	return k;
+    }
+
+    case REG_ANY:
+    case SANY:
+    case CANY:
+    case ANYOF:
+    case POSIXD:
+    case POSIXU:
+    case POSIXA:
+    case NPOSIXD:
+    case NPOSIXU:
+    case NPOSIXA:
+	return S_dfa_class_node(aTHX_ b, p, k);
+
+    default:
+	b->failed = TRUE;
+	return -1;
+    }
+}
+
+/* Can the NFA get from the state from to k without reading anything? */
+
+static bool
+S_dfa_empty(pTHX_ dfa_build *b, const I32 from, const I32 k)
+{
+    const reg_dfa_machine * const m = &b->dfa->fwd;
+    I32 *stack;
+    U8 *seen;
+    I32 sp = 0;
+    bool found = FALSE;
+
+    if (from < 0)
+	return FALSE;
+    Newx(stack, 2 * m->nstates + 1, I32);
+    Newxz(seen, m->nstates, U8);
+    stack[sp++] = from;
+    while (sp && !found) {
+	const I32 t = stack[--sp];
+	const reg_dfa_nstate * const st = &m->nfa[t];
+	if (t == k)
+	    found = TRUE;
+	else if (!seen[t] && st->cls == REG_DFA_EPSILON) {
+	    seen[t] = 1;
+	    if (st->out1 >= 0)
+		stack[sp++] = st->out1;
+	    if (st->out2 >= 0)
+		stack[sp++] = st->out2;
+	}
+    }
+    Safefree(stack);
+    Safefree(seen);
+    return found;
+}
+
+/* The NFA for the program from a, which ends at a WHILEM or SUCCEED,
+ * going to k after it; or if single, for the simple node a. */
+
+static I32
+S_dfa_body(pTHX_ dfa_build *b, regnode *a, const bool single, const I32 k)
+{
+    const I32 cont = b->cont;
+    const U32 epoch = b->epoch;
+    I32 body;
+
+    if (single)
+	return S_dfa_simple(aTHX_ b, a, k);
+    /* each copy of the body is built afresh, since it goes somewhere
+     * different after it */
+    b->cont = k;
+    b->epoch = ++b->epochs;
+    body = S_dfa_from(aTHX_ b, a);
+    b->cont = cont;
+    b->epoch = epoch;
+    /* regmatch() stops repeating a group which has matched the empty
+     * string, where the NFA would go round again */
+    if (!b->failed && !b->inexact && S_dfa_empty(aTHX_ b, body, k))
+	b->inexact = TRUE;
+    return body;
+}
+
+/* The NFA for {min,max} repeats of the body a, going to k after them.
+ * Each time round, a greedy repeat prefers another copy of the body, and
+ * a minimal one what comes after. */
+
+static I32
+S_dfa_repeat(pTHX_ dfa_build *b, regnode *a, const bool single,
+	     const bool minmod, const I32 min, const I32 max, I32 k)
+{
+    I32 i;
+
+    if (min > DFA_MAX_REPEAT || (max != REG_INFTY && max > DFA_MAX_REPEAT)) {
+	b->failed = TRUE;
+	return -1;
+    }
+    if (max == REG_INFTY) {
+	const I32 loop = S_dfa_state(aTHX_ b, REG_DFA_EPSILON, -1, -1);
+	const I32 body = S_dfa_body(aTHX_ b, a, single, loop);
+	reg_dfa_nstate *st;
+	b->unbounded += single ? 1 : 2;
+	if (b->failed)
+	    return -1;
+	st = &b->dfa->fwd.nfa[loop];
+	st->out1 = minmod ? k : body;
+	st->out2 = minmod ? body : k;
+	k = loop;
+    }
+    else {
+	const I32 after = k;
+	for (i = min; i < max && !b->failed; i++) {
+	    const I32 body = S_dfa_body(aTHX_ b, a, single, k);
+	    k = minmod
+	      ? S_dfa_state(aTHX_ b, REG_DFA_EPSILON, after, body)
+	      : S_dfa_state(aTHX_ b, REG_DFA_EPSILON, body, after);
+	}
+    }
+    for (i = 0; i < min && !b->failed; i++)
+	k = S_dfa_body(aTHX_ b, a, single, k);
+    return k;
+}
+
+/* The NFA for matching the program from p to its end.  This follows the
+ * program's next pointers, so the alternatives of a BRANCH all lead to
+ * the same states for what comes after them; the state made for each
+ * node is remembered in b->memo[] for that. */
+
+static I32
+S_dfa_from(pTHX_ dfa_build *b, regnode *p)
+{
+    reg_dfa_machine * const m = &b->dfa->fwd;
+    const bool minmod = b->minmod;
+    regnode *next;
+    I32 off;
+    I32 k = -1;
+
+    b->minmod = FALSE;
+    if (b->failed)
+	return -1;
+    if (OP(p) == END)
+	return m->match;
+    if (OP(p) == SUCCEED || OP(p) == WHILEM)
+	return b->cont;		/* the end of a repeated body */
+
+    off = p - b->progi->program;
+    if (b->memoepoch[off] == b->epoch)
+	return b->memo[off];
+    if (++b->depth > DFA_MAX_DEPTH) {
+	b->failed = TRUE;
+	return -1;
+    }
+    next = regnext(p);
+
+    switch (OP(p)) {
+    case NOTHING:
+    case TAIL:
+    case OPEN:
+    case CLOSE:
+    case LONGJMP:
+	k = S_dfa_from(aTHX_ b, next);
+	break;
+
+    case MINMOD:
+	/* for the repeat which follows */
+	b->minmod = TRUE;
+	k = S_dfa_from(aTHX_ b, next);
+	break;
+
+    case SBOL:
+	/* only as the anchor at the start of the pattern */
+	if (p != b->progi->program + 1)
+	    goto cant;
+	b->dfa->anchored = TRUE;
+	k = S_dfa_from(aTHX_ b, next);
+	break;
+
+    case SEOL:
+    case EOS:
+	/* only at the end of the pattern, where they become a transition
+	 * on the end of the string, or for $ also on a newline before it */
+	k = S_dfa_from(aTHX_ b, next);
+	if (k != m->match)
+	    goto cant;
+	k = S_dfa_state(aTHX_ b, REG_DFA_EOS, k, -1);
+	if (OP(p) == SEOL) {
+	    /* the match ends before the newline, not after it */
+	    b->inexact = TRUE;
+	    k = S_dfa_state(aTHX_ b, REG_DFA_EPSILON, k,
+			    S_dfa_exact_byte(aTHX_ b, EXACT, '\n', k));
+	}
+	break;
+
+    case EXACT:
+    case EXACTF:
+    case EXACTFU:
+    case EXACTFA:
+    case EXACTFA_NO_TRIE:
+    case REG_ANY:
+    case SANY:
+    case CANY:
+    case ANYOF:
+    case POSIXD:
+    case POSIXU:
+    case POSIXA:
+    case NPOSIXD:
+    case NPOSIXU:
+    case NPOSIXA:
+	k = S_dfa_simple(aTHX_ b, p, S_dfa_from(aTHX_ b, next));
+	break;
+
+    case STAR:
+	k = S_dfa_repeat(aTHX_ b, NEXTOPER(p), TRUE, minmod, 0, REG_INFTY,
+			 S_dfa_from(aTHX_ b, next));
+	break;
+    case PLUS:
+	k = S_dfa_repeat(aTHX_ b, NEXTOPER(p), TRUE, minmod, 1, REG_INFTY,
+			 S_dfa_from(aTHX_ b, next));
+	break;
+    case CURLY:
+	k = S_dfa_repeat(aTHX_ b, NEXTOPER(p) + NODE_STEP_REGNODE, TRUE,
+			 minmod, ARG1(p), ARG2(p), S_dfa_from(aTHX_ b, next));
+	break;
+    case CURLYN:
+	k = S_dfa_repeat(aTHX_ b, regnext(NEXTOPER(p) + NODE_STEP_REGNODE),
+			 TRUE, minmod, ARG1(p), ARG2(p),
+			 S_dfa_from(aTHX_ b, next));
+	break;
+    case CURLYM:
+    {
+	regnode *a = NEXTOPER(p) + NODE_STEP_REGNODE;
+	if (p->flags)
+	    a += NEXT_OFF(a);	/* skip the former OPEN */
+	k = S_dfa_repeat(aTHX_ b, a, FALSE, minmod, ARG1(p), ARG2(p),
+			 S_dfa_from(aTHX_ b, next));
+	break;
+    }
+    case CURLYX:
+	if (OP(PREVOPER(next)) == NOTHING) /* LONGJMP */
+	    next += ARG(next);
+	k = S_dfa_repeat(aTHX_ b, NEXTOPER(p) + EXTRA_STEP_2ARGS, FALSE,
+			 minmod, ARG1(p), ARG2(p), S_dfa_from(aTHX_ b, next));
+	break;
+
+    case BRANCH:
+    case BRANCHJ:
+	/* this alternative, or those in the following branches; as in
+	 * regmatch(), the last branch is the one not followed by another */
+	k = S_dfa_from(aTHX_ b,
+		       OP(p) == BRANCH ? NEXTOPER(p) : NEXTOPER(NEXTOPER(p)));
+	if (next && OP(next) == OP(p))
+	    k = S_dfa_state(aTHX_ b, REG_DFA_EPSILON, k,
+			    S_dfa_from(aTHX_ b, next));
+	break;
+
+    case TRIE:
+    case TRIEC:
+    {
+	const reg_trie_data * const trie
+	    = (reg_trie_data *)b->progi->data->data[ARG(p)];
+	I32 *charclass;
+	I32 i;
+
+	if (p->flags != EXACT || trie->jump)
+	    goto cant;
+	/* regmatch() tries the words in the order they were given, and
+	 * the NFA longer ones first, which is only the same if no word
+	 * starts another */
+	for (i = 1; i <= (I32)trie->wordcount; i++)
+	    if (trie->wordinfo[i].prev)
+		b->inexact = TRUE;
+	k = S_dfa_from(aTHX_ b, next);
+	Newx(charclass, trie->uniquecharcount + 1, I32);
+	for (i = 0; i <= trie->uniquecharcount; i++)
+	    charclass[i] = -1;
+	k = S_dfa_trie(aTHX_ b, trie, trie->startstate, charclass, k);
+	Safefree(charclass);
+	break;
+    }
+
+    default:
+      cant:
+	/* anything else (backreferences, lookahead, \b, ...) */
+	b->failed = TRUE;
+	return -1;
+    }
+
+    b->depth--;
+    b->memo[off] = k;
+    b->memoepoch[off] = b->epoch;
+    return k;
+}
+
+static int
+S_dfa_cmp_state(const void *a, const void *b)
+{
+    const I32 x = *(const I32 *)a;
+    const I32 y = *(const I32 *)b;
+    return x < y ? -1 : x > y;
+}
+
+/* Start afresh on marking which of m's NFA states have been seen */
+
+static void
+S_dfa_new_seen(reg_dfa_machine *m)
+{
+    if (++m->seengen == 0) {
+	Zero(m->seen, m->nstates, U32);
+	m->seengen = 1;
+    }
+}
+
+/* Add the NFA state s, and all those reachable from it by epsilon
+ * transitions, to set[0..*n) (except for the states that only have
+ * epsilon transitions: they make no difference to where we can go), in
+ * the order regmatch() would try them.  For the forward machine nothing
+ * comes after the accepting state, so this stops, returning true, once
+ * it has been added. */
+
+static bool
+S_dfa_closure(reg_dfa_machine *m, const I32 s, I32 *set, I32 *n)
+{
+    I32 * const stack = m->stack;
+    I32 sp = 0;
+
+    if (s < 0)
+	return FALSE;
+    stack[sp++] = s;
+    while (sp) {
+	const I32 t = stack[--sp];
+	const reg_dfa_nstate *st;
+	if (m->seen[t] == m->seengen)
+	    continue;
+	m->seen[t] = m->seengen;
+	st = &m->nfa[t];
+	if (st->cls != REG_DFA_EPSILON || t == m->match) {
+	    set[(*n)++] = t;
+	    if (t == m->match && m->ordered)
+		return TRUE;
+	}
+	else {
+	    /* so that out1 is popped first */
+	    if (st->out2 >= 0 && m->seen[st->out2] != m->seengen)
+		stack[sp++] = st->out2;
+	    if (st->out1 >= 0 && m->seen[st->out1] != m->seengen)
+		stack[sp++] = st->out1;
+	}
+    }
+    return FALSE;
+}
+
+static U32
+S_dfa_hash(const I32 *set, const I32 n)
+{
+    U32 h = 0x811c9dc5;
+    I32 i;
+    for (i = 0; i < n; i++)
+	h = (h ^ (U32)set[i]) * 0x01000193;
+    return h;
+}
+
+/* The DFA state of m for set[0..n), which is the flag saying whether a
+ * match has been seen followed by the NFA states, and which is made if
+ * there isn't one yet; -1 if the DFA is full. */
+
+static I32
+S_dfa_find_state(pTHX_ reg_dfa_machine *m, const U16 ncols,
+		 const I32 *set, const I32 n)
+{
+    I32 i, d;
+
+    i = S_dfa_hash(set, n) & m->hashmask;
+    while ((d = m->hash[i]) >= 0) {
+	if (m->setlen[d] == n
+	    && memEQ(m->sets + m->setoff[d], set, n * sizeof(I32)))
+	    return d;
+	i = (i + 1) & m->hashmask;
+    }
+
+    if (m->ndstates == DFA_MAX_DSTATES)
+	return -1;
+    if (m->ndstates == m->maxdstates) {
+	m->maxdstates *= 2;
+	Renew(m->trans, m->maxdstates * ncols, I32);
+	Renew(m->accepts, m->maxdstates, U8);
+	Renew(m->setoff, m->maxdstates, I32);
+	Renew(m->setlen, m->maxdstates, I32);
+    }
+    if (m->setsused + n > m->setsmax) {
+	while (m->setsused + n > m->setsmax)
+	    m->setsmax *= 2;
+	Renew(m->sets, m->setsmax, I32);
+    }
+
+    d = m->ndstates++;
+    for (i = 0; i < ncols; i++)
+	m->trans[d * ncols + i] = -1;
+    Copy(set, m->sets + m->setsused, n, I32);
+    m->setoff[d] = m->setsused;
+    m->setlen[d] = n;
+    m->setsused += n;
+    /* 1 if it matches, 2 if it never can */
+    m->accepts[d] = 0;
+    for (i = 1; i < n; i++)
+	if (set[i] == m->match)
+	    m->accepts[d] = 1;
+    if (n == 1 && (set[0] || !m->restart))
+	m->accepts[d] = 2;
+
+    /* keep the hash table at most half full */
+    if (m->ndstates * 2 > m->hashmask + 1) {
+	I32 e;
+	m->hashmask = m->hashmask * 2 + 1;
+	Renew(m->hash, m->hashmask + 1, I32);
+	for (i = 0; i <= m->hashmask; i++)
+	    m->hash[i] = -1;
+	for (e = 0; e < m->ndstates; e++) {
+	    i = S_dfa_hash(m->sets + m->setoff[e], m->setlen[e])
+		& m->hashmask;
+	    while (m->hash[i] >= 0)
+		i = (i + 1) & m->hashmask;
+	    m->hash[i] = e;
+	}
+    }
+    else {
+	i = S_dfa_hash(set, n) & m->hashmask;
+	while (m->hash[i] >= 0)
+	    i = (i + 1) & m->hashmask;
+	m->hash[i] = d;
+    }
+    return d;
+}
+
+/* The DFA state of m reached from d on column col, or -1 if the DFA is
+ * full */
+
+static I32
+S_dfa_step(pTHX_ reg_dfa *dfa, reg_dfa_machine *m, const I32 d,
+	   const U16 col)
+{
+    I32 * const set = m->set;
+    const I32 * const from = m->sets + m->setoff[d];
+    const I32 len = m->setlen[d];
+    const bool eos = col == dfa->ncols - 1;
+    const U8 c = dfa->repr[col];
+    bool matched = FALSE;
+    I32 n = 1;
+    I32 i;
+
+    S_dfa_new_seen(m);
+    /* once there has been a match, no more are started */
+    set[0] = m->restart && (from[0] || m->accepts[d] == 1);
+    for (i = 1; i < len && !matched; i++) {
+	const reg_dfa_nstate * const st = &m->nfa[from[i]];
+	if (eos
+	    ? st->cls == REG_DFA_EOS
+	    : st->cls >= 0 && (dfa->classes[st->cls].bits[c >> 3] & (1 << (c & 7))))
+	    matched = S_dfa_closure(m, st->out1, set, &n);
+    }
+    /* until then, a match can also start after this byte */
+    if (m->restart && !set[0] && !matched && !eos)
+	(void)S_dfa_closure(m, m->start, set, &n);
+    if (!m->ordered)
+	qsort(set + 1, n - 1, sizeof(I32), S_dfa_cmp_state);
+    return S_dfa_find_state(aTHX_ m, dfa->ncols, set, n);
+}
+
+/* The DFA state m starts in.  If eos, the reverse machine is starting
+ * from the end of the string, so can also first undo a transition on
+ * that. */
+
+static I32
+S_dfa_start_state(pTHX_ reg_dfa *dfa, reg_dfa_machine *m, const bool eos)
+{
+    I32 * const set = m->set;
+    I32 n = 1;
+    I32 i;
+
+    S_dfa_new_seen(m);
+    set[0] = 0;
+    (void)S_dfa_closure(m, m->start, set, &n);
+    if (eos)
+	for (i = 1; i < n; i++)
+	    if (m->nfa[set[i]].cls == REG_DFA_EOS)
+		(void)S_dfa_closure(m, m->nfa[set[i]].out1, set, &n);
+    if (!m->ordered)
+	qsort(set + 1, n - 1, sizeof(I32), S_dfa_cmp_state);
+    return S_dfa_find_state(aTHX_ m, dfa->ncols, set, n);
+}
+
+/* Make the reverse machine's NFA from the forward one's.  Each forward
+ * state v has a reverse state v, with epsilon transitions to the states
+ * that went to v; a forward transition on a byte or the end of the string
+ * from x becomes a state n + x, with the same transition back to x.  State
+ * 2n accepts, and the forward start state goes to it.  A reverse state with
+ * more than two transitions gets a chain of extra states for them. */
+
+static void
+S_dfa_reverse(pTHX_ reg_dfa *dfa)
+{
+    const reg_dfa_machine * const f = &dfa->fwd;
+    reg_dfa_machine * const r = &dfa->rev;
+    const I32 n = f->nstates;
+    I32 *first;
+    I32 *fill;
+    I32 *targets;
+    I32 v;
+
+    /* count the transitions into each forward state */
+    Newxz(first, n + 1, I32);
+    for (v = 0; v < n; v++) {
+	const reg_dfa_nstate * const st = &f->nfa[v];
+	if (st->out1 >= 0)
+	    first[st->out1 + 1]++;
+	if (st->out2 >= 0)
+	    first[st->out2 + 1]++;
+    }
+    first[f->start + 1]++;
+    for (v = 0; v < n; v++)
+	first[v + 1] += first[v];
+    Newx(fill, n, I32);
+    Copy(first, fill, n, I32);
+    Newx(targets, first[n], I32);
+
+    Newx(r->nfa, 2 * n + 1 + first[n], reg_dfa_nstate);
+    for (v = 0; v < n; v++) {
+	const reg_dfa_nstate * const st = &f->nfa[v];
+	reg_dfa_nstate * const rt = &r->nfa[n + v];
+	if (st->cls == REG_DFA_EPSILON) {
+	    rt->cls = REG_DFA_EPSILON;
+	    rt->out1 = -1;
+	    if (st->out1 >= 0)
+		targets[fill[st->out1]++] = v;
+	    if (st->out2 >= 0)
+		targets[fill[st->out2]++] = v;
+	}
+	else {
+	    rt->cls = st->cls;
+	    rt->out1 = v;
+	    if (st->out1 >= 0)
+		targets[fill[st->out1]++] = n + v;
+	}
+	rt->out2 = -1;
+    }
+    targets[fill[f->start]++] = 2 * n;
+    r->nfa[2 * n].cls = REG_DFA_EPSILON;
+    r->nfa[2 * n].out1 = r->nfa[2 * n].out2 = -1;
+    r->nstates = 2 * n + 1;
+    r->start = f->match;
+    r->match = 2 * n;
+
+    for (v = 0; v < n; v++) {
+	I32 j = first[v];
+	const I32 e = first[v + 1];
+	I32 at = v;
+	for (;;) {
+	    reg_dfa_nstate * const rt = &r->nfa[at];
+	    rt->cls = REG_DFA_EPSILON;
+	    rt->out1 = j < e ? targets[j++] : -1;
+	    if (e - j <= 1) {
+		rt->out2 = j < e ? targets[j++] : -1;
+		break;
+	    }
+	    rt->out2 = r->nstates;
+	    at = r->nstates++;
+	}
+    }
+    Safefree(first);
+    Safefree(fill);
+    Safefree(targets);
+}
+
+/* Allocate the tables for m's DFA states */
+
+static void
+S_dfa_machine_init(pTHX_ reg_dfa_machine *m, const U16 ncols)
+{
+    I32 i;
+
+    m->maxdstates = 16;
+    Newx(m->trans, m->maxdstates * ncols, I32);
+    Newx(m->accepts, m->maxdstates, U8);
+    Newx(m->setoff, m->maxdstates, I32);
+    Newx(m->setlen, m->maxdstates, I32);
+    m->setsmax = 64;
+    Newx(m->sets, m->setsmax, I32);
+    m->hashmask = 31;
+    Newx(m->hash, m->hashmask + 1, I32);
+    for (i = 0; i <= m->hashmask; i++)
+	m->hash[i] = -1;
+    Newx(m->stack, 2 * m->nstates + 1, I32);
+    Newx(m->set, m->nstates + 1, I32);
+    Newxz(m->seen, m->nstates, U32);
+}
+
+/* Build the NFAs for prog's program into progi->dfa, and the DFAs' first
+ * states.  Returns false (having marked it as failed) if it can't be
+ * done. */
+
+static bool
+S_dfa_compile(pTHX_ regexp *prog, regmatch_info *reginfo)
+{
+    RXi_GET_DECL(prog, progi);
+    reg_dfa * const dfa = progi->dfa;
+    dfa_build b;
+    U16 remap[512];
+    U16 ncols = 1;
+    U32 proglen;
+    I32 i;
+
+    dfa->built = TRUE;	/* freed with the pattern, whatever happens */
+    b.dfa = dfa;
+    b.prog = prog;
+    b.progi = progi;
+    b.reginfo = reginfo;
+    b.nstates_max = 64;
+    b.nclasses_max = 16;
+    b.epoch = b.epochs = 1;
+    b.cont = -1;
+    b.depth = 0;
+    b.unbounded = 0;
+    b.minmod = FALSE;
+    b.inexact = FALSE;
+    b.failed = FALSE;
+    for (i = 0; i < 256; i++)
+	b.single[i] = -1;
+#ifdef RE_TRACK_PATTERN_OFFSETS
+    proglen = progi->u.offsets[0];
+#else
+    proglen = progi->u.proglen;
+#endif
+    Newx(b.memo, proglen + 1, I32);
+    Newxz(b.memoepoch, proglen + 1, U32);
+    Newx(dfa->fwd.nfa, b.nstates_max, reg_dfa_nstate);
+    Newx(dfa->classes, b.nclasses_max, reg_dfa_class);
+
+    dfa->fwd.match = S_dfa_state(aTHX_ &b, REG_DFA_EPSILON, -1, -1);
+    dfa->fwd.start = S_dfa_from(aTHX_ &b, progi->program + 1);
+    Safefree(b.memo);
+    Safefree(b.memoepoch);
+    /* an anchored pattern is only tried at the start, where with at most
+     * one unbounded repeat, and that of a single character, regmatch()
+     * takes no longer than the DFA would; and if the DFA can't find the
+     * same match as regmatch(), regtry() would have to be run anyway */
+    if ((dfa->anchored && b.unbounded < 2) || b.inexact)
+	b.failed = TRUE;
+    if (b.failed) {
+	/* and for any copies of prog sharing progi too */
+	dfa->failed = TRUE;
+	return FALSE;
+    }
+    dfa->fwd.ordered = TRUE;
+    dfa->fwd.restart = !dfa->anchored;
+    S_dfa_reverse(aTHX_ dfa);
+
+    /* split the bytes into columns, so that bytes in the same column are
+     * in the same classes */
+    Zero(dfa->bytemap, 256, U8);
+    for (i = 0; i < dfa->nclasses; i++) {
+	const U8 * const bits = dfa->classes[i].bits;
+	int c;
+	for (c = 0; c < 512; c++)
+	    remap[c] = 0xFFFF;
+	ncols = 0;
+	for (c = 0; c < 256; c++) {
+	    const int key = dfa->bytemap[c] * 2 + ((bits[c >> 3] >> (c & 7)) & 1);
+	    if (remap[key] == 0xFFFF)
+		remap[key] = (U8)ncols++;
+	    dfa->bytemap[c] = remap[key];
+	}
+    }
+    for (i = 255; i >= 0; i--)
+	dfa->repr[dfa->bytemap[i]] = (U8)i;
+    dfa->ncols = ncols + 1;	/* and one for the end of the string */
+
+    S_dfa_machine_init(aTHX_ &dfa->fwd, dfa->ncols);
+    S_dfa_machine_init(aTHX_ &dfa->rev, dfa->ncols);
+    dfa->fwd.startstate = S_dfa_start_state(aTHX_ dfa, &dfa->fwd, FALSE);
+    dfa->rev.startstate = S_dfa_start_state(aTHX_ dfa, &dfa->rev, FALSE);
+    dfa->rev.eosstartstate = S_dfa_start_state(aTHX_ dfa, &dfa->rev, TRUE);
+
+    /* find the bytes on which the forward machine stays in its start
+     * state, so S_dfa_search() can skip them a byte at a time */
+    if (!dfa->fwd.accepts[dfa->fwd.startstate]) {
+	reg_dfa_machine * const m = &dfa->fwd;
+	const I32 d = m->startstate;
+	U16 col;
+	for (col = 0; col < ncols; col++)
+	    m->trans[d * dfa->ncols + col] = S_dfa_step(aTHX_ dfa, m, d, col);
+	for (i = 0; i < 256; i++)
+	    dfa->startskip[i] = m->trans[d * dfa->ncols + dfa->bytemap[i]] == d;
+    }
+    return TRUE;
+}
+
+/* Run the forward machine from s.  Returns 1 if the pattern matches
+ * there or later (or for an anchored pattern, at s), setting *endp to
+ * where the match ends; 0 if it doesn't; or -1 if the DFA got too big to
+ * say. */
+
+static int
+S_dfa_search(pTHX_ reg_dfa *dfa, const U8 *s, const U8 * const strend,
+	     const U8 **endp)
+{
+    reg_dfa_machine * const m = &dfa->fwd;
+    const U16 ncols = dfa->ncols;
+    const U8 *end = NULL;
+    I32 d = m->startstate;
+
+    for (;;) {
+	U16 col;
+	I32 next;
+
+	if (d == m->startstate)
+	    while (s < strend && dfa->startskip[*s])
+		s++;
+	col = s < strend ? dfa->bytemap[*s] : ncols - 1;
+	if (m->accepts[d] == 1)
+	    end = s;
+	else if (m->accepts[d] == 2)
+	    break;
+	next = m->trans[d * ncols + col];
+	if (next < 0) {
+	    next = S_dfa_step(aTHX_ dfa, m, d, col);
+	    if (next < 0)
+		return -1;
+	    m->trans[d * ncols + col] = next;
+	}
+	if (s == strend) {
+	    /* that was the transition on the end of the string */
+	    if (m->accepts[next] == 1)
+		end = strend;
+	    break;
+	}
+	d = next;
+	s++;
+    }
+    *endp = end;
+    return end != NULL;
+}
+
+/* Run the reverse machine back from end, where S_dfa_search() found a
+ * match ends, to s.  Returns the earliest place the match can start, or
+ * NULL if the DFA got too big to say. */
+
+static const U8 *
+S_dfa_rsearch(pTHX_ reg_dfa *dfa, const U8 * const s, const U8 *end,
+	      const U8 * const strend)
+{
+    reg_dfa_machine * const m = &dfa->rev;
+    const U16 ncols = dfa->ncols;
+    const U8 *start = NULL;
+    I32 d = end == strend ? m->eosstartstate : m->startstate;
+
+    for (;;) {
+	U16 col;
+	I32 next;
+
+	if (m->accepts[d] == 1)
+	    start = end;
+	if (m->accepts[d] == 2 || end == s)
+	    break;
+	col = dfa->bytemap[*--end];
+	next = m->trans[d * ncols + col];
+	if (next < 0) {
+	    next = S_dfa_step(aTHX_ dfa, m, d, col);
+	    if (next < 0)
+		return NULL;
+	    m->trans[d * ncols + col] = next;
+	}
+	d = next;
+    }
+    return start;
+}
+
+/* Under "use re steps => N", count a step of regmatch() or of
+ * S_jit_match(), and croak once a match has taken N of them, so that a
+ * pattern which backtracks badly can't run for ever */
+
+#define REG_STEP(reginfo)						\
+    STMT_START {							\
+	if (UNLIKELY((reginfo)->steps_left)				\
+	    && UNLIKELY(!--(reginfo)->steps_left))			\
+	    S_reg_steps_exceeded(aTHX_ (reginfo));			\
+    } STMT_END
+
+PERL_STATIC_NO_RET void
+S_reg_steps_exceeded(pTHX_ const regmatch_info *reginfo)
+{
+    Perl_croak(aTHX_ "Regexp step limit (%"UVuf") exceeded",
+	       RXi_GET(ReANY(reginfo->prog))->maxsteps);
+}
+
+/*
+ - Compiled programs
+
+ Under "use re 'jit'", regcomp.c also marks the patterns which need none
+ of the backtracking engine's extras, as for the DFA, with PREGf_JIT.
+ Once such a pattern has been matched REG_JIT_HOT times against
+ non-UTF-8 strings, its program is compiled (S_jit_compile()) into a flat
+ array of reg_jit_ops, which S_jit_match() then runs in place of
+ regmatch().  Single-character nodes become
+ 256-bit classes of bytes, EXACT strings and the words of tries are
+ copied out, the alternatives of a BRANCH are laid out with jumps
+ between them, an optional group (A? or A??) becomes a SPLIT around its
+ body, and a repeat of a single character also gets the class of the
+ byte which must follow it, to skip the counts that can't work.
+
+ S_jit_match() backtracks in the same order as regmatch(), and sets and
+ unwinds the captures in the same way, so the match found is the same;
+ it just doesn't need to look at regnodes, push regmatch_states or think
+ about UTF-8.  A program with any node S_jit_compile() doesn't know is
+ left to regmatch().
+*/
+
+#define REG_JIT_HOT 8	/* matches before a program is compiled */
+
+#define JIT_IN_CLASS(bits, c) ((bits)[(U8)(c) >> 3] & (1 << ((c) & 7)))
+
+typedef struct {
+    reg_jit *jit;
+    regexp *prog;
+    regexp_internal *progi;
+    regmatch_info *reginfo;
+    I32 *pcmap;			/* the first op of each node compiled */
+    I32 nopsmax;
+    I32 nclassesmax;
+    I32 stringsmax;
+    I32 single[256];		/* class matching just the byte, if made */
+    regnode **todo;		/* BRANCHes still to compile ... */
+    I32 *todopc;		/* ... and the SPLITs that go to them */
+    regnode **cont;		/* where each optional group's WHILEM or
+				   SUCCEED goes on to ... */
+    U32 *close;			/* ... and the capture it closes, if any */
+    I32 ntodo;
+    I32 todomax;
+} jit_build;
+
+static I32
+S_jit_op(pTHX_ jit_build *b, const U8 type, const I32 arg1, const I32 arg2)
+{
+    reg_jit * const jit = b->jit;
+    reg_jit_op *op;
+
+    if (jit->nops == b->nopsmax) {
+	b->nopsmax *= 2;
+	Renew(jit->ops, b->nopsmax, reg_jit_op);
+    }
+    op = &jit->ops[jit->nops];
+    op->type = type;
+    op->minmod = FALSE;
+    op->cls = -1;
+    op->follow = -1;
+    op->arg1 = arg1;
+    op->arg2 = arg2;
+    return jit->nops++;
+}
+
+static I32
+S_jit_class(pTHX_ jit_build *b, const U8 *bits)
+{
+    reg_jit * const jit = b->jit;
+
+    if (jit->nclasses == b->nclassesmax) {
+	b->nclassesmax *= 2;
+	Renew(jit->classes, b->nclassesmax, reg_dfa_class);
+    }
+    Copy(bits, jit->classes[jit->nclasses].bits, 32, U8);
+    return jit->nclasses++;
+}
+
+/* the class of the byte c of an EXACT-like node op */
+
+static I32
+S_jit_byte_class(pTHX_ jit_build *b, const U8 op, const U8 c)
+{
+    U8 bits[32];
+
+    if (op == EXACT && b->single[c] >= 0)
+	return b->single[c];
+    S_reg_exact_bits(op, c, bits);
+    if (op == EXACT)
+	return b->single[c] = S_jit_class(aTHX_ b, bits);
+    return S_jit_class(aTHX_ b, bits);
+}
+
+/* a CLASS op for the class cls */
+
+static void
+S_jit_class_op(pTHX_ jit_build *b, const I32 cls)
+{
+    const I32 pc = S_jit_op(aTHX_ b, REG_JIT_CLASS, 0, 0);
+    b->jit->ops[pc].cls = cls;
+}
+
+/* the class of the single-character node p, or -1 if it isn't one */
+
+static I32
+S_jit_node_class(pTHX_ jit_build *b, const regnode *p)
+{
+    U8 bits[32];
+
+    switch (OP(p)) {
+    case EXACT:
+    case EXACTF:
+    case EXACTFU:
+    case EXACTFA:
+    case EXACTFA_NO_TRIE:
+	if (STR_LEN(p) != 1)
+	    return -1;
+	return S_jit_byte_class(aTHX_ b, OP(p), *(U8 *)STRING(p));
+
+    case REG_ANY:
+    case SANY:
+    case CANY:
+    case ANYOF:
+    case POSIXD:
+    case POSIXU:
+    case POSIXA:
+    case NPOSIXD:
+    case NPOSIXU:
+    case NPOSIXA:
+	S_reg_class_bits(aTHX_ b->prog, p, b->reginfo, bits);
+	return S_jit_class(aTHX_ b, bits);
+
+    default:
+	return -1;
+    }
+}
+
+/* a STR op for the len bytes at s */
+
+static void
+S_jit_str(pTHX_ jit_build *b, const U8 *s, const I32 len)
+{
+    reg_jit * const jit = b->jit;
+
+    if (jit->stringslen + len > b->stringsmax) {
+	b->stringsmax = 2 * (jit->stringslen + len);
+	Renew(jit->strings, b->stringsmax, U8);
+    }
+    Copy(s, jit->strings + jit->stringslen, len, U8);
+    S_jit_op(aTHX_ b, REG_JIT_STR, jit->stringslen, len);
+    jit->stringslen += len;
+}
+
+/* Set bytes[] to the byte each charid of an EXACT trie stands for.
+ * Returns false if some charid stands for more than one */
+
+static bool
+S_trie_bytes(const reg_trie_data *trie, U8 *bytes)
+{
+    bool used[256 + 1];
+    int i;
+
+    Zero(used, sizeof(used), bool);
+    for (i = 0; i < 256; i++) {
+	const U16 charid = trie->charmap[i];
+	if (charid) {
+	    if (charid > 256 || used[charid])
+		return FALSE;
+	    used[charid] = TRUE;
+	    bytes[charid] = (U8)i;
+	}
+    }
+    return TRUE;
+}
+
+/* Collect the words of the trie from state on, with the prefix in
+ * buf[0..len), into words[] by their word number */
+
+static bool
+S_trie_words(pTHX_ const reg_trie_data *trie, const U8 *bytes,
+	     const U32 state, U8 *buf, const I32 len, SV **words)
+{
+    const U32 base = trie->states[state].trans.base;
+    const U16 wordnum = trie->states[state].wordnum;
+
+    if (wordnum && !words[wordnum])
+	words[wordnum] = newSVpvn((char *)buf, len);
+    if (base) {
+	U16 charid;
+	for (charid = 1; charid <= trie->uniquecharcount; charid++) {
+	    const I32 offset = base + charid - 1 - trie->uniquecharcount;
+
+	    if (offset < 0 || (U32)offset >= trie->lasttrans
+		|| trie->trans[offset].check != state)
+		continue;
+	    if (len >= 255)
+		return FALSE;
+	    buf[len] = bytes[charid];
+	    if (!S_trie_words(aTHX_ trie, bytes, trie->trans[offset].next,
+			      buf, len + 1, words))
+		return FALSE;
+	}
+    }
+    return TRUE;
+}
+
+/* A TRIE of EXACT strings without jumps, as alternatives of its words
+ * in the order regmatch() tries them, which is by word number */
+
+static bool
+S_jit_trie(pTHX_ jit_build *b, const regnode *p)
+{
+    const reg_trie_data * const trie
+	= (reg_trie_data *)b->progi->data->data[ARG(p)];
+    U8 bytes[256 + 1];
+    U8 buf[256];
+    SV **words;
+    I32 *jumps;
+    I32 i, last = 0, njumps = 0;
+    bool ok;
+
+    if (p->flags != EXACT || trie->jump || !S_trie_bytes(trie, bytes))
+	return FALSE;
+
+    Newxz(words, trie->wordcount + 1, SV *);
+    Newx(jumps, trie->wordcount + 1, I32);
+    ok = S_trie_words(aTHX_ trie, bytes, trie->startstate, buf, 0, words);
+    for (i = 1; i <= (I32)trie->wordcount; i++)
+	if (words[i])
+	    last = i;
+    for (i = 1; ok && i <= last; i++) {
+	I32 split = -1;
+	if (!words[i])
+	    continue;
+	/* SPLIT STR JUMP for each word but the last */
+	if (i < last)
+	    split = S_jit_op(aTHX_ b, REG_JIT_SPLIT, -1, 0);
+	S_jit_str(aTHX_ b, (U8 *)SvPVX(words[i]), SvCUR(words[i]));
+	if (i < last) {
+	    jumps[njumps++] = S_jit_op(aTHX_ b, REG_JIT_JUMP, -1, 0);
+	    b->jit->ops[split].arg1 = b->jit->nops;
+	}
+    }
+    while (njumps)
+	b->jit->ops[jumps[--njumps]].arg1 = b->jit->nops;
+    if (!last)
+	ok = FALSE;
+
+    for (i = 0; i <= (I32)trie->wordcount; i++)
+	SvREFCNT_dec(words[i]);
+    Safefree(words);
+    Safefree(jumps);
+    return ok;
+}
+
+/* Add an op of the type (a SPLIT or JUMP) which goes to p, to be
+ * compiled later if it isn't by then */
+
+static void
+S_jit_todo(pTHX_ jit_build *b, regnode *p, const U8 type)
+{
+    if (b->ntodo == b->todomax) {
+	b->todomax *= 2;
+	Renew(b->todo, b->todomax, regnode *);
+	Renew(b->todopc, b->todomax, I32);
+    }
+    b->todo[b->ntodo] = p;
+    b->todopc[b->ntodo++] = S_jit_op(aTHX_ b, type, -1, 0);
+}
+
+/* Compile the program from p on, until it gets to END or to a node
+ * already compiled.  Returns false if it has a node that can't be. */
+
+static bool
+S_jit_chain(pTHX_ jit_build *b, regnode *p)
+{
+    reg_jit * const jit = b->jit;
+    bool minmod = FALSE;
+
+    for (;;) {
+	const I32 off = p - b->progi->program;
+	regnode *next = regnext(p);
+	I32 i;
+
+	if (b->pcmap[off] >= 0) {
+	    S_jit_op(aTHX_ b, REG_JIT_JUMP, b->pcmap[off], 0);
+	    return TRUE;
+	}
+	b->pcmap[off] = jit->nops;
+
+	switch (OP(p)) {
+	case END:
+	    S_jit_op(aTHX_ b, REG_JIT_END, 0, 0);
+	    return TRUE;
+
+	case NOTHING:
+	case TAIL:
+	case LONGJMP:
+	case OPTIMIZED:
+	    break;
+
+	case WHILEM:
+	case SUCCEED:
+	    /* the end of an optional group's body */
+	    if (!b->cont[off])
+		return FALSE;
+	    if (b->close[off])
+		S_jit_op(aTHX_ b, REG_JIT_CLOSE, b->close[off], 0);
+	    next = b->cont[off];
+	    break;
+
+	case MINMOD:
+	    minmod = TRUE;
+	    break;
+
+	case OPEN:
+	    S_jit_op(aTHX_ b, REG_JIT_OPEN, ARG(p), 0);
+	    break;
+	case CLOSE:
+	    S_jit_op(aTHX_ b, REG_JIT_CLOSE, ARG(p), 0);
+	    break;
+
+	case SBOL:
+	    S_jit_op(aTHX_ b, REG_JIT_SBOL, 0, 0);
+	    break;
+	case MBOL:
+	    S_jit_op(aTHX_ b, REG_JIT_MBOL, 0, 0);
+	    break;
+	case SEOL:
+	    S_jit_op(aTHX_ b, REG_JIT_SEOL, 0, 0);
+	    break;
+	case MEOL:
+	    S_jit_op(aTHX_ b, REG_JIT_MEOL, 0, 0);
+	    break;
+	case EOS:
+	    S_jit_op(aTHX_ b, REG_JIT_EOS, 0, 0);
+	    break;
+
+	case EXACT:
+	    S_jit_str(aTHX_ b, (U8 *)STRING(p), STR_LEN(p));
+	    break;
+
+	case EXACTF:
+	case EXACTFU:
+	case EXACTFA:
+	case EXACTFA_NO_TRIE:
+	    for (i = 0; i < STR_LEN(p); i++)
+		S_jit_class_op(aTHX_ b, S_jit_byte_class(aTHX_ b, OP(p),
+						    ((U8 *)STRING(p))[i]));
+	    break;
+
+	case REG_ANY:
+	case SANY:
+	case CANY:
+	case ANYOF:
+	case POSIXD:
+	case POSIXU:
+	case POSIXA:
+	case NPOSIXD:
+	case NPOSIXU:
+	case NPOSIXA:
+	    S_jit_class_op(aTHX_ b, S_jit_node_class(aTHX_ b, p));
+	    break;
+
+	case STAR:
+	case PLUS:
+	case CURLY:
+	{
+	    const regnode * const a = OP(p) == CURLY
+		? NEXTOPER(p) + NODE_STEP_REGNODE : NEXTOPER(p);
+	    const I32 cls = S_jit_node_class(aTHX_ b, a);
+	    reg_jit_op *op;
+
+	    if (cls < 0)
+		return FALSE;
+	    i = S_jit_op(aTHX_ b, REG_JIT_REPEAT,
+			 OP(p) == STAR ? 0 : OP(p) == PLUS ? 1 : ARG1(p),
+			 OP(p) == CURLY ? ARG2(p) : REG_INFTY);
+	    op = &jit->ops[i];
+	    op->cls = cls;
+	    op->minmod = minmod;
+	    minmod = FALSE;
+	    break;
+	}
+
+	case CURLYX:
+	case CURLYM:
+	case CURLYN:
+	{
+	    /* only A? and A??, as a SPLIT around the body: greedily
+	     * trying it first and then going on without it, or the other
+	     * way round, which is all regmatch() can do with them */
+	    regnode *a, *end = NULL;
+	    U32 paren = 0;
+
+	    if (ARG1(p) != 0 || ARG2(p) != 1)
+		return FALSE;
+	    if (OP(p) == CURLYX) {
+		if (OP(PREVOPER(next)) == NOTHING) /* LONGJMP */
+		    next += ARG(next);
+		a = NEXTOPER(p) + EXTRA_STEP_2ARGS;
+		end = PREVOPER(next);
+		if (OP(end) != WHILEM)
+		    return FALSE;
+	    }
+	    else if (OP(p) == CURLYM) {
+		a = NEXTOPER(p) + NODE_STEP_REGNODE;
+		if ((paren = p->flags))
+		    a += NEXT_OFF(a);	/* skip the former OPEN */
+		for (end = a; end && OP(end) != SUCCEED; end = regnext(end))
+		    if (OP(end) == END)
+			return FALSE;
+		if (!end)
+		    return FALSE;
+	    }
+	    else {
+		a = regnext(NEXTOPER(p) + NODE_STEP_REGNODE);
+		paren = p->flags;
+	    }
+
+	    if (minmod) {
+		const I32 split = S_jit_op(aTHX_ b, REG_JIT_SPLIT, -1, 0);
+		jit->ops[split].arg1 = split + 2;
+		S_jit_todo(aTHX_ b, next, REG_JIT_JUMP);
+	    }
+	    else
+		S_jit_todo(aTHX_ b, next, REG_JIT_SPLIT);
+	    minmod = FALSE;
+	    if (paren)
+		S_jit_op(aTHX_ b, REG_JIT_OPEN, paren, 0);
+
+	    if (OP(p) == CURLYN) {
+		const I32 cls = S_jit_node_class(aTHX_ b, a);
+		if (cls < 0)
+		    return FALSE;
+		S_jit_class_op(aTHX_ b, cls);
+		if (paren)
+		    S_jit_op(aTHX_ b, REG_JIT_CLOSE, paren, 0);
+	    }
+	    else {
+		/* the body goes on to next from its end */
+		b->cont[end - b->progi->program] = next;
+		b->close[end - b->progi->program] = paren;
+		next = a;
+	    }
+	    break;
+	}
+
+	case BRANCH:
+	case BRANCHJ:
+	    /* as in regmatch(), the last branch is the one not followed
+	     * by another; the others leave a way back to the next, and
+	     * even the last one unwinds the captures if it fails */
+	    if (next && OP(next) == OP(p)) {
+		S_jit_todo(aTHX_ b, next, REG_JIT_SPLIT);
+	    }
+	    else if (b->prog->nparens)
+		S_jit_op(aTHX_ b, REG_JIT_SPLIT, -1, 0);
+	    next = OP(p) == BRANCH ? NEXTOPER(p) : NEXTOPER(NEXTOPER(p));
+	    break;
+
+	case TRIE:
+	case TRIEC:
+	    if (!S_jit_trie(aTHX_ b, p))
+		return FALSE;
+	    break;
+
+	default:
+	    /* anything else (backreferences, lookaround, loops, ...) */
+	    return FALSE;
+	}
+	p = next;
+    }
+}
+
+/* Compile prog's program for S_jit_match().  Returns false (having
+ * marked progi->jit as failed) if it can't be. */
+
+static bool
+S_jit_compile(pTHX_ regexp *prog, regmatch_info *reginfo)
+{
+    RXi_GET_DECL(prog, progi);
+    reg_jit * const jit = progi->jit;
+    jit_build b;
+    U32 proglen;
+    bool ok;
+    I32 i;
+
+    b.jit = jit;
+    b.prog = prog;
+    b.progi = progi;
+    b.reginfo = reginfo;
+    b.nopsmax = 32;
+    b.nclassesmax = 8;
+    b.stringsmax = 64;
+    b.todomax = 8;
+    b.ntodo = 0;
+    for (i = 0; i < 256; i++)
+	b.single[i] = -1;
+#ifdef RE_TRACK_PATTERN_OFFSETS
+    proglen = progi->u.offsets[0];
+#else
+    proglen = progi->u.proglen;
+#endif
+    Newx(b.pcmap, proglen + 1, I32);
+    for (i = 0; i <= (I32)proglen; i++)
+	b.pcmap[i] = -1;
+    Newx(b.todo, b.todomax, regnode *);
+    Newx(b.todopc, b.todomax, I32);
+    Newxz(b.cont, proglen + 1, regnode *);
+    Newxz(b.close, proglen + 1, U32);
+    Newx(jit->ops, b.nopsmax, reg_jit_op);
+    Newx(jit->classes, b.nclassesmax, reg_dfa_class);
+    Newx(jit->strings, b.stringsmax, U8);
+
+    /* the main line, then each branch's other alternatives */
+    ok = S_jit_chain(aTHX_ &b, progi->program + 1);
+    while (ok && b.ntodo) {
+	regnode * const p = b.todo[--b.ntodo];
+	const I32 pc = b.todopc[b.ntodo];
+	const I32 off = p - progi->program;
+
+	if (b.pcmap[off] >= 0)
+	    jit->ops[pc].arg1 = b.pcmap[off];
+	else {
+	    jit->ops[pc].arg1 = jit->nops;
+	    ok = S_jit_chain(aTHX_ &b, p);
+	}
+    }
+    Safefree(b.pcmap);
+    Safefree(b.todo);
+    Safefree(b.todopc);
+    Safefree(b.cont);
+    Safefree(b.close);
+
+    if (!ok) {
+	Safefree(jit->ops);
+	Safefree(jit->classes);
+	Safefree(jit->strings);
+	jit->ops = NULL;
+	jit->classes = NULL;
+	jit->strings = NULL;
+	jit->failed = TRUE;
+	return FALSE;
+    }
+
+    /* what must follow each repeat, looking through jumps */
+    for (i = 0; i < jit->nops; i++) {
+	reg_jit_op * const op = &jit->ops[i];
+	const reg_jit_op *after;
+	I32 pc = i + 1;
+
+	if (op->type != REG_JIT_REPEAT)
+	    continue;
+	while (jit->ops[pc].type == REG_JIT_JUMP)
+	    pc = jit->ops[pc].arg1;
+	after = &jit->ops[pc];
+	if (after->type == REG_JIT_CLASS
+	    || (after->type == REG_JIT_REPEAT && after->arg1 > 0))
+	    op->follow = after->cls;
+	else if (after->type == REG_JIT_STR && after->arg2 > 0)
+	    op->follow = S_jit_byte_class(aTHX_ &b, EXACT,
+					  jit->strings[after->arg1]);
+    }
+
+    jit->stackmax = 16;
+    Newx(jit->stack, jit->stackmax, reg_jit_frame);
+    return TRUE;
+}
+
+/* Match the compiled program at startpos, as regmatch() would.  Returns
+ * the offset of the end of the match, or -1. */
+
+static SSize_t
+S_jit_match(pTHX_ regmatch_info *reginfo, reg_jit *jit, char *startpos)
+{
+    regexp * const rex = ReANY(reginfo->prog);
+    const U8 * const strbeg = (U8 *)reginfo->strbeg;
+    const U8 * const strend = (U8 *)reginfo->strend;
+    const reg_jit_op * const ops = jit->ops;
+    const U8 *s = (U8 *)startpos;
+    const U8 *start;
+    I32 pc = 0, sp = 0, count;
+    U32 n;
+
+    for (;;) {
+	const reg_jit_op * const op = &ops[pc];
+
+	switch (op->type) {
+	case REG_JIT_CLASS:
+	    if (s >= strend || !JIT_IN_CLASS(jit->classes[op->cls].bits, *s))
+		goto fail;
+	    s++;
+	    break;
+
+	case REG_JIT_STR:
+	    if (strend - s < op->arg2
+		|| memNE(s, jit->strings + op->arg1, op->arg2))
+		goto fail;
+	    s += op->arg2;
+	    break;
+
+	case REG_JIT_SPLIT:
+	    if (sp == jit->stackmax) {
+		jit->stackmax *= 2;
+		Renew(jit->stack, jit->stackmax, reg_jit_frame);
+	    }
+	    jit->stack[sp].pc = pc;
+	    jit->stack[sp].pos = s - strbeg;
+	    jit->stack[sp].lastparen = rex->lastparen;
+	    jit->stack[sp++].lastcloseparen = rex->lastcloseparen;
+	    break;
+
+	case REG_JIT_JUMP:
+	    pc = op->arg1;
+	    continue;
+
+	case REG_JIT_REPEAT:
+	{
+	    const U8 * const bits = jit->classes[op->cls].bits;
+	    const I32 most = op->minmod ? op->arg1
+		: op->arg2 == REG_INFTY || op->arg2 > strend - s
+		? (I32)(strend - s) : op->arg2;
+
+	    start = s;
+	    for (count = 0;
+		 count < most && s + count < strend && JIT_IN_CLASS(bits, s[count]);
+		 count++)
+		;
+	    if (count < op->arg1)
+		goto fail;
+	    if (op->minmod)
+		goto repeat_min;
+	    goto repeat_max;
+	}
+
+	case REG_JIT_OPEN:
+	    rex->offs[op->arg1].start_tmp = s - strbeg;
+	    break;
+
+	case REG_JIT_CLOSE:
+	    n = op->arg1;
+	    rex->offs[n].start = rex->offs[n].start_tmp;
+	    rex->offs[n].end = s - strbeg;
+	    if (n > rex->lastparen)
+		rex->lastparen = n;
+	    rex->lastcloseparen = n;
+	    break;
+
+	case REG_JIT_SBOL:
+	    if (s != strbeg)
+		goto fail;
+	    break;
+
+	case REG_JIT_MBOL:
+	    if (s != strbeg && (s >= strend || s[-1] != '\n'))
+		goto fail;
+	    break;
+
+	case REG_JIT_SEOL:
+	    if (s < strend && (*s != '\n' || strend - s > 1))
+		goto fail;
+	    break;
+
+	case REG_JIT_MEOL:
+	    if (s < strend && *s != '\n')
+		goto fail;
+	    break;
+
+	case REG_JIT_EOS:
+	    if (s < strend)
+		goto fail;
+	    break;
+
+	case REG_JIT_END:
+	    if (s < (U8 *)reginfo->till)
+		goto fail;	/* too short */
+	    return s - strbeg;
+	}
+	pc++;
+	continue;
+
+      fail:
+	if (!sp)
+	    return -1;
+	REG_STEP(reginfo);
+	{
+	    const reg_jit_frame * const fr = &jit->stack[--sp];
+	    pc = fr->pc;
+	    s = strbeg + fr->pos;
+	    if (ops[pc].type == REG_JIT_SPLIT) {
+		/* as UNWIND_PAREN() */
+		if (rex->lastparen > fr->lastparen) {
+		    for (n = rex->lastparen; n > fr->lastparen; n--)
+			rex->offs[n].end = -1;
+		    rex->lastparen = n;
+		}
+		rex->lastcloseparen = fr->lastcloseparen;
+		pc = ops[pc].arg1;
+		if (pc < 0)
+		    goto fail;	/* that was the last branch */
+		continue;
+	    }
+	    start = s;
+	    count = fr->count;
+	    if (!ops[pc].minmod) {
+		count--;
+		goto repeat_max;
+	    }
+	    /* one more, if it can */
+	    if ((ops[pc].arg2 != REG_INFTY && count >= ops[pc].arg2)
+		|| start + count >= strend
+		|| !JIT_IN_CLASS(jit->classes[ops[pc].cls].bits, start[count]))
+		goto fail;
+	    count++;
+	}
+
+      repeat_min:
+	/* start[0..count) is the fewest repeats that might work: go on
+	 * from there, leaving a way back to try one more */
+	{
+	    const reg_jit_op * const op = &ops[pc];
+	    if (op->follow >= 0) {
+		const U8 * const bits = jit->classes[op->cls].bits;
+		const U8 * const follow = jit->classes[op->follow].bits;
+		while (start + count >= strend
+		       || !JIT_IN_CLASS(follow, start[count]))
+		{
+		    if ((op->arg2 != REG_INFTY && count >= op->arg2)
+			|| start + count >= strend
+			|| !JIT_IN_CLASS(bits, start[count]))
+			goto fail;
+		    count++;
+		}
+	    }
+	}
+	goto repeat_push;
+
+      repeat_max:
+	/* start[0..count) is the most repeats that might work: go on
+	 * from there, leaving a way back to try one fewer */
+	{
+	    const reg_jit_op * const op = &ops[pc];
+	    if (op->follow >= 0) {
+		const U8 * const follow = jit->classes[op->follow].bits;
+		while (count >= op->arg1
+		       && (start + count >= strend
+			   || !JIT_IN_CLASS(follow, start[count])))
+		    count--;
+	    }
+	    if (count < op->arg1)
+		goto fail;
+	    if (count == op->arg1)
+		goto repeat_go;
+	}
+
+      repeat_push:
+	if (sp == jit->stackmax) {
+	    jit->stackmax *= 2;
+	    Renew(jit->stack, jit->stackmax, reg_jit_frame);
+	}
+	jit->stack[sp].pc = pc;
+	jit->stack[sp].pos = start - strbeg;
+	jit->stack[sp++].count = count;
+
+      repeat_go:
+	s = start + count;
+	pc++;
+    }
+}
+
+/*
+ - Literal prefilter
+
+ A pattern with no start class and nothing to anchor it is tried by
+ regexec_flags() at every position in the string.  But many such
+ patterns, like /(?:GET|POST|PUT) |ERROR|WARN/, are alternations whose
+ every match must start with one of a few literal strings; study_chunk()
+ doesn't make a start class for them, and the words of several tries
+ can't go into one Aho-Corasick one.  So the first time such a pattern
+ gets to the general case there, S_prefilter_build() collects those
+ literals from its first EXACT, TRIE and BRANCH nodes, and from then on
+ S_prefilter_next() finds the places they start, skipping the bytes none
+ of them starts with, and regtry() is only called at those.
+*/
+
+typedef struct {
+    I32 n;
+    U8 lens[REG_PREFILTER_MAX];
+    char lits[REG_PREFILTER_MAX][REG_PREFILTER_LEN];
+} prefilter_build;
+
+/* Add the literal s[0..len) to the ones being collected */
+
+static bool
+S_prefilter_lit(prefilter_build *b, const U8 *s, STRLEN len)
+{
+    STRLEN i;
+
+    if (!len || b->n == REG_PREFILTER_MAX)
+	return FALSE;
+    if (len > REG_PREFILTER_LEN)
+	len = REG_PREFILTER_LEN;
+    /* so that the same bytes can be looked for in UTF-8 strings */
+    for (i = 0; i < len; i++)
+	if (!UTF8_IS_INVARIANT(s[i]))
+	    return FALSE;
+    Copy(s, b->lits[b->n], len, char);
+    b->lens[b->n++] = (U8)len;
+    return TRUE;
+}
+
+/* Collect the literals every match from p on starts with.  Returns false
+ * if some match might start with anything else */
+
+static bool
+S_prefilter_from(pTHX_ regexp *prog, prefilter_build *b, regnode *p)
+{
+    RXi_GET_DECL(prog,progi);
+
+    /* skip what matches the empty string at the start */
+    while (OP(p) == OPEN || OP(p) == CLOSE
+	   || OP(p) == NOTHING || OP(p) == TAIL)
+    {
+	p = regnext(p);
+	if (!p)
+	    return FALSE;
+    }
+
+    switch (OP(p)) {
+    case EXACT:
+	return S_prefilter_lit(b, (U8 *)STRING(p), STR_LEN(p));
+
+    case TRIE:
+    case TRIEC:
+    {
+	const reg_trie_data * const trie
+	    = (reg_trie_data *)progi->data->data[ARG(p)];
+	U8 bytes[256 + 1];
+	U8 buf[256];
+	SV **words;
+	U32 i;
+	bool ok;
+
+	if (p->flags != EXACT || !S_trie_bytes(trie, bytes))
+	    return FALSE;
+	Newxz(words, trie->wordcount + 1, SV *);
+	ok = S_trie_words(aTHX_ trie, bytes, trie->startstate, buf, 0, words);
+	for (i = 1; i <= trie->wordcount; i++) {
+	    if (ok && words[i])
+		ok = S_prefilter_lit(b, (U8 *)SvPVX(words[i]),
+				     SvCUR(words[i]));
+	    SvREFCNT_dec(words[i]);
+	}
+	Safefree(words);
+	return ok;
+    }
+
+    case BRANCH:
+    case BRANCHJ:
+    {
+	const U8 op = OP(p);
+	for (; p && OP(p) == op; p = regnext(p))
+	    if (!S_prefilter_from(aTHX_ prog, b, op == BRANCH
+					    ? NEXTOPER(p)
+					    : NEXTOPER(NEXTOPER(p))))
+		return FALSE;
+	return TRUE;
+    }
+
+    default:
+	return FALSE;
     }
-    return 0;
-  got_it:
-    return s;
 }
 
-/* set RX_SAVED_COPY, RX_SUBBEG etc.
- * flags have same meanings as with regexec_flags() */
+/* Make progi->prefilter for prog.  Returns false (having marked it as
+ * failed) if the pattern's matches don't all start with literals */
 
-static void
-S_reg_set_capture_string(pTHX_ REGEXP * const rx,
-                            char *strbeg,
-                            char *strend,
-                            SV *sv,
-                            U32 flags,
-                            bool utf8_target)
+static bool
+S_prefilter_build(pTHX_ regexp *prog, const regmatch_info *reginfo)
 {
-    struct regexp *const prog = ReANY(rx);
+    RXi_GET_DECL(prog,progi);
+    reg_prefilter *pf;
+    prefilter_build *b;
+    I32 i;
+    int c;
+    bool ok;
+
+    Newxz(pf, 1, reg_prefilter);
+    progi->prefilter = pf;
+    if (reginfo->is_utf8_pat) {
+	pf->failed = TRUE;
+	return FALSE;
+    }
 
-    if (flags & REXEC_COPY_STR) {
-#ifdef PERL_ANY_COW
-        if (SvCANCOW(sv)) {
-            if (DEBUG_C_TEST) {
-                PerlIO_printf(Perl_debug_log,
-                              "Copy on write: regexp capture, type %d\n",
-                              (int) SvTYPE(sv));
-            }
-            /* Create a new COW SV to share the match string and store
-             * in saved_copy, unless the current COW SV in saved_copy
-             * is valid and suitable for our purpose */
-            if ((   prog->saved_copy
-                 && SvIsCOW(prog->saved_copy)
-                 && SvPOKp(prog->saved_copy)
-                 && SvIsCOW(sv)
-                 && SvPOKp(sv)
-                 && SvPVX(sv) == SvPVX(prog->saved_copy)))
-            {
-                /* just reuse saved_copy SV */
-                if (RXp_MATCH_COPIED(prog)) {
-                    Safefree(prog->subbeg);
-                    RXp_MATCH_COPIED_off(prog);
-                }
-            }
-            else {
-                /* create new COW SV to share string */
-                RX_MATCH_COPY_FREE(rx);
-                prog->saved_copy = sv_setsv_cow(prog->saved_copy, sv);
-            }
-            prog->subbeg = (char *)SvPVX_const(prog->saved_copy);
-            assert (SvPOKp(prog->saved_copy));
-            prog->sublen  = strend - strbeg;
-            prog->suboffset = 0;
-            prog->subcoffset = 0;
-        } else
-#endif
-        {
-            SSize_t min = 0;
-            SSize_t max = strend - strbeg;
-            SSize_t sublen;
+    Newx(b, 1, prefilter_build);
+    b->n = 0;
+    ok = S_prefilter_from(aTHX_ prog, b, progi->program + 1);
+    if (ok) {
+	/* sort them by their first byte */
+	I32 at[256];
+	Zero(at, 256, I32);
+	for (i = 0; i < b->n; i++) {
+	    const U8 first = (U8)b->lits[i][0];
+	    at[first]++;
+	    pf->first[first >> 3] |= 1 << (first & 7);
+	}
+	for (c = 0; c < 256; c++) {
+	    pf->start[c + 1] = pf->start[c] + at[c];
+	    at[c] = pf->start[c];
+	}
+	for (i = 0; i < b->n; i++) {
+	    const I32 to = at[(U8)b->lits[i][0]]++;
+	    Copy(b->lits[i], pf->lits[to], b->lens[i], char);
+	    pf->lens[to] = b->lens[i];
+	}
+    }
+    else
+	pf->failed = TRUE;
+    Safefree(b);
+    return ok;
+}
 
-            if (    (flags & REXEC_COPY_SKIP_POST)
-                && !(prog->extflags & RXf_PMf_KEEPCOPY) /* //p */
-                && !(PL_sawampersand & SAWAMPERSAND_RIGHT)
-            ) { /* don't copy $' part of string */
-                U32 n = 0;
-                max = -1;
-                /* calculate the right-most part of the string covered
-                 * by a capture. Due to look-ahead, this may be to
-                 * the right of $&, so we have to scan all captures */
-                while (n <= prog->lastparen) {
-                    if (prog->offs[n].end > max)
-                        max = prog->offs[n].end;
-                    n++;
-                }
-                if (max == -1)
-                    max = (PL_sawampersand & SAWAMPERSAND_LEFT)
-                            ? prog->offs[0].start
-                            : 0;
-                assert(max >= 0 && max <= strend - strbeg);
-            }
+/* Return the first place from s to last on at which one of the literals
+ * starts, or NULL if there isn't one.  The literal may run on up to
+ * strend */
 
-            if (    (flags & REXEC_COPY_SKIP_PRE)
-                && !(prog->extflags & RXf_PMf_KEEPCOPY) /* //p */
-                && !(PL_sawampersand & SAWAMPERSAND_LEFT)
-            ) { /* don't copy $` part of string */
-                U32 n = 0;
-                min = max;
-                /* calculate the left-most part of the string covered
-                 * by a capture. Due to look-behind, this may be to
-                 * the left of $&, so we have to scan all captures */
-                while (min && n <= prog->lastparen) {
-                    if (   prog->offs[n].start != -1
-                        && prog->offs[n].start < min)
-                    {
-                        min = prog->offs[n].start;
-                    }
-                    n++;
-                }
-                if ((PL_sawampersand & SAWAMPERSAND_RIGHT)
-                    && min >  prog->offs[0].end
-                )
-                    min = prog->offs[0].end;
+static char *
+S_prefilter_next(const reg_prefilter *pf, char *s, const char *last,
+		 const char *strend)
+{
+    if (last >= strend)
+	last = strend - 1;
+    while (s <= last) {
+	U8 c;
+	I32 i;
 
-            }
+	s = S_find_next_in_skip(pf->first, s, last + 1);
+	if (s > last)
+	    break;
+	c = (U8)*s;
+	for (i = pf->start[c]; i < pf->start[c + 1]; i++)
+	    if (pf->lens[i] <= strend - s
+		&& memEQ(s, pf->lits[i], pf->lens[i]))
+	    {
+		return s;
+	    }
+	s++;
+    }
+    return NULL;
+}
 
-            assert(min >= 0 && min <= max && min <= strend - strbeg);
-            sublen = max - min;
+/* The time now in microseconds, for "use re 'stats'" */
 
-            if (RX_MATCH_COPIED(rx)) {
-                if (sublen > prog->sublen)
-                    prog->subbeg =
-                            (char*)saferealloc(prog->subbeg, sublen+1);
-            }
-            else
-                prog->subbeg = (char*)safemalloc(sublen+1);
-            Copy(strbeg + min, prog->subbeg, sublen, char);
-            prog->subbeg[sublen] = '\0';
-            prog->suboffset = min;
-            prog->sublen = sublen;
-            RX_MATCH_COPIED_on(rx);
-        }
-        prog->subcoffset = prog->suboffset;
-        if (prog->suboffset && utf8_target) {
-            /* Convert byte offset to chars.
-             * XXX ideally should only compute this if @-/@+
-             * has been seen, a la PL_sawampersand ??? */
+static UV
+S_reg_stats_usecs(pTHX)
+{
+#ifdef HAS_GETTIMEOFDAY
+    struct timeval now;
+    PerlProc_gettimeofday(&now, NULL);
+    return (UV)now.tv_sec * 1000000 + now.tv_usec;
+#else
+    PERL_UNUSED_CONTEXT;
+    return (UV)time(NULL) * 1000000;
+#endif
+}
 
-            /* If there's a direct correspondence between the
-             * string which we're matching and the original SV,
-             * then we can use the utf8 len cache associated with
-             * the SV. In particular, it means that under //g,
-             * sv_pos_b2u() will use the previously cached
-             * position to speed up working out the new length of
-             * subcoffset, rather than counting from the start of
-             * the string each time. This stops
-             *   $x = "\x{100}" x 1E6; 1 while $x =~ /(.)/g;
-             * from going quadratic */
-            if (SvPOKp(sv) && SvPVX(sv) == strbeg)
-                prog->subcoffset = sv_pos_b2u_flags(sv, prog->subcoffset,
-                                                SV_GMAGIC|SV_CONST_RETURN);
-            else
-                prog->subcoffset = utf8_length((U8*)strbeg,
-                                    (U8*)(strbeg+prog->suboffset));
-        }
-    }
-    else {
-        RX_MATCH_COPY_FREE(rx);
-        prog->subbeg = strbeg;
-        prog->suboffset = 0;
-        prog->subcoffset = 0;
-        prog->sublen = strend - strbeg;
-    }
+/* What an attempt to match costs is added to the pattern's counts from
+ * the save stack, so that it is counted even if matching croaks (which
+ * unwinds the save stack before it jumps out, so the structs on the C
+ * stack which these are passed are still there) */
+
+typedef struct {
+    reg_stats *stats;
+    UV start;
+    I32 matched;
+} reg_stats_attempt;
+
+static void
+S_reg_stats_attempt_done(pTHX_ void *arg)
+{
+    const reg_stats_attempt * const attempt = (reg_stats_attempt *)arg;
+
+    attempt->stats->usecs += S_reg_stats_usecs(aTHX) - attempt->start;
+    if (attempt->matched)
+	attempt->stats->matches++;
 }
 
+static void
+S_reg_stats_steps_done(pTHX_ void *arg)
+{
+    const regmatch_info * const reginfo = (regmatch_info *)arg;
 
+    RXi_GET(ReANY(reginfo->prog))->stats->steps
+	+= reginfo->steps_from - reginfo->steps_left;
+}
 
+static I32 S_regexec(pTHX_ REGEXP * const rx, char *stringarg, char *strend,
+	      char *strbeg, SSize_t minend, SV *sv, void *data, U32 flags);
 
 /*
  - regexec_flags - match a regexp against a string
@@ -2504,10 +4681,39 @@ Perl_regexec_flags(pTHX_ REGEXP * const rx, char *stringarg, char *strend,
 /* minend:    end of match must be >= minend bytes after stringarg. */
 /* sv:        SV being matched: only used for utf8 flag, pos() etc; string
  *            itself is accessed via the pointers above */
-/* data:      May be used for some additional optimizations.
-              Currently unused. */
+/* data:      Under REXEC_SET, the SV in which the members of a set of
+              patterns which match are noted (see S_regset_note()).
+              Otherwise unused. */
 /* flags:     For optimizations. See REXEC_* in regexp.h */
 
+{
+    reg_stats * const stats = RXi_GET(ReANY(rx))->stats;
+    reg_stats_attempt attempt;
+    I32 oldsave;
+
+    PERL_ARGS_ASSERT_REGEXEC_FLAGS;
+
+    if (LIKELY(!stats))
+        return S_regexec(aTHX_ rx, stringarg, strend, strbeg, minend, sv,
+                         data, flags);
+
+    /* under "use re 'stats'", count the attempt and time it; intuit
+     * rejections and regmatch() steps are counted as they happen */
+    stats->attempts++;
+    attempt.stats = stats;
+    attempt.start = S_reg_stats_usecs(aTHX);
+    attempt.matched = 0;
+    oldsave = PL_savestack_ix;
+    SAVEDESTRUCTOR_X(S_reg_stats_attempt_done, &attempt);
+    attempt.matched = S_regexec(aTHX_ rx, stringarg, strend, strbeg, minend,
+                                sv, data, flags);
+    LEAVE_SCOPE(oldsave);
+    return attempt.matched;
+}
+
+static I32
+S_regexec(pTHX_ REGEXP * const rx, char *stringarg, char *strend,
+	      char *strbeg, SSize_t minend, SV *sv, void *data, U32 flags)
 {
     struct regexp *const prog = ReANY(rx);
     char *s;
@@ -2524,7 +4730,6 @@ Perl_regexec_flags(pTHX_ REGEXP * const rx, char *stringarg, char *strend,
     I32 oldsave;
     GET_RE_DEBUG_FLAGS_DECL;
 
-    PERL_ARGS_ASSERT_REGEXEC_FLAGS;
     PERL_UNUSED_ARG(data);
 
     /* Be paranoid... */
@@ -2665,6 +4870,16 @@ Perl_regexec_flags(pTHX_ REGEXP * const rx, char *stringarg, char *strend,
     reginfo->is_utf8_target = cBOOL(utf8_target);
     reginfo->is_utf8_pat = cBOOL(RX_UTF8(rx));
     reginfo->warned = FALSE;
+    reginfo->set = (flags & REXEC_SET) ? MUTABLE_SV(data) : NULL;
+    reginfo->steps_left = progi->maxsteps;
+    if (UNLIKELY(progi->stats)) {
+        /* count the steps even if there is no limit on them, and even if
+         * matching croaks */
+        if (!reginfo->steps_left)
+            reginfo->steps_left = UV_MAX;
+        reginfo->steps_from = reginfo->steps_left;
+        SAVEDESTRUCTOR_X(S_reg_stats_steps_done, reginfo);
+    }
     reginfo->strbeg  = strbeg;
     reginfo->sv = sv;
     reginfo->poscache_maxiter = 0; /* not yet started a countdown */
@@ -2755,6 +4970,64 @@ Perl_regexec_flags(pTHX_ REGEXP * const rx, char *stringarg, char *strend,
 	));
     }
 
+    /* Once the pattern is hot, or the string long, the DFA finds where
+     * the match is, if there is one, without backtracking; see "Lazy DFA"
+     * above */
+    if ((prog->intflags & PREGf_DFA) && !utf8_target) {
+        reg_dfa *dfa = progi->dfa;
+        if (!dfa)
+            Newxz(dfa, 1, reg_dfa);
+        progi->dfa = dfa;
+        if (!dfa->built
+            && (strend - s >= REG_DFA_LONG || ++dfa->runs >= REG_DFA_HOT))
+            (void)S_dfa_compile(aTHX_ prog, reginfo);
+        if (dfa->built && !dfa->failed
+            && (!dfa->anchored || s == strbeg))
+        {
+            const U8 *end;
+            const int found
+                = S_dfa_search(aTHX_ dfa, (U8*)s, (U8*)strend, &end);
+            if (found < 0)
+                dfa->failed = TRUE;
+            else if (!found) {
+                DEBUG_EXECUTE_r(PerlIO_printf(Perl_debug_log,
+                                      "DFA found no match...\n"));
+                goto phooey;
+            }
+            else if (!reginfo->set) {
+                char *start = dfa->anchored
+                    ? s
+                    : (char *)S_dfa_rsearch(aTHX_ dfa, (U8*)s, end,
+                                            (U8*)strend);
+                if (start) {
+                    DEBUG_EXECUTE_r(PerlIO_printf(Perl_debug_log,
+                        "DFA found a match at offsets %"IVdf"..%"IVdf"\n",
+                        (IV)(start - strbeg), (IV)((char *)end - strbeg)));
+                    if ((char *)end >= reginfo->till) {
+                        prog->offs[0].start = start - strbeg;
+                        prog->offs[0].end = (char *)end - strbeg;
+                        prog->lastparen = prog->lastcloseparen = 0;
+                        goto got_it;
+                    }
+                    if (regtry(reginfo, &start))
+                        goto got_it;
+                }
+            }
+        }
+    }
+
+    /* Once a "use re 'jit'" pattern is hot, regtry() runs its compiled
+     * program instead of regmatch(); see "Compiled programs" above */
+    if ((prog->intflags & PREGf_JIT) && !utf8_target) {
+        if (!progi->jit)
+            Newxz(progi->jit, 1, reg_jit);
+        if (!progi->jit->ops && !progi->jit->failed
+            && ++progi->jit->runs >= REG_JIT_HOT)
+        {
+            S_jit_compile(aTHX_ prog, reginfo);
+        }
+    }
+
     /* Simplest case:  anchored match need be tried only once. */
     /*  [unless only anchor is MBOL - implying multiline is set] */
     if (prog->intflags & (PREGf_ANCH & ~PREGf_ANCH_GPOS)) {
@@ -2957,7 +5230,8 @@ Perl_regexec_flags(pTHX_ REGEXP * const rx, char *stringarg, char *strend,
 	dontbother = 0;
 	strend = HOPc(strend, -dontbother);
 	while ( (s <= last) &&
-		(s = fbm_instr((unsigned char*)HOP4c(s, back_min, strbeg,  strend),
+		(s = study_instr(sv,
+                                  (unsigned char*)HOP4c(s, back_min, strbeg,  strend),
 				  (unsigned char*)strend, must,
 				  multiline ? FBMrf_MULTILINE : 0)) ) {
 	    DEBUG_EXECUTE_r( did_match = 1 );
@@ -3126,6 +5400,22 @@ Perl_regexec_flags(pTHX_ REGEXP * const rx, char *stringarg, char *strend,
 	if (minlen && (dontbother < minlen))
 	    dontbother = minlen - 1;
 	strend -= dontbother; 		   /* this one's always in bytes! */
+
+	/* If every match starts with one of a few literals, only try
+	 * where they do; see "Literal prefilter" above */
+	if (progi->prefilter
+	    ? !progi->prefilter->failed
+	    : S_prefilter_build(aTHX_ prog, reginfo))
+	{
+	    const reg_prefilter * const pf = progi->prefilter;
+	    while ((s = S_prefilter_next(pf, s, strend, reginfo->strend))) {
+		if (regtry(reginfo, &s))
+		    goto got_it;
+		s++;
+	    }
+	    goto phooey;
+	}
+
 	/* We don't know much -- general case. */
 	if (utf8_target) {
 	    for (;;) {
@@ -3222,6 +5512,67 @@ Perl_regexec_flags(pTHX_ REGEXP * const rx, char *stringarg, char *strend,
     }
 
 
+/* Under REXEC_SET, the index of the member of the set of patterns (see
+ * re::regset()) named by mark, or -1 if it isn't one of ours */
+
+STATIC SSize_t
+S_regset_index(const SV *mark)
+{
+    const char *s, *e;
+    STRLEN n = 0;
+
+    if (!mark || !SvPOK(mark) || !SvCUR(mark))
+        return -1;
+    s = SvPVX_const(mark);
+    e = s + SvCUR(mark);
+    for (; s < e; s++) {
+        if (!isDIGIT(*s) || n >= (STRLEN)U32_MAX / 10)
+            return -1;
+        n = n * 10 + (*s - '0');
+    }
+    return (SSize_t)n;
+}
+
+/* Under REXEC_SET, note in seen that the member of the set of patterns
+ * whose (*MARK:n) was passed last has matched.  seen has a byte for each
+ * member, and grows to hold the highest seen so far */
+
+STATIC void
+S_regset_note(pTHX_ SV *seen, const SV *mark)
+{
+    const SSize_t n = S_regset_index(mark);
+
+    if (n < 0)
+        return;
+    if ((STRLEN)n >= SvCUR(seen)) {
+        const STRLEN old = SvCUR(seen);
+        SvGROW(seen, (STRLEN)n + 2);
+        Zero(SvPVX(seen) + old, n + 1 - old, char);
+        SvCUR_set(seen, n + 1);
+    }
+    SvPVX(seen)[n] = 1;
+}
+
+/* Under REXEC_SET, whether the member of the set that scan is part of has
+ * already matched, so that there is no need to try it again.  Following
+ * the next pointers from any node of a member (other than those in a
+ * loop or lookaround) leads to the (*MARK:n) after it */
+
+STATIC bool
+S_regset_seen(pTHX_ const SV *seen, const regexp_internal *rexi,
+              regnode *scan)
+{
+    for (; scan && OP(scan) != END; scan = regnext(scan)) {
+        if (OP(scan) == MARKPOINT) {
+            const SSize_t n =
+                S_regset_index(MUTABLE_SV(rexi->data->data[ARG(scan)]));
+            if (n >= 0)
+                return (STRLEN)n < SvCUR(seen) && SvPVX_const(seen)[n];
+        }
+    }
+    return FALSE;
+}
+
 /*
  - regtry - try match at specific point
  */
@@ -3268,7 +5619,19 @@ S_regtry(pTHX_ regmatch_info *reginfo, char **startposp)
     }
 #endif
     REGCP_SET(lastcp);
-    result = regmatch(reginfo, *startposp, progi->program + 1);
+    if (progi->jit && progi->jit->ops && !reginfo->is_utf8_target
+        && !reginfo->set)
+    {
+        DEBUG_EXECUTE_r(PerlIO_printf(Perl_debug_log,
+            "  running compiled program at offset %"IVdf"\n",
+            (IV)(*startposp - reginfo->strbeg)));
+        result = S_jit_match(aTHX_ reginfo, progi->jit, *startposp);
+    }
+    else if (reginfo->set
+             && S_regset_seen(aTHX_ reginfo->set, progi, progi->program + 1))
+        result = -1;    /* a set of one pattern, which has matched */
+    else
+        result = regmatch(reginfo, *startposp, progi->program + 1);
     if (result != -1) {
 	prog->offs[0].end = result;
 	return 1;
@@ -4048,6 +6411,7 @@ S_regmatch(pTHX_ regmatch_info *reginfo, char *startpos, regnode *prog)
 
       reenter_switch:
         to_complement = 0;
+        REG_STEP(reginfo);
 
         SET_nextchr;
         assert(nextchr < 256 && (nextchr >= 0 || nextchr == NEXTCHR_EOS));
@@ -4891,19 +7255,10 @@ S_regmatch(pTHX_ regmatch_info *reginfo, char *startpos, regnode *prog)
                 classnum = (_char_class_number) FLAGS(scan);
                 if (classnum < _FIRST_NON_SWASH_CC) {
 
-                    /* Here, uses a swash to find such code points.  Load if if
-                     * not done already */
-                    if (! PL_utf8_swash_ptrs[classnum]) {
-                        U8 flags = _CORE_SWASH_INIT_ACCEPT_INVLIST;
-                        PL_utf8_swash_ptrs[classnum]
-                                = _core_swash_init("utf8",
-                                        "",
-                                        &PL_sv_undef, 1, 0,
-                                        PL_XPosix_ptrs[classnum], &flags);
-                    }
+                    /* Here, uses the class's inversion list to find such code
+                     * points */
                     if (! (to_complement
-                           ^ cBOOL(swash_fetch(PL_utf8_swash_ptrs[classnum],
-                                               (U8 *) locinput, TRUE))))
+                           ^ cBOOL(isFOO_utf8_invlist(classnum, locinput))))
                     {
                         sayNO;
                     }
@@ -6155,6 +8510,16 @@ NULL
 
 	case BRANCH:	    /*  /(...|A|...)/ */
 	    scan = NEXTOPER(scan); /* scan now points to inner node */
+	    if (reginfo->set && !cur_eval
+		&& S_regset_seen(aTHX_ reginfo->set, rexi, scan))
+	    {
+		/* this is a member of a set of patterns which has already
+		 * matched somewhere: skip it */
+		scan = next;
+		if (!scan || (OP(scan) != BRANCH && OP(scan) != BRANCHJ))
+		    sayNO;
+		continue;
+	    }
 	    ST.lastparen = rex->lastparen;
 	    ST.lastcloseparen = rex->lastcloseparen;
 	    ST.next_branch = next;
@@ -6776,6 +9141,17 @@ NULL
                				      
 		sayNO_SILENT;		/* Cannot match: too short. */
 	    }
+	    if (reginfo->set) {
+		/* a member of a set of patterns has matched: note which,
+		 * and backtrack to find the others */
+		S_regset_note(aTHX_ reginfo->set, sv_yes_mark);
+		DEBUG_EXECUTE_r(PerlIO_printf(Perl_debug_log,
+		    "%*s  %sset member %s matched%s\n",
+		    REPORT_CODE_OFF+depth*2, "", PL_colors[4],
+		    sv_yes_mark ? SvPV_nolen_const(sv_yes_mark) : "(none)",
+		    PL_colors[5]));
+		sayNO;
+	    }
 	    sayYES;			/* Success! */
 
 	case SUCCEED: /* successful SUSPEND/UNLESSM/IFMATCH/CURLYM */
@@ -6885,6 +9261,9 @@ NULL
 
 #define ST st->u.mark
         case MARKPOINT: /*  (*MARK:foo)  */
+            if (reginfo->set && !cur_eval
+                && S_regset_seen(aTHX_ reginfo->set, rexi, scan))
+                sayNO;  /* the end of a member of a set already matched */
             ST.prev_mark = mark_state;
             ST.mark_name = sv_commit = sv_yes_mark 
                 = MUTABLE_SV(rexi->data->data[ ARG( scan ) ]);
@@ -7638,23 +10017,11 @@ S_regrepeat(pTHX_ regexp *prog, char **startposp, const regnode *p,
 
       found_above_latin1:   /* Continuation of POSIXU and NPOSIXU */
 
-        /* Load the swash if not already present */
-        if (! PL_utf8_swash_ptrs[classnum]) {
-            U8 flags = _CORE_SWASH_INIT_ACCEPT_INVLIST;
-            PL_utf8_swash_ptrs[classnum] = _core_swash_init(
-                                        "utf8",
-                                        "",
-                                        &PL_sv_undef, 1, 0,
-                                        PL_XPosix_ptrs[classnum], &flags);
-        }
-
         while (hardcount < max && scan < loceol
                && to_complement ^ cBOOL(_generic_utf8(
                                        classnum,
                                        scan,
-                                       swash_fetch(PL_utf8_swash_ptrs[classnum],
-                                                   (U8 *) scan,
-                                                   TRUE))))
+                                       isFOO_utf8_invlist(classnum, scan))))
         {
             scan += UTF8SKIP(scan);
             hardcount++;
@@ -7876,18 +10243,27 @@ S_reginclass(pTHX_ regexp * const prog, const regnode * const n, const U8* const
 	    SV * const sw = _get_regclass_nonbitmap_data(prog, n, TRUE, 0,
                                                        &only_utf8_locale, NULL);
 	    if (sw) {
-                U8 utf8_buffer[2];
-		U8 * utf8_p;
-		if (utf8_target) {
-		    utf8_p = (U8 *) p;
-		} else { /* Convert to utf8 */
-		    utf8_p = utf8_buffer;
-                    append_utf8_from_native_byte(*p, &utf8_p);
-		    utf8_p = utf8_buffer;
-		}
+                SV * const invlist = _get_swash_invlist(sw);
+
+                /* A binary swash always has an inversion list, and it is
+                 * quicker to search that for 'c' than to fetch a swatch */
+                if (invlist) {
+                    match = _invlist_contains_cp(invlist, c);
+                }
+                else {
+                    U8 utf8_buffer[2];
+                    U8 * utf8_p;
+                    if (utf8_target) {
+                        utf8_p = (U8 *) p;
+                    } else { /* Convert to utf8 */
+                        utf8_p = utf8_buffer;
+                        append_utf8_from_native_byte(*p, &utf8_p);
+                        utf8_p = utf8_buffer;
+                    }
 
-		if (swash_fetch(sw, utf8_p, TRUE)) {
-		    match = TRUE;
+                    if (swash_fetch(sw, utf8_p, TRUE)) {
+                        match = TRUE;
+                    }
                 }
 	    }
             if (! match && only_utf8_locale && IN_UTF8_CTYPE_LOCALE) {
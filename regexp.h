@@ -560,6 +560,9 @@ and check for NULL.
 #define REXEC_FAIL_ON_UNDERFLOW 0x80 /* fail the match if $& would start before
                                         the start pos (so s/.\G// would fail
                                         on second iteration */
+#define REXEC_SET       0x100   /* note each (*MARK:n) reaching the end of the
+                                   pattern in the SV passed as data, and
+                                   carry on looking; see re::regset() */
 
 #if defined(__GNUC__) && !defined(PERL_GCC_BRACE_GROUPS_FORBIDDEN)
 #  define ReREFCNT_inc(re)						\
@@ -651,6 +654,11 @@ typedef struct {
     bool is_utf8_pat;    /* regex is utf8 */
     bool is_utf8_target; /* string being matched is utf8 */
     bool warned; /* we have issued a recursion warning; no need for more */
+    SV *set;        /* under REXEC_SET, a byte for each member of the set,
+                       true once that member has matched */
+    UV steps_left;  /* steps regmatch() may take before croaking, if the
+                       pattern has a limit; else 0 */
+    UV steps_from;  /* under "use re 'stats'", steps_left at the start */
 } regmatch_info;
  
 
@@ -845,6 +853,42 @@ typedef struct regmatch_slab {
     struct regmatch_slab *prev, *next;
 } regmatch_slab;
 
+/* The patterns most recently compiled at run time, so that one which is
+ * interpolated again after some others doesn't have to be recompiled.
+ * See "Compiled pattern cache" in regcomp.c */
+
+#define PERL_REG_CACHE_SIZE 64	/* the default number of entries */
+
+typedef struct reg_cache_entry {
+    SV     *key;		/* the pattern and what it was compiled with */
+    U32     hash;		/* of key */
+    U32     used;		/* the cache's tick when it was last used */
+    REGEXP *rx;
+} reg_cache_entry;
+
+typedef struct reg_cache {
+    reg_cache_entry *entries;
+    U32     count;
+    U32     size;		/* the most entries it can have */
+    U32     tick;
+    UV      hits;
+    UV      misses;
+} reg_cache;
+
+/* What matching a pattern compiled under "use re 'stats'" has cost so
+ * far.  Each is in PL_reg_stats until its program is freed */
+
+typedef struct reg_stats {
+    struct reg_stats *prev;
+    struct reg_stats *next;
+    REGEXP *rx;			/* whose program it is */
+    UV      attempts;		/* calls of the engine */
+    UV      matches;		/* of which succeeded */
+    UV      rejected;		/* times intuit ruled the string out */
+    UV      steps;		/* taken by regmatch(), as for REG_STEP() */
+    UV      usecs;		/* spent in the engine */
+} reg_stats;
+
 
 
 /*
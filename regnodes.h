@@ -701,11 +701,13 @@ EXTCONST char * const PL_reg_intflags_name[] = {
 	"ANCH_MBOL",                  /* 0x00000400 - PREGf_ANCH_MBOL */
 	"ANCH_SBOL",                  /* 0x00000800 - PREGf_ANCH_SBOL */
 	"ANCH_GPOS",                  /* 0x00001000 - PREGf_ANCH_GPOS */
+	"DFA",                        /* 0x00002000 - PREGf_DFA -  try a DFA before backtracking  */
+	"JIT",                        /* 0x00004000 - PREGf_JIT -  compiled with "use re 'jit'"  */
 };
 #endif /* DOINIT */
 
 #ifdef DEBUGGING
-#  define REG_INTFLAGS_NAME_SIZE 13
+#  define REG_INTFLAGS_NAME_SIZE 15
 #endif
 
 /* The following have no fixed length. U8 so we can do strchr() on it. */
@@ -3345,6 +3345,298 @@ S_infnan_2pv(NV nv, char* buffer, size_t maxlen, char format, char plus, char al
     }
 }
 
+/* The most significant digits %g needs to give back any NV exactly */
+#ifdef NV_MANT_DIG
+#  define NV_ROUNDTRIP_DIG ((int) (NV_MANT_DIG * 0.30102999566398120) + 2)
+#else
+#  define NV_ROUNDTRIP_DIG (NV_DIG + 3)
+#endif
+
+#if defined(HAS_QUAD) && NVSIZE == 8 && NV_MANT_DIG == 53 && NV_DIG == 15
+
+#  define NV_2PV_FIXED(nv, buffer, roundtrip) \
+        S_nv_2pv_fixed(nv, buffer, roundtrip)
+
+/* Helper for sv_2pv_flags.  Writes 'nv' to the buffer, including a zero byte,
+ * exactly as sprintf("%.15g") would in the C locale, and returns the length
+ * excluding the zero byte; or if 'roundtrip' is true, as "%.16g" or "%.17g"
+ * would when that many digits are needed to read back as the same NV.  This
+ * is only done for 1e-10 <= abs(nv) < 1e15, and when the result can be found
+ * cheaply and exactly.  For anything else, returns zero, and the caller
+ * should use the C library.  The buffer must have room for at least 26 bytes.
+ *
+ * A positive NV is m * 2**e for a 53-bit integer m, and in this range
+ * -87 <= e <= -3.  If there is a 0 <= s <= 27 for which nv * 10**s has prec
+ * digits before the point, these are the significant digits to print.
+ * nv * 10**s is m * 5**s * 2**(e + s), and m * 5**s takes at most 116 bits,
+ * so is calculated exactly in two 64-bit halves, and then shifted right by
+ * -(e + s), with the bits shifted out used to round to nearest.  When they
+ * are exactly half, the C library is left to break the tie as it sees fit.
+ *
+ * The bits shifted out also give how far the rounded digits are from nv.  A
+ * number reads back as nv if it is closer than half the gap to the next NV,
+ * which in the units of m * 5**s is 5**s / 2; the gap to the NV below is half
+ * as big when m is a power of two.  5**s is odd, so the digits are never
+ * exactly halfway between two NVs, and the way a reader breaks ties doesn't
+ * matter. */
+
+STATIC size_t
+S_nv_2pv_fixed(NV nv, char * const buffer, const bool roundtrip)
+{
+    static const U64 pow10[] = {
+        U64_CONST(1),
+        U64_CONST(10),
+        U64_CONST(100),
+        U64_CONST(1000),
+        U64_CONST(10000),
+        U64_CONST(100000),
+        U64_CONST(1000000),
+        U64_CONST(10000000),
+        U64_CONST(100000000),
+        U64_CONST(1000000000),
+        U64_CONST(10000000000),
+        U64_CONST(100000000000),
+        U64_CONST(1000000000000),
+        U64_CONST(10000000000000),
+        U64_CONST(100000000000000),
+        U64_CONST(1000000000000000),
+        U64_CONST(10000000000000000),
+        U64_CONST(100000000000000000)
+    };
+    static const U64 pow5[] = {
+        U64_CONST(1),
+        U64_CONST(5),
+        U64_CONST(25),
+        U64_CONST(125),
+        U64_CONST(625),
+        U64_CONST(3125),
+        U64_CONST(15625),
+        U64_CONST(78125),
+        U64_CONST(390625),
+        U64_CONST(1953125),
+        U64_CONST(9765625),
+        U64_CONST(48828125),
+        U64_CONST(244140625),
+        U64_CONST(1220703125),
+        U64_CONST(6103515625),
+        U64_CONST(30517578125),
+        U64_CONST(152587890625),
+        U64_CONST(762939453125),
+        U64_CONST(3814697265625),
+        U64_CONST(19073486328125),
+        U64_CONST(95367431640625),
+        U64_CONST(476837158203125),
+        U64_CONST(2384185791015625),
+        U64_CONST(11920928955078125),
+        U64_CONST(59604644775390625),
+        U64_CONST(298023223876953125),
+        U64_CONST(1490116119384765625),
+        U64_CONST(7450580596923828125)
+    };
+    const U64 low32 = U64_CONST(0xFFFFFFFF);
+    char digits[NV_ROUNDTRIP_DIG];
+    char *s = buffer;
+    U64 m, n = 0;
+    int binexp, scale = 0, x, ndigits, i;
+    int prec = NV_DIG;
+
+    if (nv < 0) {
+        *s++ = '-';
+        nv = -nv;
+    }
+    if (! (nv >= 1e-10 && nv < 1e15)) {  /* Also rejects NaN */
+        return 0;
+    }
+
+    m = (U64) (Perl_frexp(nv, &binexp) * 9007199254740992.0);    /* 2**53 */
+
+    for (;;) {
+        U64 p = 0, dist_hi = 0, dist_lo = 0;
+        bool rounded = FALSE, below = FALSE;
+
+        /* A first guess at the power of ten; it is corrected below */
+        scale = prec - 1 - (int) Perl_floor((binexp - 1) * 0.30102999566398120);
+
+        for (i = 0; i < 3; i++) {
+            U64 ll, lh, hl, mid, lo, hi, rem_hi, rem_lo, half_hi, half_lo;
+            const int shift = 53 - binexp - scale;
+
+            if (scale < 0 || scale > 27 || shift < 1) {
+                return 0;
+            }
+            p = pow5[scale];
+
+            /* hi:lo = m * p, from 32-bit halves */
+            ll  = (m & low32) * (p & low32);
+            lh  = (m & low32) * (p >> 32);
+            hl  = (m >> 32)   * (p & low32);
+            mid = (ll >> 32) + (lh & low32) + (hl & low32);
+            lo  = (mid << 32) | (ll & low32);
+            hi  = (m >> 32) * (p >> 32) + (lh >> 32) + (hl >> 32) + (mid >> 32);
+
+            /* n = hi:lo >> shift, with the remainder and half of 1 << shift */
+            if (shift < 64) {
+                if (hi >> shift) {
+                    return 0;
+                }
+                n = (hi << (64 - shift)) | (lo >> shift);
+                rem_hi = 0;
+                rem_lo = lo & ((U64_CONST(1) << shift) - 1);
+                half_hi = 0;
+                half_lo = U64_CONST(1) << (shift - 1);
+            }
+            else {
+                n = hi >> (shift - 64);
+                rem_hi = hi & ((U64_CONST(1) << (shift - 64)) - 1);
+                rem_lo = lo;
+                half_hi = (shift == 64) ? 0 : U64_CONST(1) << (shift - 65);
+                half_lo = (shift == 64) ? U64_CONST(1) << 63 : 0;
+            }
+
+            if (n < pow10[prec - 1]) {
+                scale++;
+                continue;
+            }
+            if (n >= pow10[prec]) {
+                scale--;
+                continue;
+            }
+
+            if (rem_hi == half_hi && rem_lo == half_lo) {
+                return 0;
+            }
+            if (rem_hi > half_hi || (rem_hi == half_hi && rem_lo > half_lo)) {
+                /* The distance is then (1 << shift) less the remainder */
+                n++;
+                dist_hi = (half_hi << 1) | (half_lo >> 63);
+                dist_lo = half_lo << 1;
+                dist_hi -= rem_hi + (dist_lo < rem_lo);
+                dist_lo -= rem_lo;
+            }
+            else {
+                below = TRUE;
+                dist_hi = rem_hi;
+                dist_lo = rem_lo;
+            }
+            rounded = TRUE;
+            break;
+        }
+        if (! rounded) {
+            return 0;
+        }
+
+        if (! roundtrip || prec == NV_ROUNDTRIP_DIG) {
+            break;
+        }
+
+        /* Check that the distance is less than p / 2, or p / 4 */
+        if (dist_hi == 0) {
+            const int bits = (below && m == U64_CONST(1) << 52) ? 2 : 1;
+            if ((dist_lo >> (64 - bits)) == 0 && (dist_lo << bits) < p) {
+                break;
+            }
+        }
+        prec++;
+    }
+
+    /* Rounding up may have carried into an extra digit */
+    if (n == pow10[prec]) {
+        n = pow10[prec - 1];
+        scale--;
+    }
+
+    /* The decimal exponent %g would use */
+    x = prec - 1 - scale;
+    if (x < -10 || x >= prec) {
+        return 0;
+    }
+
+    for (i = prec - 1; i >= 0; i--) {
+        digits[i] = (char) ('0' + n % 10);
+        n /= 10;
+    }
+    ndigits = prec;
+    while (digits[ndigits - 1] == '0')
+        ndigits--;
+
+    if (x < -4) {
+        *s++ = digits[0];
+        if (ndigits > 1) {
+            *s++ = '.';
+            for (i = 1; i < ndigits; i++) {
+                *s++ = digits[i];
+            }
+        }
+        *s++ = 'e';
+        *s++ = '-';
+        *s++ = (char) ('0' - x / 10);
+        *s++ = (char) ('0' - x % 10);
+    }
+    else if (x >= 0) {
+        for (i = 0; i <= x; i++) {
+            *s++ = (i < ndigits) ? digits[i] : '0';
+        }
+        if (ndigits > x + 1) {
+            *s++ = '.';
+            for (; i < ndigits; i++) {
+                *s++ = digits[i];
+            }
+        }
+    }
+    else {
+        *s++ = '0';
+        *s++ = '.';
+        for (i = x + 1; i < 0; i++) {
+            *s++ = '0';
+        }
+        for (i = 0; i < ndigits; i++) {
+            *s++ = digits[i];
+        }
+    }
+    *s = '\0';
+
+    return s - buffer;
+}
+
+#else
+#  define NV_2PV_FIXED(nv, buffer, roundtrip) 0
+#endif
+
+/* Helper for sv_2pv_flags.  Writes 'nv' to the buffer of 'size' bytes as %g
+ * does, with NV_DIG significant digits, or under "use roundtrip" with the
+ * fewest from there on that read back as the same NV.  S_nv_2pv_fixed() is
+ * tried first if 'fixed' is true, which it must not be if the radix may not
+ * be a dot.  Otherwise each candidate is read back, both by perl's own
+ * my_atof2() and by the C library, which is what other programs are likely
+ * to use; where they aren't both exact, NV_ROUNDTRIP_DIG digits may be
+ * written where fewer would do. */
+
+STATIC void
+S_nv_2pv_g(pTHX_ const NV nv, char * const buffer, const STRLEN size,
+           const bool fixed, const bool roundtrip)
+{
+    int prec = NV_DIG;
+
+    if (fixed && NV_2PV_FIXED(nv, buffer, roundtrip))
+        return;
+
+    SNPRINTF_G(nv, buffer, size, prec);
+    if (roundtrip) {
+        while (prec < NV_ROUNDTRIP_DIG) {
+            NV back = 0.0;
+            my_atof2(buffer, &back);
+            if (back == nv
+#ifdef Perl_strtod
+                && Perl_strtod(buffer, NULL) == nv
+#endif
+            )
+                break;
+            prec++;
+            SNPRINTF_G(nv, buffer, size, prec);
+        }
+    }
+}
+
 /*
 =for apidoc sv_2pv_flags
 
@@ -3544,11 +3836,13 @@ Perl_sv_2pv_flags(pTHX_ SV *const sv, STRLEN *const lp, const I32 flags)
             else {
                 /* some Xenix systems wipe out errno here */
                 dSAVE_ERRNO;
+                const bool roundtrip =
+                    cBOOL(CopHINTS_get(PL_curcop) & HINT_ROUNDTRIP);
 
                 size =
                     1 + /* sign */
                     1 + /* "." */
-                    NV_DIG +
+                    NV_ROUNDTRIP_DIG +
                     1 + /* "e" */
                     1 + /* sign */
                     5 + /* exponent digits */
@@ -3557,11 +3851,19 @@ Perl_sv_2pv_flags(pTHX_ SV *const sv, STRLEN *const lp, const I32 flags)
 
                 s = SvGROW_mutable(sv, size);
 #ifndef USE_LOCALE_NUMERIC
-                SNPRINTF_G(SvNVX(sv), s, SvLEN(sv), NV_DIG);
+                S_nv_2pv_g(aTHX_ SvNVX(sv), s, SvLEN(sv), TRUE, roundtrip);
 
-                SvPOK_on(sv);
+                /* Not cached under "use roundtrip", as the string may
+                 * differ from what is wanted elsewhere */
+                if (! roundtrip)
+                    SvPOK_on(sv);
 #else
-                {
+                /* Outside of 'use locale' the radix is always a dot, so the
+                 * quicker way can be used */
+                if (! IN_LC(LC_NUMERIC)) {
+                    S_nv_2pv_g(aTHX_ SvNVX(sv), s, SvLEN(sv), TRUE, roundtrip);
+                }
+                else {
                     bool local_radix;
                     DECLARE_STORE_LC_NUMERIC_SET_TO_NEEDED();
 
@@ -3574,7 +3876,7 @@ Perl_sv_2pv_flags(pTHX_ SV *const sv, STRLEN *const lp, const I32 flags)
                         s = SvGROW_mutable(sv, size);
                     }
 
-                    SNPRINTF_G(SvNVX(sv), s, SvLEN(sv), NV_DIG);
+                    S_nv_2pv_g(aTHX_ SvNVX(sv), s, SvLEN(sv), FALSE, roundtrip);
 
                     /* If the radix character is UTF-8, and actually is in the
                      * output, turn on the UTF-8 flag for the scalar */
@@ -12825,6 +13127,317 @@ Perl_sv_vcatpvfn_flags(pTHX_ SV *const sv, const char *const pat, const STRLEN p
                                each iteration. */
 }
 
+/* A directive in a format accepted by sv_fast_format_compile(), as found
+ * by S_fast_directive() */
+
+struct fast_directive {
+    const char *end;	/* just past the directive */
+    STRLEN width;
+    char conv;		/* 's' or 'd' to format here, or 0 to hand on */
+    char fill;
+    char plus;
+    bool left;
+};
+
+/* Parse the directive that follows the '%' at p, following the grammar used
+ * by sv_vcatpvfn_flags().  Returns FALSE unless it is valid and takes its
+ * value from exactly one argument, in order; so no explicit indexes, no '*'
+ * widths or precisions, no vectors, and no size modifiers.  Plain %s, %d
+ * and %i, with only flags and a width, are marked to be done in place. */
+
+STATIC bool
+S_fast_directive(const char *p, const char * const end,
+                 struct fast_directive * const d)
+{
+    bool in_place = TRUE;
+    int ndigits = 0;
+
+    d->width = 0;
+    d->fill = ' ';
+    d->plus = 0;
+    d->left = FALSE;
+
+    if (p < end && *p >= '1' && *p <= '9') {
+        /* a width, without flags, unless it's an explicit index */
+        while (p < end && isDIGIT(*p)) {
+            d->width = d->width * 10 + (*p++ - '0');
+            ndigits++;
+        }
+        if (p < end && *p == '$')
+            return FALSE;
+    }
+    else {
+        for (; p < end; p++) {
+            if (*p == ' ' || *p == '+') {
+                if (d->plus != '+')
+                    d->plus = *p;
+            }
+            else if (*p == '-')
+                d->left = TRUE;
+            else if (*p == '0')
+                d->fill = '0';
+            else if (*p == '#')
+                in_place = FALSE;
+            else
+                break;
+        }
+        while (p < end && isDIGIT(*p)) {
+            d->width = d->width * 10 + (*p++ - '0');
+            ndigits++;
+        }
+    }
+    if (ndigits > 9)
+        return FALSE;
+
+    if (p < end && *p == '.') {
+        p++;
+        ndigits = 0;
+        while (p < end && isDIGIT(*p)) {
+            p++;
+            ndigits++;
+        }
+        if (ndigits > 9)
+            return FALSE;
+        in_place = FALSE;
+    }
+
+    if (p == end)
+        return FALSE;
+    switch (*p) {
+    case 's':
+    case 'd':
+    case 'i':
+        d->conv = in_place ? (*p == 's' ? 's' : 'd') : 0;
+        break;
+    case 'c':
+    case 'D': case 'u': case 'U': case 'o': case 'O':
+    case 'x': case 'X': case 'b': case 'B':
+    case 'e': case 'E': case 'f': case 'F': case 'g': case 'G':
+        d->conv = 0;
+        break;
+    default:
+        return FALSE;
+    }
+    d->end = p + 1;
+    return TRUE;
+}
+
+/* One step of a format compiled by sv_fast_format_compile().  The steps
+ * are kept as an array in the PV of an SV, and refer to the pattern by
+ * offset, so that they stay valid for any copy of it. */
+
+struct fast_step {
+    STRLEN start;	/* offset of the text, or of the directive's '%' */
+    STRLEN len;
+    STRLEN width;
+    char conv;		/* 0 to copy text, 's' or 'd' to format here,
+			   or '%' to hand the directive on */
+    char fill;
+    char plus;
+    bool left;
+};
+
+/*
+ * Compile the pattern pat into the steps that sv_catpvfn_fast() runs, or
+ * return NULL if it can't be done that way.  This is done at compile time
+ * for constant formats given to sprintf and printf.  The pattern must be
+ * plain ASCII: literal text and "%%" are copied, and every other directive
+ * must be one S_fast_directive() accepts.
+ */
+
+SV *
+Perl_sv_fast_format_compile(pTHX_ const char *const pat, const STRLEN patlen)
+{
+    const char *p = pat;
+    const char * const patend = pat + patlen;
+    SV *steps;
+
+    PERL_ARGS_ASSERT_SV_FAST_FORMAT_COMPILE;
+
+    /* sv_vcatpvfn_flags() has its own shortcut for a lone "%s" */
+    if (patlen == 2 && pat[0] == '%' && pat[1] == 's')
+        return NULL;
+
+    if (! is_invariant_string((const U8 *) pat, patlen))
+        return NULL;
+
+    steps = newSVpvs("");
+    while (p < patend) {
+        struct fast_step step;
+        struct fast_directive d;
+        const char *q = (const char *) memchr(p, '%', patend - p);
+
+        if (!q)
+            q = patend;
+        if (q > p) {
+            Zero(&step, 1, struct fast_step);
+            step.start = p - pat;
+            step.len = q - p;
+            sv_catpvn_nomg(steps, (const char *) &step, sizeof step);
+        }
+        if (q == patend)
+            break;
+
+        Zero(&step, 1, struct fast_step);
+        if (q + 1 < patend && q[1] == '%') {
+            step.start = q + 1 - pat;
+            step.len = 1;
+            p = q + 2;
+        }
+        else if (S_fast_directive(q + 1, patend, &d)) {
+            step.start = q - pat;
+            step.len = d.end - q;
+            step.width = d.width;
+            step.conv = d.conv ? d.conv : '%';
+            step.fill = d.fill;
+            step.plus = d.plus;
+            step.left = d.left;
+            p = d.end;
+        }
+        else {
+            SvREFCNT_dec_NN(steps);
+            return NULL;
+        }
+        sv_catpvn_nomg(steps, (const char *) &step, sizeof step);
+    }
+    return steps;
+}
+
+/* Append elen bytes at eptr to sv, preceded by the sign in esign, if
+ * any, and padded to width, laid out just as sv_vcatpvfn_flags() does */
+
+STATIC void
+S_cat_padded(pTHX_ SV *const sv, const char esign, const char *const eptr,
+             const STRLEN elen, const STRLEN width, const bool left,
+             const char fill)
+{
+    const STRLEN have = (esign ? 1 : 0) + elen;
+    const STRLEN gap = have < width ? width - have : 0;
+    char *p;
+
+    SvGROW(sv, SvCUR(sv) + have + gap + 1);
+    p = SvEND(sv);
+    if (esign && fill == '0')
+        *p++ = esign;
+    if (gap && !left) {
+        memset(p, fill, gap);
+        p += gap;
+    }
+    if (esign && fill != '0')
+        *p++ = esign;
+    Copy(eptr, p, elen, char);
+    p += elen;
+    if (gap && left) {
+        memset(p, ' ', gap);
+        p += gap;
+    }
+    *p = '\0';
+    SvCUR_set(sv, p - SvPVX_const(sv));
+}
+
+/*
+ * Append to sv the result of formatting the svmax arguments in svargs with
+ * the pattern pat, following the steps that sv_fast_format_compile() made
+ * from it.  The output is the same as from sv_vcatpvfn_flags(), which this
+ * falls back on where needed.
+ *
+ * Literal text is copied, and plain strings and integers are formatted in
+ * place for %s, %d and %i.  Other directives, and arguments which are
+ * magical, references or infinite or NaN, are passed to
+ * sv_vcatpvfn_flags() one directive at a time.  If any argument is UTF-8,
+ * or the output becomes UTF-8, or arguments run out, sv_vcatpvfn_flags()
+ * is given the rest of the pattern: its handling of those depends on what
+ * came before in ways that are not worth repeating here.
+ */
+
+void
+Perl_sv_catpvfn_fast(pTHX_ SV *const sv, const char *const pat,
+                     const STRLEN patlen, const SV *const steps,
+                     SV **const svargs, const I32 svmax)
+{
+    const struct fast_step *step = (const struct fast_step *) SvPVX_const(steps);
+    const struct fast_step * const stepend =
+                                step + SvCUR(steps) / sizeof(struct fast_step);
+    const char *p = pat;
+    I32 svix;
+
+    PERL_ARGS_ASSERT_SV_CATPVFN_FAST;
+
+    for (svix = 0; svix < svmax; svix++) {
+        if (DO_UTF8(svargs[svix])) {
+            svix = 0;
+            goto hand_over;
+        }
+    }
+
+    svix = 0;
+    for (; step < stepend; step++) {
+        const char * const q = pat + step->start;
+        SV *arg;
+
+        if (!step->conv) {
+            SvGROW(sv, SvCUR(sv) + step->len + 1);
+            Copy(q, SvEND(sv), step->len, char);
+            SvCUR_set(sv, SvCUR(sv) + step->len);
+            *SvEND(sv) = '\0';
+            continue;
+        }
+
+        if (svix >= svmax) {
+            p = q;
+            goto hand_over;
+        }
+
+        arg = svargs[svix++];
+        if (step->conv != '%' && SvTYPE(arg) <= SVt_PVMG
+            && ! SvGMAGICAL(arg) && ! SvROK(arg))
+        {
+            if (step->conv == 's' && ! SvUTF8(arg)) {
+                STRLEN elen;
+                const char * const eptr = SvPV_nomg_const(arg, elen);
+                S_cat_padded(aTHX_ sv, 0, eptr, elen, step->width,
+                             step->left, step->fill);
+                continue;
+            }
+            if (step->conv == 'd' && (SvIOK(arg) || ! isinfnansv(arg))) {
+                char ebuf[TYPE_DIGITS(UV) + 1];
+                char * const eend = ebuf + sizeof ebuf;
+                char *eptr = eend;
+                const IV iv = SvIV_nomg(arg);
+                char esign = step->plus;
+                UV uv = iv;
+
+                if (iv < 0) {
+                    uv = (iv == IV_MIN) ? (UV)iv : (UV)(-iv);
+                    esign = '-';
+                }
+                do {
+                    *--eptr = '0' + (char) (uv % 10);
+                } while (uv /= 10);
+                S_cat_padded(aTHX_ sv, esign, eptr, eend - eptr, step->width,
+                             step->left, step->fill);
+                continue;
+            }
+        }
+
+        sv_vcatpvfn_flags(sv, q, step->len, NULL, &arg, 1, NULL, 0);
+        if (SvUTF8(sv)) {
+            p = q + step->len;
+            goto hand_over;
+        }
+    }
+
+    if (svix < svmax && ckWARN(WARN_REDUNDANT))
+        Perl_warner(aTHX_ packWARN(WARN_REDUNDANT), "Redundant argument in %s",
+                    PL_op ? OP_DESC(PL_op) : "sv_vcatpvfn()");
+    SvTAINT(sv);
+    return;
+
+  hand_over:
+    sv_vcatpvfn_flags(sv, p, pat + patlen - p, NULL, svargs + svix,
+                      svmax - svix, NULL, 0);
+}
+
 /* =========================================================================
 
 =head1 Cloning an interpreter
@@ -14620,6 +15233,8 @@ perl_clone_using(PerlInterpreter *proto_perl, UV flags,
     /* RE engine related */
     PL_regmatch_slab	= NULL;
     PL_reg_curpm	= NULL;
+    PL_reg_cache	= NULL;		/* each thread has its own */
+    PL_reg_stats	= NULL;		/* added to as regexps are cloned */
 
     PL_sub_generation	= proto_perl->Isub_generation;
 
@@ -1387,6 +1387,20 @@ sv_force_normal does nothing.
 # define BmPREVIOUS(sv)	0
 #endif
 
+#ifdef PERL_CORE
+/* What study() hangs off a string as PERL_MAGIC_study: the offset of every
+ * byte of the string, grouped by byte value and ascending within each group.
+ * The offsets of byte value c are pos[first[c]] up to pos[first[c+1]-1].
+ * The buffer and length it was built for are kept so that changes which
+ * didn't go through set magic can't make it lie. */
+struct study_index {
+    const char *pv;
+    STRLEN	cur;
+    U32		first[257];
+    U32		pos[1];
+};
+#endif
+
 #define FmLINES(sv)	((XPVIV*)  SvANY(sv))->xiv_iv
 
 #define LvTYPE(sv)	((XPVLV*)  SvANY(sv))->xlv_type
@@ -641,6 +641,12 @@ lis [&mypack("H*", '5065726c')], ['Perl'], '&pack in list context';
 
 test_proto 'pipe';
 
+test_proto 'popcount';
+$tests += 3;
+is &mypopcount("\x0f\xff"), 12, '&popcount';
+lis [&mypopcount("\x0f\xff", 2)], [10], '&popcount in list context';
+is &mypopcount("\x0f\xff", 2, 4), 2, '&popcount with 3 args';
+
 test_proto 'pos';
 $tests += 4;
 $_ = "hello";
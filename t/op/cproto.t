@@ -7,7 +7,7 @@ BEGIN {
 }
 
 BEGIN { require './test.pl'; }
-plan tests => 254;
+plan tests => 255;
 
 while (<DATA>) {
     chomp;
@@ -177,6 +177,7 @@ pack ($@)
 package undef
 pipe (**)
 pop (;+)
+popcount ($;$$)
 pos (;\[$*])
 print undef
 printf undef
@@ -14,7 +14,7 @@ BEGIN {
 
 use feature qw( fc );
 
-plan tests => 134 + 4 * 256;
+plan tests => 143 + 4 * 256;
 
 is(lc(undef),	   "", "lc(undef) is ''");
 is(lcfirst(undef), "", "lcfirst(undef) is ''");
@@ -318,6 +318,32 @@ $h{k} = bless[], "\x{130}bcde"; # U+0130 grows with lc()
 like lc delete $h{k}, qr "^i\x{307}bcde=array\(.*\)",
     'lc(TEMP ref) does not produce a corrupt string';
 
+# Runs of ASCII are case-changed a word at a time.  Check long strings with
+# every character, starting at different alignments, against doing each
+# character on its own
+{
+    my $str = join "", map { ("aZ\@[`{" x $_) . chr($_) } 0 .. 255;
+    for my $func (qw(lc uc fc)) {
+        my %code = (native => eval "sub { $func \$_[0] }");
+        {
+            use feature 'unicode_strings';
+            $code{unicode_strings} = eval "sub { $func \$_[0] }";
+        }
+        $code{utf8} = $code{native};
+
+        for my $mode (qw(native unicode_strings utf8)) {
+            my $code = $code{$mode};
+            my $ok = 1;
+            for my $start (0 .. 9) {
+                my $s = substr $str, $start;
+                utf8::upgrade($s) if $mode eq 'utf8';
+                my $expect = join "", map { $code->($_) } split //, $s;
+                $ok = 0 unless $code->($s) eq $expect;
+            }
+            ok($ok, "$func of long mixed strings ($mode)");
+        }
+    }
+}
 
 my $utf8_locale = find_utf8_ctype_locale();
 
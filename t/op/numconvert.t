@@ -251,7 +251,7 @@ for my $num_chain (1..$max_chain) {
 }
 
 # Tests that use test.pl start here.
-BEGIN { $::additional_tests = 4 }
+BEGIN { $::additional_tests = 10 }
 
 ok(-0.0 eq "0", 'negative zero stringifies as 0');
 ok(!-0.0, "neg zero is boolean false");
@@ -261,3 +261,84 @@ ok(!$nz, 'previously stringified -0.0 is boolean false');
 $nz = -0.0;
 is sprintf("%+.f", - -$nz), sprintf("%+.f", - -$nz),
   "negation does not coerce negative zeroes";
+
+# Many non-integers are stringified without calling the C library; the
+# result must be just what "%.15g" gives
+{
+    my @nv = (0.1, 0.2, 0.3, 1/3, 2/3, 0.5, 1.5, 2.5, 12.5, 0.125, 1e-4,
+              1e-5, 9.999999999999999e-5, 0.000123456789012345678,
+              0.9999999999999999, 0.99999999999999999, 1.0000000000000002,
+              0.30000000000000004, 99999999999999.99, 123456789012345.6,
+              999999999999999.4, 2**-13, 2**-14, 2**-15, 2**49 + 0.5);
+    srand(1);
+    push @nv, map { rand() * 10 ** (int(rand(22)) - 6) } 1 .. 2000;
+    push @nv, map { int(rand(1e6)) / 10 ** (1 + int(rand(7))) } 1 .. 2000;
+
+    my @bad = grep { $_ != int $_ && "$_" ne sprintf "%.15g", $_ }
+                   map { ($_, -$_) } @nv;
+    is("@bad", "", 'stringified fractional NVs are the same as %.15g');
+
+    my $x = 0.1 + 0.2;
+    is("$x", "0.3", '0.1 + 0.2 stringifies as 0.3');
+}
+
+# Decimal strings are converted to the nearest double, however many digits
+# and whatever the exponent
+SKIP: {
+    require Config;
+    skip 'needs IEEE doubles as NVs', 4
+        unless $Config::Config{nvsize} == 8 && $Config::Config{d_quad}
+               && $Config::Config{doublekind} =~ /^[3478]\z/
+               && !$Config::Config{usequadmath};
+
+    # Strings with the mantissa and binary exponent of the nearest double
+    my @exact = (
+        [ '0.1',                     7205759403792794, -56  ],
+        [ '62142.1e-33',             5543260552806439, -146 ],
+        [ '9.5525903181943003e-23',  8126445109252993, -126 ],
+        [ '2.8740212750030225e-24',  7823830096313295, -131 ],
+        [ '1140223232262546.73e-20', 6730689968782427, -69  ],
+        [ '0.1223014150e-24',        5326977916669436, -135 ],
+        [ '4.995039865447815e-10',   4830906130675397, -83  ],
+        [ '1.847451958579473e-07',   6979476166326067, -75  ],
+        [ '1.06064505689056e-25',    4619760773397929, -135 ],
+        [ '1.0628854162999619e-23',  7233623304485961, -129 ],
+    );
+    my @bad = map { $_->[0] }
+              grep { $_->[0] + 0 != $_->[1] * 2 ** $_->[2] } @exact;
+    is("@bad", "", 'decimal strings convert to the nearest double');
+
+    # Halfway between two doubles, which rounds to the even one, and
+    # numbers at the ends of the range
+    @exact = (
+        [ '878312370864974650e-2',   8783123708649746,  0    ],
+        [ '49573703359453245e-1',    4957370335945324,  0    ],
+        [ '90071992547409930e-1',    4503599627370496,  1    ],
+        [ '1.00000000000000011102230246251565404236316680908203125',
+                                     4503599627370496,  -52  ],
+        [ '1.00000000000000011102230246251565404236316680908203126',
+                                     4503599627370497,  -52  ],
+        [ '7.581454333883296e-148',  5457329517665098,  -541 ],
+        [ '8.98846567431158e307',    4503599627370496,  971  ],
+        [ '1.7976931348623157e308',  9007199254740991,  971  ],
+        [ '1.7976931348623158e308',  9007199254740991,  971  ],
+        [ '2.2250738585072011e-308', 4503599627370495,  -1074 ],
+        [ '1e-320',                  2024,              -1074 ],
+        [ '4.9406564584124654e-324', 1,                 -1074 ],
+        [ '2.4703282292062328e-324', 1,                 -1074 ],
+        [ '2.4703282292062327e-324', 0,                 0    ],
+        [ '1.7976931348623159e308',  9**9**9,           0    ],
+    );
+    @bad = map { $_->[0] }
+           grep { $_->[0] + 0 != $_->[1] * 2 ** $_->[2] } @exact;
+    is("@bad", "", 'ties and extreme exponents convert to the nearest double');
+
+    # A 1 far beyond the digits that could matter still breaks a tie
+    is('1.00000000000000011102230246251565404236316680908203125'
+       . '0' x 800 . '1' + 0, 1 + 2 ** -52, 'a tie with a long tail');
+
+    srand(2);
+    @bad = grep { sprintf("%.17g", $_) + 0 != $_ }
+           map { (rand() + 0.5) * 10 ** (int(rand(50)) - 25) } 1 .. 5000;
+    is("@bad", "", '%.17g output converts back to the same double');
+}
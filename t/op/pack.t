@@ -12,7 +12,7 @@ my $no_endianness = $] > 5.009 ? '' :
 my $no_signedness = $] > 5.009 ? '' :
   "Signed/unsigned pack modifiers not available on this perl";
 
-plan tests => 14707;
+plan tests => 14708;
 
 use strict;
 use warnings qw(FATAL all);
@@ -136,6 +136,19 @@ sub list_eq ($$) {
     $sum = unpack("%32b*", $foo);
     my $longway = unpack("b*", $foo);
     is( $sum, $longway =~ tr/1/1/ );
+
+    # Whole bytes are counted a word at a time; try unaligned starts and
+    # lengths that leave odd bytes and bits over
+    my $ok = 1;
+    for my $start (1 .. 9) {
+        my $part = substr $foo, $start, 1000 + $start;
+        my $bits = 8 * length($part) - $start;
+        $longway = unpack("b$bits", $part);
+        $ok = 0 unless unpack("%32b$bits", $part) == ($longway =~ tr/1/1/);
+        $longway = unpack("B$bits", $part);
+        $ok = 0 unless unpack("%32B$bits", $part) == ($longway =~ tr/1/1/);
+    }
+    ok( $ok, 'bit counting checksums of unaligned strings' );
 }
 
 {
@@ -0,0 +1,78 @@
+#!./perl
+
+BEGIN {
+    chdir 't' if -d 't';
+    require './test.pl';
+    set_up_inc('../lib');
+}
+
+use feature 'popcount';
+
+plan( tests => 31 );
+
+is(popcount(""), 0, "empty string");
+is(popcount("\0" x 100), 0, "all clear");
+is(popcount("\xff" x 100), 800, "all set");
+is(popcount("\x01\x80\x55"), 6, "some set");
+is(popcount(undef), 0, "undef") ;
+
+# against unpack for lengths either side of whole words, at all alignments
+{
+    my $bits = join "", map { chr((($_ * 37) ^ ($_ >> 2)) & 0xFF) } 1 .. 200;
+    my $bad = 0;
+    for my $start (0 .. 9) {
+        for my $len (0 .. 70, 127, 128, 129, 190) {
+            my $str = substr($bits, $start, $len);
+            $bad++ unless popcount($str) == unpack("%32b*", $str);
+        }
+    }
+    is($bad, 0, "agrees with unpack");
+}
+
+# ranges are numbered as vec($s, $n, 1) numbers bits
+{
+    my $s = "\xff\x0f\x01";
+    is(popcount($s, 0), 13, "offset 0");
+    is(popcount($s, 4), 9, "offset within the first byte");
+    is(popcount($s, 8), 5, "offset at a byte boundary");
+    is(popcount($s, 4, 8), 8, "range across bytes");
+    is(popcount($s, 8, 4), 4, "range within a byte");
+    is(popcount($s, 9, 2), 2, "range inside a byte");
+    is(popcount($s, 12, 4), 0, "clear range");
+    is(popcount($s, 16, 1), 1, "single bit set");
+    is(popcount($s, 17, 1), 0, "single bit clear");
+    is(popcount($s, 3, 0), 0, "zero length");
+    is(popcount($s, 20, 100), 0, "range past the end");
+    is(popcount($s, 100), 0, "offset past the end");
+    is(popcount($s, 0, 1e9), 13, "length past the end");
+
+    my $set = "";
+    vec($set, $_, 1) = 1 for 3, 64, 65, 200, 1001;
+    is(popcount($set, 0, 65), 2, "counts members of a vec() set below 65");
+    is(popcount($set, 64, 937), 3, "... and between 64 and 1000");
+    my ($n, $bad) = (0, 0);
+    for my $i (0 .. 1010) {
+        $n += vec($set, $i, 1);
+        $bad++ unless popcount($set, 0, $i + 1) == $n;
+    }
+    is($bad, 0, "agrees with vec() at every bit");
+}
+
+{
+    my $x = "\xfe" x 1000;
+    my $y = "\x7f" x 1000;
+    is(popcount($x & $y), 6000, "count of an intersection");
+    is(popcount(substr($x, 1) | substr($y, 3)), 7990, "... of a union");
+}
+
+{
+    my $s = "\xe9\xff";
+    utf8::upgrade($s);
+    is(popcount($s), 13, "upgraded string counts its bytes");
+    ok(!eval { popcount("\x{100}") }, "wide characters are fatal");
+    like($@, qr/^Use of strings with code points over 0xFF as arguments to popcount is not allowed/, "... with a message");
+    ok(!eval { popcount("a", -1) }, "negative offset");
+    like($@, qr/^Negative offset to popcount/, "... with a message");
+    ok(!eval { popcount("a", 0, -1) }, "negative length");
+    like($@, qr/^Negative length to popcount/, "... with a message");
+}
@@ -6,7 +6,7 @@ BEGIN {
     set_up_inc('../lib');
 }
 use warnings;
-plan( tests => 183 );
+plan( tests => 217 );
 
 # these shouldn't hang
 {
@@ -1018,3 +1018,162 @@ package deletions {
     @_=sort { delete $deletions::{a}; delete $deletions::{b}; 3 } 1..3;
 }
 pass "no crash when sort block deletes *a and *b";
+
+# Large sorts with the builtin comparisons may be done on several threads;
+# they must give the same stable result as ever.
+{
+    my @n = map { (1, "1.0", "01", 2, "2.0", 0, "-0.0", -3)[$_ % 8] }
+		map { $_ * 7919 % 120011 } 0 .. 120010;
+    my @ix = 0 .. $#n;
+    my @s = map { "k" . ($_ % 1000) } @ix;
+    is "@{[sort { $a <=> $b } @n]}",
+       "@{[map $n[$_], sort { $n[$a] <=> $n[$b] or $a <=> $b } @ix]}",
+       'large numeric sort is stable';
+    is "@{[sort { $b <=> $a } @n]}",
+       "@{[map $n[$_], sort { $n[$b] <=> $n[$a] or $a <=> $b } @ix]}",
+       'large descending numeric sort is stable';
+    my @expect = sort { lc $a cmp lc $b } @s;
+    is "@{[sort @s]}", "@expect", 'large string sort';
+}
+
+# Builtin comparisons of plain values sort on keys extracted up front,
+# which has to agree with the comparison functions
+{
+    sub by_cmp { $a cmp $b }
+    sub by_num { $a <=> $b }
+    my @s = map { ("common prefix $_", "a" . "\0" x ($_ % 3), "", "abcdefgh",
+		   "abcdefgh" . chr($_ % 256), "\xff" x ($_ % 10))[$_ % 6] }
+		map { $_ * 7919 % 1000 } 1 .. 1000;
+    my @u = @s;
+    utf8::upgrade($_) for @u;
+    my @m = @s;
+    utf8::upgrade($m[$_]) for grep { $_ % 3 } 0 .. $#m;
+    my @expect = sort by_cmp @s;
+    is join("|", sort @s), join("|", @expect), 'string sort on keys';
+    is join("|", sort @u), join("|", @expect), 'utf8 string sort on keys';
+    is join("|", sort @m), join("|", @expect), 'mixed utf8 string sort';
+    is join("|", sort { $b cmp $a } @s), join("|", reverse @expect),
+       'descending string sort on keys';
+
+    my @n = map { (0, -1, 1, ~0 >> 1, -(~0 >> 1) - 1, 1.5, -0.0, 1e300,
+		   -1e300, 9**9**9, -9**9**9, -2.5)[$_ % 12] }
+		map { $_ * 7919 % 1000 } 1 .. 1000;
+    is join("|", sort { $a <=> $b } @n), join("|", sort by_num @n),
+       'numeric sort on keys';
+    my @iv = map { ($_ - 500) * 9007199254740 + $_ } map { $_ * 7919 % 1000 }
+		1 .. 1000;
+    is join("|", sort { $a <=> $b } @iv), join("|", sort by_num @iv),
+       'integer sort on keys';
+}
+
+# Only the first few elements of a sort feeding a constant slice or a
+# short list assignment are sorted; they must match a full sort.
+{
+    my @r = map { [ $_ * 7919 % 37, $_ ] } 1 .. 1000;
+    my @full = sort { $a->[0] <=> $b->[0] } @r;
+    is join("|", map $_->[1], (sort { $a->[0] <=> $b->[0] } @r)[0..9]),
+       join("|", map $_->[1], @full[0..9]), 'stable top 10 of a sort';
+    @full = sort { $b->[0] <=> $a->[0] } @r;
+    is join("|", map $_->[1], (sort { $b->[0] <=> $a->[0] } @r)[4,0,2]),
+       join("|", map $_->[1], @full[4,0,2]), 'slice of a descending sort';
+    my @n = map { $_ * 7919 % 1000 } 1 .. 1000;
+    is join("|", (sort { $b <=> $a } @n)[0..4]), "999|998|997|996|995",
+       'top 5 of a numeric sort';
+    my ($min) = sort map "k$_", @n;
+    is $min, "k0", 'my ($min) = sort';
+    my ($x, undef, $y) = sort { $a <=> $b } @n;
+    is "$x $y", "0 2", 'list assignment of the first few of a sort';
+    is scalar(my ($z) = sort @n), 1000, 'list assignment count of a sort';
+    my $died = !eval {
+	my @t = (sort { die "cmp\n" if $a == 500; $a <=> $b } @n)[0..2];
+	1;
+    };
+    ok $died && $@ eq "cmp\n", 'die in the comparison of a partial sort';
+}
+
+# ... and that is what is done: the sort op gets OPpSORT_LIMIT, with the
+# number of elements wanted in its targ
+SKIP: {
+    skip_if_miniperl("no B under miniperl", 6);
+    require B;
+    my $limit = sub {
+	my @todo = B::svref_2object(shift)->ROOT;
+	while (my $op = shift @todo) {
+	    if ($op->name eq 'sort') {
+		return $op->private & B::OPpSORT_LIMIT() ? $op->targ : 0;
+	    }
+	    next unless $op->flags & B::OPf_KIDS();
+	    for (my $kid = $op->first; $$kid; $kid = $kid->sibling) {
+		push @todo, $kid;
+	    }
+	}
+	die "no sort op";
+    };
+    my @n;
+    is $limit->(sub { (sort { $b <=> $a } @n)[0..9] }), 10,
+       'a constant slice of a sort limits it';
+    is $limit->(sub { (sort @n)[4,0,2] }), 5, '... to its largest index';
+    is $limit->(sub { my ($min) = sort @n; 1 }), 1,
+       'so does my ($min) = sort';
+    is $limit->(sub { my ($x, undef, $y) = sort @n; 1 }), 3,
+       '... counting each scalar';
+    my $i = 1;
+    is $limit->(sub { (sort @n)[$i] }), 0, 'not a slice by a variable';
+    is $limit->(sub { my ($x, @y) = sort @n; 1 }), 0,
+       'nor an assignment to an array';
+}
+
+# Sort blocks which compare the same expression of $a and $b work out
+# each element's key just once
+{
+    my %h = map { ("k$_" => $_ * 7919 % 53) } 1 .. 500;
+    my @k = map "k$_", 1 .. 500;
+    sub by_hval { $h{$a} <=> $h{$b} }
+    sub by_hval_desc { $h{$b} <=> $h{$a} }
+    is "@{[sort { $h{$a} <=> $h{$b} } @k]}", "@{[sort by_hval @k]}",
+       'sort by hash value';
+    is "@{[sort { $h{$b} <=> $h{$a} } @k]}", "@{[sort by_hval_desc @k]}",
+       'descending sort by hash value';
+    {
+	use integer;
+	sub by_hval_int { $h{$a} <=> $h{$b} }
+	is "@{[sort { $h{$a} <=> $h{$b} } @k]}", "@{[sort by_hval_int @k]}",
+	   'integer sort by hash value';
+    }
+    my @s = map { ("Foo", "bar", "BAZ", "foo", "Bar")[$_ % 5] . $_ % 7 }
+		1 .. 500;
+    sub by_lc { lc($a) cmp lc($b) }
+    is "@{[sort { lc($a) cmp lc($b) } @s]}", "@{[sort by_lc @s]}",
+       'sort by lc';
+    my @r = map { { n => $_ * 7919 % 53, id => $_ } } 1 .. 500;
+    sub by_n { $a->{n} <=> $b->{n} }
+    is join(",", map $_->{id}, sort { $a->{n} <=> $b->{n} } @r),
+       join(",", map $_->{id}, sort by_n @r), 'sort by hash ref element';
+
+    my %p = (a => 1, b => undef, c => 2);
+    my @warn;
+    local $SIG{__WARN__} = sub { push @warn, @_ };
+    use warnings;
+    my @got = sort { $p{$a} <=> $p{$b} } qw(a b c);
+    is "@got", "b a c", 'sort by key with an undefined key';
+    like $warn[0], qr/^Use of uninitialized value \$p\{"b"\} in numeric comparison/,
+       'undefined key warns as it would in the block';
+}
+
+# sort keys %h sorts the hash's keys before making SVs for them
+{
+    my %h = map { ($_ => 1) } qw(b a aa ab 10 9 0), "", "\xe9", "\xff",
+			      "\x{100}", "\x{263a}";
+    my @k = keys %h;
+    is "@{[sort keys %h]}", "@{[sort @k]}", 'sort keys %h';
+    is "@{[reverse sort keys %h]}", "@{[reverse sort @k]}",
+       'reverse sort keys %h';
+    is "@{[sort { $b cmp $a } keys %h]}", "@{[sort { $b cmp $a } @k]}",
+       'descending sort keys %h';
+    my $r = \%h;
+    is "@{[sort keys %$r]}", "@{[sort @k]}", 'sort keys %$ref';
+    require Tie::Hash;
+    tie my %t, 'Tie::StdHash';
+    %t = (z => 1, x => 2, y => 3);
+    is "@{[sort keys %t]}", "x y z", 'sort keys of a tied hash';
+}
@@ -6,7 +6,7 @@ BEGIN {
     set_up_inc('../lib');
 }
 
-plan tests => 131;
+plan tests => 137;
 
 $FS = ':';
 
@@ -530,3 +530,20 @@ is "@a", '1 2 3', 'assignment to split-to-array (pmtarget/package array)';
 }
 (@{\@a} = split //, "abc") = 1..10;
 is "@a", '1 2 3', 'assignment to split-to-array (stacked)';
+
+# Fixed string separators
+{
+    my @a = split /::/, "Foo::Bar::::Baz::";
+    is "@a", "Foo Bar  Baz", 'split on a two character string';
+    @a = split /aa/, "aaaaab";
+    is join("|", @a), "||ab", 'split on a string that overlaps itself';
+    @a = split /\x{100}b/, "a\x{100}bc\x{100}b\x{100}d";
+    is join("|", @a), "a|c|\x{100}d", 'split on a UTF-8 string';
+    @a = split /,/, "a,b,c,d,e", 3;
+    is join("|", @a), "a|b|c,d,e", 'split on a comma with a limit';
+    my $n = split /\t/, "a\t\tb\t\t";
+    is $n, 3, 'split on a tab in scalar context';
+    my $line = join ",", 1 .. 1000;
+    my @b = split /,/, $line;
+    is "@b", "@{[1 .. 1000]}", 'split a long line on a comma';
+}
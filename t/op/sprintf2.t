@@ -243,7 +243,7 @@ if ($Config{nvsize} == 8 &&
     print "# no hexfloat tests\n";
 }
 
-plan tests => 1408 + ($Q ? 0 : 12) + @hexfloat;
+plan tests => 1811 + ($Q ? 0 : 12) + @hexfloat;
 
 use strict;
 use Config;
@@ -510,6 +510,66 @@ for my $num (0, -1, 1) {
     }
 }
 
+# Constant formats made only of simple directives are compiled when the
+# op is, and run by sv_catpvfn_fast(); it must agree with the general code,
+# which sees the same format when it is not a constant.
+{
+    package Sprintf2::Tie;
+    sub TIESCALAR { my $v = $_[1]; bless \$v }
+    sub FETCH { ${$_[0]} }
+}
+{
+    tie my $tied, 'Sprintf2::Tie', 17;
+    my @args = (0, -1, 42, ~0, -(~0 >> 1) - 1, 3.75, -3.75, "12abc", "",
+                "abc", "x" x 12, "\xe9", "\x{263a}", 9**9**9, -9**9**9,
+                \1, undef, 'tied');
+    my @fmts = ('[%s]', '[%d]', '[%i]', '<%5s|%-5s>', '<%05d|%-05d>',
+                '<%+d|% d|%+5d|%-+6d>', '[%.2f %x %s]', '[%3.1s %2d]',
+                '%%%s%%', 'a%sb%dc', '[%c]');
+    for my $fmt (@fmts) {
+        my $fast = eval "sub { sprintf('$fmt', \@_) }" or die $@;
+        my $slow = sub { sprintf($fmt, @_) };
+        for my $i (0 .. $#args) {
+            my ($w1, $w2) = ('', '');
+            # fresh copies each time, so numeric warnings are repeated
+            my @a1 = ($args[$i]) x 4;
+            my @a2 = ($args[$i]) x 4;
+            my $got = do {
+                local $SIG{__WARN__} = sub { $w1 .= shift };
+                eval { $i == $#args ? $fast->(($tied) x 4) : $fast->(@a1) };
+            };
+            my $expect = do {
+                local $SIG{__WARN__} = sub { $w2 .= shift };
+                eval { $i == $#args ? $slow->(($tied) x 4) : $slow->(@a2) };
+            };
+            s/ at .*//s for $w1, $w2;
+            my $name = "constant '$fmt' with argument $i";
+            is($got, $expect, $name);
+            is($w1, $w2, "$name: warnings");
+        }
+    }
+
+    my ($w, $r) = ('');
+    local $SIG{__WARN__} = sub { $w .= shift };
+    $r = sprintf('%s-%d', "a");
+    is($r, "a-0", "constant format with missing argument");
+    like($w, qr/^Missing argument in sprintf/, "... and warning");
+    $w = '';
+    $r = sprintf('%s-%d', "a", 1, 2);
+    is($r, "a-1", "constant format with redundant argument");
+    like($w, qr/^Redundant argument in sprintf/, "... and warning");
+    $r = sprintf('%s:%s', "\x{100}", "\xe9");
+    is($r, "\x{100}:\xe9", "constant format with UTF-8 argument");
+    $r = sprintf('%s%c%s', "a", 0x100, "\xe9");
+    is($r, "a\x{100}\xe9", "constant format turning into UTF-8");
+
+    # the compiled format is kept in the pad, and must be there at every
+    # depth of recursion
+    my $nest;
+    $nest = sub { $_[0] ? sprintf('(%d%s)', $_[0], $nest->($_[0] - 1)) : '' };
+    is($nest->(3), "(3(2(1)))", "constant format in a recursive sub");
+}
+
 # test that %f doesn't panic with +Inf, -Inf, NaN [perl #45383]
 foreach my $n (2**1e100, -2**1e100, 2**1e100/2**1e100) { # +Inf, -Inf, NaN
     eval { my $f = sprintf("%f", $n); };
@@ -7,7 +7,7 @@ BEGIN {
 }
 
 watchdog(10);
-plan(tests => 43);
+plan(tests => 60);
 use strict;
 use vars '$x';
 
@@ -159,3 +159,39 @@ TODO: {
     push @got, $_ foreach $a =~ /[^x]d(?{$a .= ''})[^x]d/g;
     is("@got", 'ydyd ydyd', '#92696 $a .= \'\' inside (?{}), $a studied');
 }
+
+{
+    # study() builds an index which index() and the regex engine use, and
+    # which must not survive changes to the string
+    my $s = join "", map { "line $_: some text here\n" } 1..200;
+    ok(study($s), 'study returns true when it builds an index');
+    is(index($s, "line 150:"), index("$s", "line 150:"), 'index on studied string');
+    is(index($s, "line 150:", 4000), index("$s", "line 150:", 4000),
+       'index with a start position on studied string');
+    is(index($s, "line 1:", 10), -1, 'index past the only match');
+    is(index($s, "Q"), -1, 'index of a byte not in the studied string');
+    is(index($s, "text herx"), -1, 'index of a near miss');
+    ok($s =~ /line 199: some/, 'regex on studied string');
+    is($-[0], index("$s", "line 199: some"), '... at the right place');
+    ok($s !~ /line 201:/, 'regex fails on studied string');
+
+    substr($s, 0, 4) = "LINE";
+    is(index($s, "LINE"), 0, 'index sees substr() assignment');
+    $s =~ s/line 150/lime 150/;
+    is(index($s, "line 150"), -1, 'index sees s///');
+    is(index($s, "lime 150"), index("$s", "lime 150"), '... and finds the new text');
+    study $s;
+    $s =~ tr/Q/q/;
+    vec($s, 1, 8) = ord "Q";
+    is(index($s, "Q"), 1, 'index sees vec() assignment');
+    study $s;
+    $s .= "tail!";
+    is(index($s, "tail!"), length($s) - 5, 'index sees .=');
+    study $s;
+    chop $s;
+    is(index($s, "tail!"), -1, 'index sees chop');
+
+    my $u = "\x{100}abc";
+    ok(!study($u), 'study declines UTF-8 strings');
+    ok(!study(my $e = ""), 'study declines empty strings');
+}
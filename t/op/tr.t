@@ -8,7 +8,7 @@ BEGIN {
     set_up_inc('../lib');
 }
 
-plan tests => 138;
+plan tests => 151;
 
 # Test this first before we extend the stack with other operations.
 # This caused an asan failure due to a bad write past the end of the stack.
@@ -551,4 +551,39 @@ for ("", nullrocow) {
 	ok(1, "tr///d on glob does not assert");
 }
 
+# Counting a single character in long strings goes a word at a time; check
+# the counts around word boundaries, misaligned starts and the byte tail
+{
+    my $str = join "", map { ("x" x $_) . "\n" } 1 .. 40;
+    my $lines = 0;
+    for my $start (0 .. 9) {
+        my $s = substr $str, $start;
+        my $expect = () = $s =~ /\n/g;
+        $lines++ if ($s =~ tr/\n//) == $expect;
+    }
+    is($lines, 10, "tr/\\n// counts long strings from any alignment");
+
+    my $s = "\n" x 1000;
+    is(($s =~ tr/\n//), 1000, "tr/\\n// counts a string of only matches");
+    is(($s =~ tr/\n//c), 0, "tr/\\n//c on a string of only matches");
+    $s = "a" x 1000 . "\n";
+    is(($s =~ tr/\n//), 1, "tr/\\n// counts a trailing match");
+    is(($s =~ tr/\n//c), 1000, "tr/\\n//c counts everything else");
+    is(($s =~ tr/\xff//), 0, "tr/\\xff// finds no high-bit bytes");
+    $s = "\xff" x 300;
+    is(($s =~ tr/\xff//), 300, "tr/\\xff// counts high-bit bytes");
+
+    $s = ("ab\x{100}\n" x 100);
+    is(($s =~ tr/\n//), 100, "tr/\\n// on a long UTF-8 string");
+    is(($s =~ tr/\n//c), 300, "tr/\\n//c on a long UTF-8 string");
+    is(($s =~ tr/a//), 100, "tr/a// on a long UTF-8 string");
+    is(($s =~ tr/\x{100}//), 100, "tr/\\x{100}// on a long UTF-8 string");
+
+    $s = ("abc\x{100}" x 50);
+    (my $t = $s) =~ tr/a-c/A-C/;
+    is($t, ("ABC\x{100}" x 50), "tr/a-c/A-C/ on a long UTF-8 string");
+    ($t = $s) =~ tr/a\x{100}/\x{101}b/;
+    is($t, ("\x{101}bcb" x 50), "tr/// with a UTF-8 table on a long string");
+}
+
 1;
@@ -6,7 +6,7 @@ BEGIN {
     set_up_inc('../lib');
 }
 
-plan( tests => 35 );
+plan( tests => 36 );
 
 my $Is_EBCDIC = (ord('A') == 193) ? 1 : 0;
 
@@ -128,3 +128,21 @@ like($@, qr/^Modification of a read-only value attempted at /,
     $v = vec($x, 0, 8);
     is($v, 255, "downgraded utf8 try 2");
 }
+
+{
+    # Elements of fewer than 8 bits are found by shifting and masking;
+    # check them all against unpack
+    my $x = join "", map { chr } 0 .. 255;
+    my $ok = 1;
+    for my $size (1, 2, 4) {
+        my @bits = unpack("b*", $x) =~ /(.{$size})/g;
+        for my $i (0 .. $#bits) {
+            my $expect = oct("0b" . reverse $bits[$i]);
+            $ok = 0 unless vec($x, $i, $size) == $expect;
+        }
+        my $y = '';
+        vec($y, $_, $size) = vec($x, $_, $size) for 0 .. $#bits;
+        $ok = 0 unless $y eq $x;
+    }
+    ok($ok, 'vec() with 1, 2 and 4 bit elements');
+}
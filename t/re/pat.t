@@ -22,7 +22,7 @@ BEGIN {
     skip_all_without_unicode_tables();
 }
 
-plan tests => 765;  # Update this when adding/deleting tests.
+plan tests => 814;  # Update this when adding/deleting tests.
 
 run_tests() unless caller;
 
@@ -1646,6 +1646,113 @@ EOP
 				"qr/${pat}x/ shows x in error even if it's a wide character");
 		}
 	}
+
+    {   # The DFA a pattern is matched with is shared by the copies of a
+        # qr// interpolated on its own, so must stay usable when one gives up
+        my $chunk = qr/\X/;
+        for my $i (1, 2) {
+            is(scalar(() = "abc" =~ /$chunk/g), 3,
+               "qr/\\X/ interpolated alone, pass $i");
+        }
+        my $big = qr/(?:a|b)+x/;
+        my $long = "ab" x 3000;
+        for my $i (1, 2) {
+            ok($long =~ /$big/ ? 0 : 1, "/$big/ doesn't match, pass $i");
+            ok("${long}x" =~ /$big/ ? 1 : 0, "/$big/ matches, pass $i");
+        }
+        ok("xaaab" =~ /a{600}|b/ ? 1 : 0,
+           "too many repeats for the DFA still match");
+
+        # The DFA is only built once a pattern is hot, so match each of
+        # these often enough for the later passes to use it
+        my @dfa = (
+            [ qr/\w+\d/,             "word word wor3",    "wor3" ],
+            [ qr/\w+\d/,             "word word word",    undef ],
+            [ qr/(?:abc){2}d/,        "xxabcabcd",         "abcabcd" ],
+            [ qr/(?:a|bc){2,3}x/,     "xbcabcx",           "bcabcx" ],
+            [ qr/(?:ab|cd)*ef/i,      "xABCdAEF",          "EF" ],
+            [ qr/(?:a|b){3,}?c/,      "ababac",            "ababac" ],
+            [ qr/a.*?b/,              "xaxbxb",            "axb" ],
+            [ qr/a.*b/,               "xaxbxb",            "axbxb" ],
+            [ qr/[^\s=]+=[^\s=]+\z/, "a=b c==d ef=gh",    "ef=gh" ],
+            [ qr/(?:x|y)+(?:y|z)+\z/, "xyxyzz",            "xyxyzz" ],
+        );
+        for my $t (@dfa) {
+            my ($re, $str, $want) = @$t;
+            my @got = map { $str =~ $re ? $& : undef } 1 .. 20;
+            is(scalar(grep { defined $_ ? defined $want && $_ eq $want
+                                        : !defined $want } @got),
+               20, "/$re/ against '$str' gives the same answer when hot");
+            my $long = "-" x 300 . $str;
+            is($long =~ $re ? $& : undef, $want,
+               "/$re/ against '$str' after 300 bytes");
+        }
+    }
+
+    {   # Long scans for a start class skip the bytes which can't start it
+        my $text = "abc " x 100;
+        for my $i (1, 2) {
+            ok("${text}12 2015-03" =~ /\d{4}-\d\d/ && $& eq "2015-03",
+               "\\d{4}-\\d\\d found after a long scan, pass $i");
+        }
+        my $wide = "ab\x{100} " x 100;
+        ok("${wide}12 2015-03" =~ /\d{4}-\d\d/ && $& eq "2015-03",
+           "\\d{4}-\\d\\d found after a long scan of UTF-8");
+        ok("$wide\x{661}\x{662}x" =~ /\d+x/ && $& eq "\x{661}\x{662}x",
+           "a non-ASCII digit is found after a long scan of UTF-8");
+        ok("${text}1 22 333x" =~ /\d+x/ && $& eq "333x",
+           "\\d+x retried after each run of digits");
+        ok("${text}yy y2" =~ /[xyz]\d/ && $-[0] == length($text) + 3,
+           "[xyz]\\d found after a long scan");
+        ok("$text\x{e9}!" =~ /[^a-c ]!/ && $& eq "\x{e9}!",
+           "[^a-c ] found after a long scan");
+    }
+
+    {   # Patterns whose matches all start with one of a few literals only
+        # try where those are
+        my $text = "abc GE PU " x 20;
+        my $re = qr/(?:GET|POST|PUT) |ERROR|WARN/;
+        ok("${text}POST /" =~ $re && $& eq "POST " && $-[0] == length $text,
+           "alternation of literals found after a long scan");
+        ok(("${text}" =~ $re) ? 0 : 1, "alternation of literals not found");
+        ok("$text\x{100}WARN" =~ $re && $& eq "WARN",
+           "alternation of literals found in UTF-8");
+        ok("${text}xERRORS" =~ /(ERR)OR|(WAR)N/ && $1 eq "ERR",
+           "literals inside captures");
+        ok("xxb" =~ /(?:a|)b/ && $-[0] == 2,
+           "an empty alternative starts with what follows it");
+        my @all = "PUT x GET y" =~ /(?:GET|POST|PUT) /g;
+        is("@all", "PUT  GET ", "alternation of literals with //g");
+    }
+
+    {   # A long string with no room for a COW count is given some, so that
+        # the captures share it rather than copy it.  They must still see
+        # the string as it was matched once it's changed.
+        my $src = "a" x 0x1fffc . "xyz";
+        open my $fh, "<", \$src or die;
+        read($fh, my $str, 0x1ffff) or die;   # $str is exactly full
+        ok($str =~ /a(a+)x(y)/, "long string matched");
+        SKIP: {
+            skip "no XS::APItest", 1 unless eval { require XS::APItest };
+            ok(XS::APItest::SvIsCOW($str), "... and shared with the captures");
+        }
+        substr($str, 0, 1, "b");
+        $str =~ tr/y/Y/;
+        $str .= "!";
+        is(length $1, 0x1fffb, "\$1 is unchanged after the string changes");
+        is($2, "y", "\$2 is unchanged");
+        is(length $&, 0x1fffe, "\$& is unchanged");
+        is("@-", "0 1 131069", "\@- is unchanged");
+        is("@+", "131070 131068 131070", "\@+ is unchanged");
+        is(substr($str, 0, 2) . substr($str, -3), "baYz!",
+           "the string itself is changed");
+
+        seek($fh, 0, 0);
+        read($fh, $str, 0x1ffff) or die;
+        my @got = map $_ // "-", $str =~ /a(x)|(z)/g;
+        $str = "";
+        is("@got", "x - - z", "//g in list context on a long string");
+    }
 } # End of sub run_tests
 
 1;
@@ -98,7 +98,7 @@ sub convert_from_ascii {
 use strict;
 use warnings FATAL=>"all";
 use vars qw($bang $ffff $nulnul); # used by the tests
-use vars qw($qr $skip_amp $qr_embed $qr_embed_thr $regex_sets); # set by our callers
+use vars qw($qr $skip_amp $qr_embed $qr_embed_thr $regex_sets $regex_jit); # set by our callers
 
 
 
@@ -363,7 +363,8 @@ foreach (@tests) {
 	# Need to make a copy, else the utf8::upgrade of an already studied
 	# scalar confuses things.
 	my $subject = $subject;
-	my $c = $iters;
+	# Under 'jit', match often enough for the program to be compiled
+	my $c = $regex_jit && $iters < 10 ? 10 : $iters;
 	my ($code, $match, $got);
         if ($repl eq 'pos') {
             $code= <<EOFCODE;
@@ -399,6 +400,7 @@ EOFCODE
 EOFCODE
         }
         $code = "no warnings 'experimental::regex_sets';$code" if $regex_sets;
+        $code = "use re 'jit';$code" if $regex_jit;
         #$code.=qq[\n\$expect="$expect";\n];
         #use Devel::Peek;
         #die Dump($code) if $pat=~/\\h/ and $subject=~/\x{A0}/;
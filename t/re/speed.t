@@ -23,7 +23,7 @@ BEGIN {
     skip_all_without_unicode_tables();
 }
 
-plan tests => 9;  # Update this when adding/deleting tests.
+plan tests => 11;  # Update this when adding/deleting tests.
 
 use strict;
 use warnings;
@@ -98,6 +98,14 @@ sub run_tests {
         $s =~ /^XX\d{1,10}cde/ for 1..100;
         pass("abs anchored float string should fail quickly");
 
+        # a member of a set which has matched isn't tried again
+        require re;
+        $s = "a" x 20_000;
+        is(join(",", re::regset_match(re::regset("x", "a+"), $s)), "1",
+           "regset_match mustn't retry a member once it has matched");
+        is(join(",", re::regset_match(re::regset("(?:a|b)+"), $s)), "0",
+           "... nor the only member");
+
     }
 
 } # End of sub run_tests
@@ -7620,6 +7620,9 @@ Perl_yylex(pTHX)
 	case KEY_pop:
 	    UNIDOR(OP_POP);
 
+	case KEY_popcount:
+	    LOP(OP_POPCOUNT,XTERM);
+
 	case KEY_pos:
 	    UNIDOR(OP_POS);
 	
@@ -999,6 +999,160 @@ XS(XS_re_regexp_pattern)
     NOT_REACHED; /* NOT-REACHED */
 }
 
+XS(XS_re_regcache_stats); /* prototype to pass -Wmissing-prototypes */
+XS(XS_re_regcache_stats)
+{
+    const reg_cache * const cache = PL_reg_cache;
+    dXSARGS;
+
+    if (items != 0)
+	croak_xs_usage(cv, "");
+
+    SP -= items;
+    EXTEND(SP, 4);
+    mPUSHu(cache ? cache->hits : 0);
+    mPUSHu(cache ? cache->misses : 0);
+    mPUSHu(cache ? cache->count : 0);
+    mPUSHu(cache ? cache->size : PERL_REG_CACHE_SIZE);
+    XSRETURN(4);
+}
+
+XS(XS_re_regcache_size); /* prototype to pass -Wmissing-prototypes */
+XS(XS_re_regcache_size)
+{
+    UV size;
+    dXSARGS;
+
+    if (items > 1)
+	croak_xs_usage(cv, "[size]");
+
+    size = PL_reg_cache ? PL_reg_cache->size : PERL_REG_CACHE_SIZE;
+    if (items) {
+	const IV new_size = SvIV(ST(0));
+	if (new_size < 0 || new_size > (IV)U32_MAX)
+	    Perl_croak(aTHX_ "Invalid size for the regex cache: %"IVdf,
+		       new_size);
+	reg_cache_resize((U32)new_size);
+    }
+    XSRETURN_UV(size);
+}
+
+XS(XS_re_regset_match); /* prototype to pass -Wmissing-prototypes */
+XS(XS_re_regset_match)
+{
+    REGEXP *rx;
+    SV *sv;
+    SV *seen;
+    const char *s;
+    STRLEN len;
+    STRLEN i;
+    dXSARGS;
+
+    if (items != 2)
+	croak_xs_usage(cv, "set, string");
+
+    rx = SvRX(ST(0));
+    if (!rx)
+	Perl_croak(aTHX_ "Not a compiled regular expression");
+    sv = ST(1);
+    s = SvPV_const(sv, len);
+
+    /* One pass over the string, noting each member of the set as it
+       matches; the match itself always fails */
+    seen = sv_2mortal(newSVpvs(""));
+    CALLREGEXEC(rx, (char *)s, (char *)s + len, (char *)s, 0, sv, seen,
+		REXEC_IGNOREPOS | REXEC_SET);
+
+    SP -= items;
+    for (i = 0; i < SvCUR(seen); i++)
+	if (SvPVX(seen)[i])
+	    mXPUSHu(i);
+    PUTBACK;
+}
+
+/* A hash of what matching the program of stats->rx has cost */
+
+static SV *
+S_reg_stats_hv(pTHX_ const reg_stats * const stats)
+{
+    HV * const hv = newHV();
+    REGEXP * const rx = stats->rx;
+
+    (void)hv_stores(hv, "pattern",
+		    newSVpvn_flags(RX_WRAPPED(rx), RX_WRAPLEN(rx),
+				   RX_UTF8(rx) ? SVf_UTF8 : 0));
+    (void)hv_stores(hv, "attempts", newSVuv(stats->attempts));
+    (void)hv_stores(hv, "matches", newSVuv(stats->matches));
+    (void)hv_stores(hv, "rejected", newSVuv(stats->rejected));
+    (void)hv_stores(hv, "steps", newSVuv(stats->steps));
+    (void)hv_stores(hv, "time", newSVnv(stats->usecs / 1e6));
+    return newRV_noinc(MUTABLE_SV(hv));
+}
+
+XS(XS_re_regstats); /* prototype to pass -Wmissing-prototypes */
+XS(XS_re_regstats)
+{
+    const reg_stats *stats;
+    dXSARGS;
+
+    if (items > 1)
+	croak_xs_usage(cv, "[qr]");
+
+    SP -= items;
+    if (items) {
+	REGEXP *rx = SvRX(ST(0));
+	if (!rx)
+	    Perl_croak(aTHX_ "Not a compiled regular expression");
+
+	/* copies of a regexp share the program, and so its counts */
+	if (ReANY(rx)->mother_re)
+	    rx = ReANY(rx)->mother_re;
+	for (stats = PL_reg_stats; stats; stats = stats->next)
+	    if (stats->rx == rx) {
+		mXPUSHs(S_reg_stats_hv(aTHX_ stats));
+		break;
+	    }
+    }
+    else {
+	for (stats = PL_reg_stats; stats; stats = stats->next)
+	    mXPUSHs(S_reg_stats_hv(aTHX_ stats));
+    }
+    PUTBACK;
+}
+
+XS(XS_re_regfreeze); /* prototype to pass -Wmissing-prototypes */
+XS(XS_re_regfreeze)
+{
+    REGEXP *rx;
+    dXSARGS;
+
+    if (items != 1)
+	croak_xs_usage(cv, "qr");
+
+    rx = SvRX(ST(0));
+    if (!rx)
+	Perl_croak(aTHX_ "Not a compiled regular expression");
+    ST(0) = sv_2mortal(reg_freeze(rx));
+    XSRETURN(1);
+}
+
+XS(XS_re_regthaw); /* prototype to pass -Wmissing-prototypes */
+XS(XS_re_regthaw)
+{
+    const char *pv;
+    STRLEN len;
+    SV *rv;
+    dXSARGS;
+
+    if (items != 1)
+	croak_xs_usage(cv, "frozen");
+
+    pv = SvPVbyte(ST(0), len);
+    rv = sv_2mortal(newRV_noinc(MUTABLE_SV(reg_thaw(pv, len))));
+    ST(0) = sv_bless(rv, gv_stashpvs("Regexp", GV_ADD));
+    XSRETURN(1);
+}
+
 #include "vutil.h"
 #include "vxs.inc"
 
@@ -1033,6 +1187,12 @@ static const struct xsub_details details[] = {
     {"re::regnames", XS_re_regnames, ";$"},
     {"re::regnames_count", XS_re_regnames_count, ""},
     {"re::regexp_pattern", XS_re_regexp_pattern, "$"},
+    {"re::regcache_stats", XS_re_regcache_stats, ""},
+    {"re::regcache_size", XS_re_regcache_size, ";$"},
+    {"re::regset_match", XS_re_regset_match, "$$"},
+    {"re::regstats", XS_re_regstats, ";$"},
+    {"re::regfreeze", XS_re_regfreeze, "$"},
+    {"re::regthaw", XS_re_regthaw, "$"},
 };
 
 void
@@ -72,16 +72,10 @@ bool
 Perl_is_invariant_string(const U8 *s, STRLEN len)
 {
     const U8* const send = s + (len ? len : strlen((const char *)s));
-    const U8* x = s;
 
     PERL_ARGS_ASSERT_IS_INVARIANT_STRING;
 
-    for (; x < send; ++x) {
-	if (!UTF8_IS_INVARIANT(*x))
-	    break;
-    }
-
-    return x == send;
+    return find_first_variant(s, send) == send;
 }
 
 /*
@@ -930,6 +930,88 @@ Perl_fbm_instr(pTHX_ unsigned char *big, unsigned char *bigend, SV *littlestr, U
     }
 }
 
+/* Like fbm_instr(), but if <big> lies in the buffer of <bigsv> and study()
+   has indexed it, only look where the rarest byte of <littlestr> occurs.
+   When that byte occurs too often to beat Boyer-Moore, or the index doesn't
+   apply, this is just fbm_instr(). */
+
+char *
+Perl_study_instr(pTHX_ SV *bigsv, unsigned char *big, unsigned char *bigend,
+                 SV *littlestr, U32 flags)
+{
+    const MAGIC *mg;
+    const struct study_index *idx;
+    const U8 *little;
+    STRLEN littlelen, i, rare;
+    U32 count, lo, hi, mid, start, end;
+    STRLEN from, to;
+
+    PERL_ARGS_ASSERT_STUDY_INSTR;
+
+    if (!bigsv || !SvSMAGICAL(bigsv)
+        || !(mg = mg_find(bigsv, PERL_MAGIC_study))
+        || !SvPOK(littlestr) || SvTAIL(littlestr)
+        || (littlelen = SvCUR(littlestr)) == 0
+        || (STRLEN)(bigend - big) < littlelen)
+	return fbm_instr(big, bigend, littlestr, flags);
+
+    idx = (const struct study_index *)mg->mg_ptr;
+    if (idx->pv != SvPVX_const(bigsv) || idx->cur != SvCUR(bigsv)
+        || (const char *)big < idx->pv
+        || (const char *)bigend > idx->pv + idx->cur)
+	return fbm_instr(big, bigend, littlestr, flags);
+
+    little = (const U8 *)SvPVX_const(littlestr);
+    rare = 0;
+    count = U32_MAX;
+    for (i = 0; i < littlelen; i++) {
+	const U32 n = idx->first[little[i] + 1] - idx->first[little[i]];
+	if (n < count) {
+	    count = n;
+	    rare = i;
+	    if (n == 0)
+		return NULL;	/* not anywhere in the string */
+	}
+    }
+
+    /* A match at offset s puts the rare byte at s + rare, so find the
+       positions of that byte from <from> to <to> */
+    from = (const char *)big - idx->pv + rare;
+    to = (const char *)bigend - idx->pv - littlelen + rare;
+    lo = idx->first[little[rare]];
+    hi = end = idx->first[little[rare] + 1];
+    while (lo < hi) {		/* lo = first position >= from */
+	mid = lo + (hi - lo) / 2;
+	if (idx->pos[mid] < from)
+	    lo = mid + 1;
+	else
+	    hi = mid;
+    }
+    start = lo;
+    hi = end;
+    while (lo < hi) {		/* lo = first position > to */
+	mid = lo + (hi - lo) / 2;
+	if (idx->pos[mid] <= to)
+	    lo = mid + 1;
+	else
+	    hi = mid;
+    }
+    end = lo;
+    lo = start;
+
+    /* Boyer-Moore looks at about one byte in <littlelen>, so only use the
+       index when it has fewer candidates than that */
+    if ((STRLEN)(end - lo) * littlelen > to - from + 1)
+	return fbm_instr(big, bigend, littlestr, flags);
+
+    for (; lo < end; lo++) {
+	const char *s = idx->pv + idx->pos[lo] - rare;
+	if (memEQ(s, little, littlelen))
+	    return (char *)s;
+    }
+    return NULL;
+}
+
 /*
 =for apidoc foldEQ
 